@@ -0,0 +1,270 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include "doubling_dple_internal.hpp"
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include "../symbolic/std_vector_tools.hpp"
+#include "../symbolic/matrix/matrix_tools.hpp"
+
+INPUTSCHEME(DPLEInput)
+OUTPUTSCHEME(DPLEOutput)
+
+using namespace std;
+namespace CasADi{
+
+  /// Symmetrize the blocks of a horizontally concatenated list of K dense n-by-n matrices
+  static void symmetrizeBlocks(int n, int K, std::vector<double>& v){
+    for(int k=0; k<K; ++k){
+      double* b = &v[k*n*n];
+      for(int j=0; j<n; ++j){
+        for(int i=j+1; i<n; ++i){
+          double s = (b[i+j*n] + b[j+i*n])/2;
+          b[i+j*n] = b[j+i*n] = s;
+        }
+      }
+    }
+  }
+
+  DoublingDpleInternal::DoublingDpleInternal(const std::vector< Sparsity > & A, const std::vector< Sparsity > &V, int nfwd, int nadj) : DpleInternal(A,V,nfwd,nadj) {
+  
+    // set default options
+    setOption("name","unnamed_doubling_dple_solver"); // name of the function 
+
+    addOption("tol",      OT_REAL,    1e-12, "Stop the doubling iteration when the relative increment of P_0 drops below this value.");
+    addOption("max_iter", OT_INTEGER, 100,   "Maximum number of doubling steps. Each step doubles the number of periods accounted for.");
+    
+  }
+
+  DoublingDpleInternal::~DoublingDpleInternal(){ 
+
+  }
+
+  void DoublingDpleInternal::init(){
+  
+    DpleInternal::init();
+
+    casadi_assert_message(!pos_def_,"pos_def option set to True: Solver only handles the indefinite case.");
+    casadi_assert_message(const_dim_,"const_dim option set to False: Solver only handles the True case.");
+    
+    n_ = A_[0].size1();
+    tol_ = getOption("tol");
+    max_iter_ = getOption("max_iter");
+    
+    int nn = n_*n_;
+    A_dense_.resize(nn*K_);
+    P_dense_.resize(nn*K_);
+    rhs_.resize(nn*K_);
+    seed_.resize(nn*K_);
+    sol_.resize(nn*K_);
+    X_.resize(nn);
+    Y_.resize(nn);
+    W_.resize(nn);
+    powers_.clear();
+  }
+  
+  void DoublingDpleInternal::mul(int n, const double* A, bool transA, const double* B, bool transB, double* C){
+    if(!transA){
+      // Axpy form: column j of C gets column l of A scaled by op(B)(l,j)
+      for(int j=0; j<n; ++j){
+        for(int l=0; l<n; ++l){
+          double b = transB ? B[j+l*n] : B[l+j*n];
+          if(b==0) continue;
+          const double* a = A+l*n;
+          double* c = C+j*n;
+          for(int i=0; i<n; ++i) c[i] += a[i]*b;
+        }
+      }
+    } else {
+      // Dot form: C(i,j) gets column i of A times column j of op(B)
+      for(int j=0; j<n; ++j){
+        for(int i=0; i<n; ++i){
+          const double* a = A+i*n;
+          double s = 0;
+          if(transB){
+            for(int l=0; l<n; ++l) s += a[l]*B[j+l*n];
+          } else {
+            const double* b = B+j*n;
+            for(int l=0; l<n; ++l) s += a[l]*b[l];
+          }
+          C[i+j*n] += s;
+        }
+      }
+    }
+  }
+
+  void DoublingDpleInternal::congruence(int n, const double* A, bool transA, const double* X, double* C, double* w){
+    fill(w,w+n*n,0);
+    mul(n,A,transA,X,false,w);
+    mul(n,w,false,A,!transA,C);
+  }
+
+  double DoublingDpleInternal::normInf(int n, const double* A){
+    double ret = 0;
+    for(int i=0; i<n; ++i){
+      double s = 0;
+      for(int j=0; j<n; ++j) s += fabs(A[i+j*n]);
+      ret = std::max(ret,s);
+    }
+    return ret;
+  }
+
+  const std::vector<double>& DoublingDpleInternal::monodromyPower(int i){
+    int nn = n_*n_;
+    if(powers_.empty()){
+      // Phi = A_{K-1}*...*A_0
+      powers_.push_back(std::vector<double>(A_dense_.begin(),A_dense_.begin()+nn));
+      for(int k=1; k<K_; ++k){
+        std::vector<double> M(nn,0);
+        mul(n_,&A_dense_[k*nn],false,&powers_.back()[0],false,&M[0]);
+        powers_.back().swap(M);
+      }
+    }
+    while(powers_.size()<=i){
+      std::vector<double> M(nn,0);
+      mul(n_,&powers_.back()[0],false,&powers_.back()[0],false,&M[0]);
+      powers_.push_back(M);
+    }
+    return powers_[i];
+  }
+  
+  int DoublingDpleInternal::solve(const std::vector<double>& U, std::vector<double>& P, bool adjoint){
+    int nn = n_*n_;
+    
+    // Time-reversed block ordering for the adjoint system
+    std::vector<int> blk(K_);
+    for(int m=0; m<K_; ++m) blk[m] = adjoint ? K_-1-m : m;
+
+    // Condense the period: X = sum of the right-hand sides propagated to the end of the period
+    fill(X_.begin(),X_.end(),0);
+    for(int m=0; m<K_; ++m){
+      copy(U.begin()+blk[m]*nn,U.begin()+(blk[m]+1)*nn,Y_.begin());
+      congruence(n_,&A_dense_[blk[m]*nn],adjoint,&X_[0],&Y_[0],&W_[0]);
+      X_.swap(Y_);
+    }
+
+    // Doubling: after step i, X = sum_{j<2^(i+1)} Phi^j X0 Phi^j^T
+    int iter;
+    for(iter=0; ; ++iter){
+      casadi_assert_message(iter<max_iter_,"DoublingDpleInternal: no convergence after " << max_iter_ << " doubling steps. The monodromy matrix probably has eigenvalues on or outside the unit circle.");
+      const std::vector<double>& M = monodromyPower(iter);
+      fill(Y_.begin(),Y_.end(),0);
+      congruence(n_,&M[0],adjoint,&X_[0],&Y_[0],&W_[0]);
+      for(int i=0; i<nn; ++i) X_[i] += Y_[i];
+      double nrm_inc = normInf(n_,&Y_[0]);
+      double nrm = normInf(n_,&X_[0]);
+      casadi_assert_message(nrm<=numeric_limits<double>::max(),"DoublingDpleInternal: doubling iteration diverged. The monodromy matrix probably has eigenvalues on or outside the unit circle.");
+      if(nrm_inc<=tol_*nrm) break;
+    }
+
+    // Propagate over the period
+    copy(X_.begin(),X_.end(),P.begin()+blk[0]*nn);
+    for(int m=0; m+1<K_; ++m){
+      copy(U.begin()+blk[m]*nn,U.begin()+(blk[m]+1)*nn,P.begin()+blk[m+1]*nn);
+      congruence(n_,&A_dense_[blk[m]*nn],adjoint,&P[blk[m]*nn],&P[blk[m+1]*nn],&W_[0]);
+    }
+    
+    return iter+1;
+  }
+  
+  void DoublingDpleInternal::evaluate(){
+    int nn = n_*n_;
+    
+    // Nominal solution
+    input(DPLE_A).getArray(&A_dense_[0],A_dense_.size(),DENSE);
+    powers_.clear();
+    input(DPLE_V).getArray(&rhs_[0],rhs_.size(),DENSE);
+    symmetrizeBlocks(n_,K_,rhs_);
+    stats_["iterations"] = solve(rhs_,P_dense_,false);
+    output(DPLE_P).setArray(&P_dense_[0],P_dense_.size(),DENSE);
+    
+    // Forward sensitivities: dP solves the same DPLE with V replaced by dV + dA P A^T + A P dA^T
+    for(int d=0; d<nfwd_; ++d){
+      input(DPLE_NUM_IN*(d+1)+DPLE_A).getArray(&seed_[0],seed_.size(),DENSE);
+      input(DPLE_NUM_IN*(d+1)+DPLE_V).getArray(&rhs_[0],rhs_.size(),DENSE);
+      symmetrizeBlocks(n_,K_,rhs_);
+      for(int k=0; k<K_; ++k){
+        fill(X_.begin(),X_.end(),0);
+        mul(n_,&seed_[k*nn],false,&P_dense_[k*nn],false,&X_[0]);
+        fill(Y_.begin(),Y_.end(),0);
+        mul(n_,&X_[0],false,&A_dense_[k*nn],true,&Y_[0]);
+        double* r = &rhs_[k*nn];
+        for(int j=0; j<n_; ++j){
+          for(int i=0; i<n_; ++i){
+            r[i+j*n_] += Y_[i+j*n_] + Y_[j+i*n_];
+          }
+        }
+      }
+      solve(rhs_,sol_,false);
+      output(DPLE_NUM_OUT*(d+1)+DPLE_P).setArray(&sol_[0],sol_.size(),DENSE);
+    }
+    
+    // Adjoint sensitivities: bar(V_k) solves the transposed DPLE, bar(A_k) = 2 bar(V_k) A_k P_k
+    for(int d=0; d<nadj_; ++d){
+      input(DPLE_NUM_IN*(nfwd_+1)+DPLE_NUM_OUT*d+DPLE_P).getArray(&rhs_[0],rhs_.size(),DENSE);
+      symmetrizeBlocks(n_,K_,rhs_);
+      solve(rhs_,sol_,true);
+      output(DPLE_NUM_OUT*(nfwd_+1)+DPLE_NUM_IN*d+DPLE_V).setArray(&sol_[0],sol_.size(),DENSE);
+      fill(seed_.begin(),seed_.end(),0);
+      for(int k=0; k<K_; ++k){
+        fill(X_.begin(),X_.end(),0);
+        mul(n_,&sol_[k*nn],false,&A_dense_[k*nn],false,&X_[0]);
+        mul(n_,&X_[0],false,&P_dense_[k*nn],false,&seed_[k*nn]);
+      }
+      for(int i=0; i<seed_.size(); ++i) seed_[i] *= 2;
+      output(DPLE_NUM_OUT*(nfwd_+1)+DPLE_NUM_IN*d+DPLE_A).setArray(&seed_[0],seed_.size(),DENSE);
+    }
+  }
+  
+  Function DoublingDpleInternal::getDerivative(int nfwd, int nadj) {
+    casadi_assert(nfwd_==0 && nadj_==0);
+    
+    DoublingDpleInternal* node = new DoublingDpleInternal(A_,V_, nfwd, nadj);
+    node->setOption(dictionary());
+    
+    DoublingDpleSolver ret;
+    ret.assignNode(node);
+
+    return ret;
+  }
+
+  void DoublingDpleInternal::printStats(std::ostream &stream) const{
+    Dictionary::const_iterator it = stats_.find("iterations");
+    if(it!=stats_.end()){
+      stream << "Number of doubling steps: " << it->second << std::endl;
+    }
+  }
+
+  void DoublingDpleInternal::deepCopyMembers(std::map<SharedObjectNode*,SharedObject>& already_copied){
+    DpleInternal::deepCopyMembers(already_copied);
+  }
+  
+  DoublingDpleInternal* DoublingDpleInternal::clone() const{
+    // Return a deep copy
+    DoublingDpleInternal* node = new DoublingDpleInternal(A_,V_, nfwd_, nadj_);
+    node->setOption(dictionary());
+    return node;
+  }
+
+
+} // namespace CasADi
@@ -0,0 +1,118 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef DOUBLING_DPLE_INTERNAL_HPP
+#define DOUBLING_DPLE_INTERNAL_HPP
+
+#include "doubling_dple_solver.hpp"
+#include "dple_internal.hpp"
+
+/// \cond INTERNAL
+namespace CasADi{
+
+  /** \brief Internal storage for DpleSolver related data
+
+      @copydoc DPLE_doc
+     \author Joris gillis
+      \date 2014
+  */
+  class DoublingDpleInternal : public DpleInternal{
+  public:
+    /** \brief  Constructor
+     *  \param[in] A  List of sparsities of A_i 
+     *  \param[in] V  List of sparsities of V_i 
+     */
+    DoublingDpleInternal(const std::vector< Sparsity > & A, const std::vector< Sparsity > &V, int nfwd=0, int nadj=0);
+    
+    /** \brief  Destructor */
+    virtual ~DoublingDpleInternal();
+
+    /** \brief  Clone */
+    virtual DoublingDpleInternal* clone() const;
+
+    /** \brief  Deep copy data members */
+    virtual void deepCopyMembers(std::map<SharedObjectNode*,SharedObject>& already_copied);
+  
+    /** \brief  Create a new solver */
+    virtual DoublingDpleInternal* create(const std::vector< Sparsity > & A, const std::vector< Sparsity > &V) const{ return new DoublingDpleInternal(A,V);}
+     
+    /** \brief  Print solver statistics */
+    virtual void printStats(std::ostream &stream) const;
+
+    /** \brief  evaluate */
+    virtual void evaluate();
+
+    /** \brief  Initialize */
+    virtual void init();
+
+    /// Generate a function that calculates nfwd forward derivatives and nadj adjoint derivatives
+    virtual Function getDerivative(int nfwd, int nadj);
+    
+  private:
+    /** \brief Solve a periodic Stein equation
+     *
+     * U holds the K symmetric right-hand sides and P receives the solution, both
+     * n-by-K*n dense, column-major. With adjoint==false, solves P_{k+1} = A_k P_k A_k^T + U_k.
+     * With adjoint==true, solves the transposed, time-reversed system
+     * L_k = A_k^T L_{k+1} A_k + U_k and returns P_k = L_{k+1}, the adjoint seeds of V_k.
+     * Returns the number of doubling steps.
+     */
+    int solve(const std::vector<double>& U, std::vector<double>& P, bool adjoint);
+
+    /// Power Phi^(2^i) of the monodromy matrix, computed on first use
+    const std::vector<double>& monodromyPower(int i);
+
+    /// C += op(A)*op(B) for dense n-by-n matrices
+    static void mul(int n, const double* A, bool transA, const double* B, bool transB, double* C);
+    
+    /// C = op(A)*X*op(A)^T + C for dense n-by-n matrices, using w as work vector
+    static void congruence(int n, const double* A, bool transA, const double* X, double* C, double* w);
+
+    /// Infinity norm of a dense n-by-n matrix
+    static double normInf(int n, const double* A);
+
+    /// State space dimension
+    int n_;
+    
+    /// Relative tolerance of the doubling iteration
+    double tol_;
+
+    /// Maximum number of doubling steps
+    int max_iter_;
+
+    /// Dense copies of A_i, horizontally concatenated
+    std::vector<double> A_dense_;
+
+    /// Nominal solution P_i, horizontally concatenated
+    std::vector<double> P_dense_;
+
+    /// Cached powers Phi^(2^i) of the monodromy matrix of the current A
+    std::vector< std::vector<double> > powers_;
+
+    /// Work vectors
+    std::vector<double> X_, Y_, W_, rhs_, seed_, sol_;
+    
+  };
+  
+} // namespace CasADi
+/// \endcond
+#endif // DOUBLING_DPLE_INTERNAL_HPP
@@ -0,0 +1,82 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef DOUBLING_DPLE_SOLVER_HPP
+#define DOUBLING_DPLE_SOLVER_HPP
+
+#include "dple_solver.hpp"
+
+namespace CasADi{
+
+  /// Forward declaration of internal class
+  class DoublingDpleInternal;
+
+  /** \brief Solving the Discrete Periodic Lyapunov Equations with a periodic doubling iteration
+  
+       @copydoc DPLE_doc
+  
+       Condenses the period into the monodromy matrix A_{K-1}...A_0 and sums the
+       resulting Stein series for P_0 with the doubling (squared Smith) iteration.
+       The remaining P_i follow from the periodic recursion.
+       No Kronecker-product system is formed: the cost is O(n^3 K) per solve and
+       the storage O(n^2 K). Sensitivities are obtained by solving one more
+       DPLE of the same structure per direction, reusing the monodromy powers.
+       Requires all eigenvalues of the monodromy matrix to lie strictly inside the unit circle.
+  
+       \author Joris gillis
+      \date 2014
+      
+  */
+  class DoublingDpleSolver : public DpleSolver {
+  public:
+    /// Default constructor
+    DoublingDpleSolver();
+    
+    /** \brief  Constructor
+     *  \param[in] A  List of sparsities of A_i 
+     *  \param[in] V  List of sparsities of V_i 
+     */
+    explicit DoublingDpleSolver(const std::vector< Sparsity > & A, const std::vector< Sparsity > &V);
+    
+    /// Access functions of the node
+    DoublingDpleInternal* operator->();
+
+    /// Access functions of the node
+    const DoublingDpleInternal* operator->() const;
+ 
+    /// Check if the node is pointing to the right type of object
+    virtual bool checkNode() const;
+  
+    /// Static creator function
+    #ifdef SWIG
+    %callback("%s_cb");
+    #endif
+    static DpleSolver creator(const std::vector< Sparsity > & A, const std::vector< Sparsity > &V){ return DoublingDpleSolver(A,V);}
+    #ifdef SWIG
+    %nocallback;
+    #endif
+  
+  };
+
+} // namespace CasADi
+
+#endif // DOUBLING_DPLE_SOLVER_HPP
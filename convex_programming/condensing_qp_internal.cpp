@@ -0,0 +1,567 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include "condensing_qp_internal.hpp"
+
+#include <cmath>
+#include <ctime>
+
+using namespace std;
+namespace CasADi {
+
+  namespace{
+    /// C += alpha*op(A)*B for column-major dense matrices, op(A) is m-by-k, B is k-by-n
+    void dense_mul(bool transA, int m, int n, int k, double alpha, const double* A, const double* B, double* C){
+      for(int j=0; j<n; ++j){
+        for(int l=0; l<k; ++l){
+          double b = alpha*B[l+j*k];
+          if(b==0) continue;
+          if(transA){
+            for(int i=0; i<m; ++i) C[i+j*m] += A[l+i*k]*b;
+          } else {
+            for(int i=0; i<m; ++i) C[i+j*m] += A[i+l*m]*b;
+          }
+        }
+      }
+    }
+
+    /// Invert a dense n-by-n matrix in place with Gauss-Jordan elimination and partial pivoting, work has at least n*n entries
+    bool dense_inv(int n, vector<double>& M, vector<double>& work){
+      copy(M.begin(),M.end(),work.begin());
+      fill(M.begin(),M.end(),0);
+      for(int i=0; i<n; ++i) M[i+i*n] = 1;
+      for(int c=0; c<n; ++c){
+        // Find pivot
+        int p = c;
+        for(int r=c+1; r<n; ++r){
+          if(fabs(work[r+c*n])>fabs(work[p+c*n])) p = r;
+        }
+        if(work[p+c*n]==0) return false;
+
+        // Swap rows
+        if(p!=c){
+          for(int j=0; j<n; ++j){
+            swap(work[p+j*n],work[c+j*n]);
+            swap(M[p+j*n],M[c+j*n]);
+          }
+        }
+
+        // Eliminate the column
+        double d = 1/work[c+c*n];
+        for(int j=0; j<n; ++j){
+          work[c+j*n] *= d;
+          M[c+j*n] *= d;
+        }
+        for(int r=0; r<n; ++r){
+          double f = work[r+c*n];
+          if(r==c || f==0) continue;
+          for(int j=0; j<n; ++j){
+            work[r+j*n] -= f*work[c+j*n];
+            M[r+j*n] -= f*M[c+j*n];
+          }
+        }
+      }
+      return true;
+    }
+  } // namespace
+
+  CondensingQPInternal::CondensingQPInternal(const std::vector<Sparsity> &st) : QPSolverInternal(st) {
+    addOption("nx",                OT_INTEGER,    GenericType(), "Number of states per stage");
+    addOption("nu",                OT_INTEGER,    0,             "Number of controls per stage");
+    addOption("qp_solver",         OT_QPSOLVER,   GenericType(), "The QP solver used to solve the condensed QPs.");
+    addOption("qp_solver_options", OT_DICTIONARY, GenericType(), "Options to be passed to the QP solver instance");
+  }
+
+  CondensingQPInternal::~CondensingQPInternal(){ 
+  }
+
+  void CondensingQPInternal::deepCopyMembers(std::map<SharedObjectNode*,SharedObject>& already_copied){
+    QPSolverInternal::deepCopyMembers(already_copied);
+    qp_solver_ = deepcopy(qp_solver_,already_copied);
+  }
+
+  void CondensingQPInternal::init(){
+    // Initialize the base classes
+    QPSolverInternal::init();
+
+    // Stage structure
+    casadi_assert_message(hasSetOption("nx"),"CondensingQPSolver: Option \"nx\" must be set");
+    nx_ = getOption("nx");
+    nu_ = getOption("nu");
+    int ns = nx_+nu_;
+    casadi_assert_message(nx_>0 && nu_>=0 && n_>=nx_ && (n_-nx_)%ns==0,
+                          "CondensingQPSolver: Expecting N*(nx+nu)+nx variables, got " << n_ << " variables for nx=" << nx_ << " and nu=" << nu_);
+    N_ = (n_-nx_)/ns;
+    nz_ = nx_ + N_*nu_;
+
+    // Stage of the variables, the free variables are x_0 and the controls
+    var_stage_.resize(n_);
+    var_ind_.resize(n_);
+    var_z_.resize(n_);
+    for(int i=0; i<n_; ++i){
+      var_stage_[i] = i/ns;
+      var_ind_[i] = i%ns;
+      if(var_ind_[i]>=nx_){
+        var_z_[i] = nx_ + var_stage_[i]*nu_ + var_ind_[i] - nx_;
+      } else if(var_stage_[i]==0){
+        var_z_[i] = var_ind_[i];
+      } else {
+        var_z_[i] = -1;
+      }
+    }
+
+    // The Hessian must not couple different stages
+    const Sparsity& H = st_[QP_STRUCT_H];
+    const vector<int>& H_colind = H.colind();
+    const vector<int>& H_row = H.row();
+    for(int cc=0; cc<n_; ++cc){
+      for(int el=H_colind[cc]; el<H_colind[cc+1]; ++el){
+        casadi_assert_message(var_stage_[H_row[el]]==var_stage_[cc],
+                              "CondensingQPSolver: The Hessian must be block diagonal with respect to the stages, but variables " << H_row[el] << " and " << cc << " are coupled");
+      }
+    }
+
+    // Columns of each constraint, in increasing order
+    vector<vector<int> > con_cols(nc_);
+    if(nc_>0){
+      const Sparsity& A = st_[QP_STRUCT_A];
+      const vector<int>& A_colind = A.colind();
+      const vector<int>& A_row = A.row();
+      for(int cc=0; cc<n_; ++cc){
+        for(int el=A_colind[cc]; el<A_colind[cc+1]; ++el){
+          con_cols[A_row[el]].push_back(cc);
+        }
+      }
+    }
+
+    // Candidate continuity constraints of stage k: only depend on the variables of stage k and on x_{k+1}
+    vector<int> cand_stage(nc_,-1);
+    vector<bool> cand_coupling(nc_,false);
+    for(int r=0; r<nc_; ++r){
+      if(con_cols[r].empty()) continue;
+      int smax = var_stage_[con_cols[r].back()];
+      if(smax==0) continue;
+      bool is_cand = true, coupling = false;
+      for(vector<int>::const_iterator it=con_cols[r].begin(); it!=con_cols[r].end(); ++it){
+        if(var_stage_[*it]==smax-1){
+          coupling = true;
+        } else if(var_stage_[*it]!=smax || var_ind_[*it]>=nx_){
+          is_cand = false;
+          break;
+        }
+      }
+      if(is_cand){
+        cand_stage[r] = smax-1;
+        cand_coupling[r] = coupling;
+      }
+    }
+
+    // Select nx continuity constraints for each stage, preferring the ones that couple the stages
+    con_stage_.assign(nc_,-1);
+    con_ind_.assign(nc_,-1);
+    con_row_.clear();
+    for(int k=0; k<N_; ++k){
+      int n_sel = 0;
+      for(int pass=0; pass<2 && n_sel<nx_; ++pass){
+        for(int r=0; r<nc_ && n_sel<nx_; ++r){
+          if(cand_stage[r]==k && cand_coupling[r]==(pass==0)){
+            con_stage_[r] = k;
+            con_ind_[r] = n_sel++;
+            con_row_.push_back(r);
+          }
+        }
+      }
+      casadi_assert_message(n_sel==nx_, "CondensingQPSolver: Could not detect the continuity constraints of stage " << k << ", found " << n_sel << " out of " << nx_);
+    }
+
+    // The remaining constraints are passed on to the condensed QP
+    con_path_.assign(nc_,-1);
+    npath_ = 0;
+    for(int r=0; r<nc_; ++r){
+      if(con_stage_[r]<0) con_path_[r] = npath_++;
+    }
+
+    // Condensed constraints: path constraints followed by the bounds on x_1, ..., x_N
+    nc_cond_ = npath_ + N_*nx_;
+    vector<int> Ac_row, Ac_col;
+    vector<bool> Ac_mark(nz_);
+    for(int r=0; r<nc_; ++r){
+      if(con_path_[r]<0) continue;
+      fill(Ac_mark.begin(),Ac_mark.end(),false);
+      for(vector<int>::const_iterator it=con_cols[r].begin(); it!=con_cols[r].end(); ++it){
+        if(var_z_[*it]>=0){
+          Ac_mark[var_z_[*it]] = true;
+        } else {
+          // x_k depends on x_0, u_0, ..., u_{k-1}
+          fill(Ac_mark.begin(),Ac_mark.begin()+nx_+var_stage_[*it]*nu_,true);
+        }
+      }
+      for(int j=0; j<nz_; ++j){
+        if(Ac_mark[j]){
+          Ac_row.push_back(con_path_[r]);
+          Ac_col.push_back(j);
+        }
+      }
+    }
+    for(int k=1; k<=N_; ++k){
+      for(int i=0; i<nx_; ++i){
+        for(int j=0; j<nx_+k*nu_; ++j){
+          Ac_row.push_back(npath_+(k-1)*nx_+i);
+          Ac_col.push_back(j);
+        }
+      }
+    }
+    Sparsity Ac_sparsity = Sparsity::triplet(nc_cond_,nz_,Ac_row,Ac_col);
+
+    // Allocate the QP solver for the condensed QP
+    QPSolverCreator qp_solver_creator = getOption("qp_solver");
+    qp_solver_ = qp_solver_creator(qpStruct("h",Sparsity::dense(nz_,nz_),"a",Ac_sparsity));
+
+    // Pass options if provided
+    if(hasSetOption("qp_solver_options")){
+      Dictionary qp_solver_options = getOption("qp_solver_options");
+      qp_solver_.setOption(qp_solver_options);
+    } 
+    
+    // Initialize the QP solver
+    qp_solver_.init();
+
+    // Allocate memory
+    Q_.resize(N_+1);
+    S_.resize(N_);
+    R_.resize(N_);
+    Dinv_.resize(N_);
+    C_.resize(N_);
+    F_.resize(N_);
+    b_.resize(N_);
+    A_.resize(N_);
+    B_.resize(N_);
+    c_.resize(N_);
+    G_.resize(N_+1);
+    m_.resize(N_+1);
+    for(int k=0; k<=N_; ++k){
+      Q_[k].resize(nx_*nx_);
+      G_[k].resize(nx_*nz_);
+      m_[k].resize(nx_);
+      if(k==N_) break;
+      S_[k].resize(nu_*nx_);
+      R_[k].resize(nu_*nu_);
+      Dinv_[k].resize(nx_*nx_);
+      C_[k].resize(nx_*nx_);
+      F_[k].resize(nx_*nu_);
+      b_[k].resize(nx_);
+      A_[k].resize(nx_*nx_);
+      B_[k].resize(nx_*nu_);
+      c_[k].resize(nx_);
+    }
+    W_.resize(nx_*nz_);
+    W_next_.resize(nx_*nz_);
+    w_.resize(nx_);
+    w_next_.resize(nx_);
+    Hc_.resize(nz_*nz_);
+    Ac_.resize(nc_cond_*nz_);
+    work_.resize(max(nu_,nx_)*nz_);
+    lam_.resize(N_*nx_);
+    grad_.resize(n_);
+  }
+
+  void CondensingQPInternal::evaluate() {
+    if (inputs_check_) checkInputs();
+    double time1 = clock();
+    int ns = nx_+nu_;
+
+    // Problem data
+    const DMatrix& H = input(QP_SOLVER_H);
+    const vector<int>& H_colind = H.colind();
+    const vector<int>& H_row = H.row();
+    const vector<double>& H_data = H.data();
+    const DMatrix& A = input(QP_SOLVER_A);
+    const vector<double>& g = input(QP_SOLVER_G).data();
+    const vector<double>& lbx = input(QP_SOLVER_LBX).data();
+    const vector<double>& ubx = input(QP_SOLVER_UBX).data();
+    const vector<double>& lba = input(QP_SOLVER_LBA).data();
+    const vector<double>& uba = input(QP_SOLVER_UBA).data();
+
+    // Get the Hessian blocks of each stage
+    for(int k=0; k<=N_; ++k){
+      fill(Q_[k].begin(),Q_[k].end(),0);
+      if(k==N_) break;
+      fill(S_[k].begin(),S_[k].end(),0);
+      fill(R_[k].begin(),R_[k].end(),0);
+    }
+    for(int cc=0; cc<n_; ++cc){
+      int k = var_stage_[cc];
+      int j = var_ind_[cc];
+      for(int el=H_colind[cc]; el<H_colind[cc+1]; ++el){
+        int i = var_ind_[H_row[el]];
+        if(i<nx_ && j<nx_){
+          Q_[k][i+j*nx_] = H_data[el];
+        } else if(j<nx_){
+          S_[k][i-nx_+j*nu_] = H_data[el];
+        } else if(i>=nx_){
+          R_[k][i-nx_+(j-nx_)*nu_] = H_data[el];
+        }
+      }
+    }
+
+    // Get the continuity constraints D_k*x_{k+1} + C_k*x_k + F_k*u_k = b_k
+    for(int k=0; k<N_; ++k){
+      fill(Dinv_[k].begin(),Dinv_[k].end(),0);
+      fill(C_[k].begin(),C_[k].end(),0);
+      fill(F_[k].begin(),F_[k].end(),0);
+    }
+    if(nc_>0){
+      const vector<int>& A_colind = A.colind();
+      const vector<int>& A_row = A.row();
+      const vector<double>& A_data = A.data();
+      for(int cc=0; cc<n_; ++cc){
+        int j = var_ind_[cc];
+        for(int el=A_colind[cc]; el<A_colind[cc+1]; ++el){
+          int k = con_stage_[A_row[el]];
+          if(k<0) continue;
+          int i = con_ind_[A_row[el]];
+          if(var_stage_[cc]==k+1){
+            Dinv_[k][i+j*nx_] = A_data[el];
+          } else if(j<nx_){
+            C_[k][i+j*nx_] = A_data[el];
+          } else {
+            F_[k][i+(j-nx_)*nx_] = A_data[el];
+          }
+        }
+      }
+    }
+    for(int k=0; k<N_; ++k){
+      for(int i=0; i<nx_; ++i){
+        int r = con_row_[i+k*nx_];
+        casadi_assert_message(lba[r]==uba[r], "CondensingQPSolver: Continuity constraint " << r << " must be an equality constraint");
+        b_[k][i] = lba[r];
+      }
+    }
+
+    // Linearized dynamics x_{k+1} = A_k*x_k + B_k*u_k + c_k
+    for(int k=0; k<N_; ++k){
+      casadi_assert_message(dense_inv(nx_,Dinv_[k],work_), "CondensingQPSolver: Singular continuity constraints in stage " << k);
+      fill(A_[k].begin(),A_[k].end(),0);
+      fill(B_[k].begin(),B_[k].end(),0);
+      fill(c_[k].begin(),c_[k].end(),0);
+      dense_mul(false,nx_,nx_,nx_,-1,getPtr(Dinv_[k]),getPtr(C_[k]),getPtr(A_[k]));
+      dense_mul(false,nx_,nu_,nx_,-1,getPtr(Dinv_[k]),getPtr(F_[k]),getPtr(B_[k]));
+      dense_mul(false,nx_,1,nx_,1,getPtr(Dinv_[k]),getPtr(b_[k]),getPtr(c_[k]));
+    }
+
+    // Dependency of the states on the condensed variables, x_k = G_k*z + m_k, G_k has nx+k*nu nonzero columns
+    fill(G_[0].begin(),G_[0].end(),0);
+    fill(m_[0].begin(),m_[0].end(),0);
+    for(int i=0; i<nx_; ++i) G_[0][i+i*nx_] = 1;
+    for(int k=0; k<N_; ++k){
+      int nk = nx_+k*nu_;
+      fill(G_[k+1].begin(),G_[k+1].end(),0);
+      dense_mul(false,nx_,nk,nx_,1,getPtr(A_[k]),getPtr(G_[k]),getPtr(G_[k+1]));
+      copy(B_[k].begin(),B_[k].end(),G_[k+1].begin()+nk*nx_);
+      copy(c_[k].begin(),c_[k].end(),m_[k+1].begin());
+      dense_mul(false,nx_,1,nx_,1,getPtr(A_[k]),getPtr(m_[k]),getPtr(m_[k+1]));
+    }
+
+    // Condensed Hessian and gradient, backward recursion W_k = Q_k*G_k + S_k'*E_k + A_k'*W_{k+1} with O(N^2) cost
+    vector<double>& gc = qp_solver_.input(QP_SOLVER_G).data();
+    fill(Hc_.begin(),Hc_.end(),0);
+    fill(W_.begin(),W_.end(),0);
+    dense_mul(false,nx_,nz_,nx_,1,getPtr(Q_[N_]),getPtr(G_[N_]),getPtr(W_));
+    copy(g.begin()+N_*ns,g.begin()+N_*ns+nx_,w_.begin());
+    dense_mul(false,nx_,1,nx_,1,getPtr(Q_[N_]),getPtr(m_[N_]),getPtr(w_));
+    for(int k=N_-1; k>=0; --k){
+      int nk = nx_+k*nu_;
+
+      // Rows of u_k: B_k'*W_{k+1} + S_k*G_k + R_k*E_k
+      fill(work_.begin(),work_.begin()+nu_*nz_,0);
+      dense_mul(true,nu_,nz_,nx_,1,getPtr(B_[k]),getPtr(W_),getPtr(work_));
+      dense_mul(false,nu_,nk,nx_,1,getPtr(S_[k]),getPtr(G_[k]),getPtr(work_));
+      for(int j=0; j<nu_; ++j){
+        for(int l=0; l<nu_; ++l) work_[l+(nk+j)*nu_] += R_[k][l+j*nu_];
+      }
+      for(int j=0; j<nz_; ++j){
+        for(int l=0; l<nu_; ++l) Hc_[nk+l+j*nz_] += work_[l+j*nu_];
+      }
+      for(int l=0; l<nu_; ++l) gc[nk+l] = g[k*ns+nx_+l];
+      dense_mul(true,nu_,1,nx_,1,getPtr(B_[k]),getPtr(w_),getPtr(gc)+nk);
+      dense_mul(false,nu_,1,nx_,1,getPtr(S_[k]),getPtr(m_[k]),getPtr(gc)+nk);
+
+      // W_k and w_k = q_k + Q_k*m_k + A_k'*w_{k+1}
+      fill(W_next_.begin(),W_next_.end(),0);
+      dense_mul(true,nx_,nz_,nx_,1,getPtr(A_[k]),getPtr(W_),getPtr(W_next_));
+      dense_mul(false,nx_,nk,nx_,1,getPtr(Q_[k]),getPtr(G_[k]),getPtr(W_next_));
+      for(int l=0; l<nu_; ++l){
+        for(int i=0; i<nx_; ++i) W_next_[i+(nk+l)*nx_] += S_[k][l+i*nu_];
+      }
+      copy(g.begin()+k*ns,g.begin()+k*ns+nx_,w_next_.begin());
+      dense_mul(false,nx_,1,nx_,1,getPtr(Q_[k]),getPtr(m_[k]),getPtr(w_next_));
+      dense_mul(true,nx_,1,nx_,1,getPtr(A_[k]),getPtr(w_),getPtr(w_next_));
+      W_.swap(W_next_);
+      w_.swap(w_next_);
+    }
+
+    // Rows of x_0
+    for(int j=0; j<nz_; ++j){
+      for(int i=0; i<nx_; ++i) Hc_[i+j*nz_] += W_[i+j*nx_];
+    }
+    copy(w_.begin(),w_.end(),gc.begin());
+
+    // Remove the rounding errors in the symmetry
+    for(int j=0; j<nz_; ++j){
+      for(int i=j+1; i<nz_; ++i){
+        Hc_[i+j*nz_] = Hc_[j+i*nz_] = (Hc_[i+j*nz_] + Hc_[j+i*nz_])/2;
+      }
+    }
+    copy(Hc_.begin(),Hc_.end(),qp_solver_.input(QP_SOLVER_H).begin());
+
+    // Condensed path constraints
+    vector<double>& lbc = qp_solver_.input(QP_SOLVER_LBA).data();
+    vector<double>& ubc = qp_solver_.input(QP_SOLVER_UBA).data();
+    fill(Ac_.begin(),Ac_.end(),0);
+    for(int r=0; r<nc_; ++r){
+      int p = con_path_[r];
+      if(p<0) continue;
+      lbc[p] = lba[r];
+      ubc[p] = uba[r];
+    }
+    if(npath_>0){
+      const vector<int>& A_colind = A.colind();
+      const vector<int>& A_row = A.row();
+      const vector<double>& A_data = A.data();
+      for(int cc=0; cc<n_; ++cc){
+        for(int el=A_colind[cc]; el<A_colind[cc+1]; ++el){
+          int p = con_path_[A_row[el]];
+          if(p<0) continue;
+          if(var_z_[cc]>=0){
+            Ac_[p+var_z_[cc]*nc_cond_] += A_data[el];
+          } else {
+            int k = var_stage_[cc], i = var_ind_[cc];
+            for(int j=0; j<nx_+k*nu_; ++j) Ac_[p+j*nc_cond_] += A_data[el]*G_[k][i+j*nx_];
+            lbc[p] -= A_data[el]*m_[k][i];
+            ubc[p] -= A_data[el]*m_[k][i];
+          }
+        }
+      }
+    }
+
+    // Bounds on the eliminated states
+    for(int k=1; k<=N_; ++k){
+      for(int i=0; i<nx_; ++i){
+        int p = npath_+(k-1)*nx_+i;
+        for(int j=0; j<nx_+k*nu_; ++j) Ac_[p+j*nc_cond_] = G_[k][i+j*nx_];
+        lbc[p] = lbx[k*ns+i] - m_[k][i];
+        ubc[p] = ubx[k*ns+i] - m_[k][i];
+      }
+    }
+    DMatrix& Ac = qp_solver_.input(QP_SOLVER_A);
+    const vector<int>& Ac_colind = Ac.colind();
+    const vector<int>& Ac_row = Ac.row();
+    vector<double>& Ac_data = Ac.data();
+    for(int j=0; j<nz_; ++j){
+      for(int el=Ac_colind[j]; el<Ac_colind[j+1]; ++el){
+        Ac_data[el] = Ac_[Ac_row[el]+j*nc_cond_];
+      }
+    }
+
+    // Bounds and initial guess of the condensed variables
+    const vector<double>& x0 = input(QP_SOLVER_X0).data();
+    for(int i=0; i<n_; ++i){
+      int j = var_z_[i];
+      if(j<0) continue;
+      qp_solver_.input(QP_SOLVER_LBX).at(j) = lbx[i];
+      qp_solver_.input(QP_SOLVER_UBX).at(j) = ubx[i];
+      qp_solver_.input(QP_SOLVER_X0).at(j) = x0[i];
+    }
+    double time2 = clock();
+    stats_["t_condense"] = double(time2-time1)/CLOCKS_PER_SEC;
+
+    // Solve the condensed QP
+    qp_solver_.evaluate();
+
+    // Pass the stats
+    stats_["qp_solver_stats"] = qp_solver_.getStats();
+    time1 = clock();
+
+    // Expand the primal solution
+    const vector<double>& z = qp_solver_.output(QP_SOLVER_X).data();
+    vector<double>& x = output(QP_SOLVER_X).data();
+    for(int i=0; i<n_; ++i){
+      if(var_z_[i]>=0) x[i] = z[var_z_[i]];
+    }
+    for(int k=1; k<=N_; ++k){
+      copy(m_[k].begin(),m_[k].end(),x.begin()+k*ns);
+      dense_mul(false,nx_,1,nx_+k*nu_,1,getPtr(G_[k]),getPtr(z),getPtr(x)+k*ns);
+    }
+
+    // Cost and gradient of the Lagrangian without the continuity constraints: H*x + g + A'*lam_a + lam_x
+    double cost = 0;
+    copy(g.begin(),g.end(),grad_.begin());
+    for(int cc=0; cc<n_; ++cc){
+      for(int el=H_colind[cc]; el<H_colind[cc+1]; ++el){
+        grad_[H_row[el]] += H_data[el]*x[cc];
+        cost += H_data[el]*x[H_row[el]]*x[cc]/2;
+      }
+      cost += g[cc]*x[cc];
+    }
+    output(QP_SOLVER_COST).set(cost);
+
+    const vector<double>& lam_z = qp_solver_.output(QP_SOLVER_LAM_X).data();
+    const vector<double>& lam_c = qp_solver_.output(QP_SOLVER_LAM_A).data();
+    vector<double>& lam_x = output(QP_SOLVER_LAM_X).data();
+    vector<double>& lam_a = output(QP_SOLVER_LAM_A).data();
+    for(int i=0; i<n_; ++i){
+      lam_x[i] = var_z_[i]>=0 ? lam_z[var_z_[i]] : lam_c[npath_+(var_stage_[i]-1)*nx_+var_ind_[i]];
+      grad_[i] += lam_x[i];
+    }
+    for(int r=0; r<nc_; ++r){
+      lam_a[r] = con_path_[r]>=0 ? lam_c[con_path_[r]] : 0;
+    }
+    if(npath_>0){
+      const vector<int>& A_colind = A.colind();
+      const vector<int>& A_row = A.row();
+      const vector<double>& A_data = A.data();
+      for(int cc=0; cc<n_; ++cc){
+        for(int el=A_colind[cc]; el<A_colind[cc+1]; ++el){
+          grad_[cc] += A_data[el]*lam_a[A_row[el]];
+        }
+      }
+    }
+
+    // Multipliers of the continuity constraints from stationarity w.r.t. x_{k+1}: D_k'*lam_k = -(grad + C_{k+1}'*lam_{k+1})
+    for(int k=N_-1; k>=0; --k){
+      copy(grad_.begin()+(k+1)*ns,grad_.begin()+(k+1)*ns+nx_,work_.begin());
+      if(k+1<N_){
+        dense_mul(true,nx_,1,nx_,1,getPtr(C_[k+1]),getPtr(lam_)+(k+1)*nx_,getPtr(work_));
+      }
+      fill(lam_.begin()+k*nx_,lam_.begin()+(k+1)*nx_,0);
+      dense_mul(true,nx_,1,nx_,-1,getPtr(Dinv_[k]),getPtr(work_),getPtr(lam_)+k*nx_);
+      for(int i=0; i<nx_; ++i) lam_a[con_row_[i+k*nx_]] = lam_[i+k*nx_];
+    }
+    time2 = clock();
+    stats_["t_expand"] = double(time2-time1)/CLOCKS_PER_SEC;
+  }
+
+  void CondensingQPInternal::generateNativeCode(std::ostream &file) const {
+    qp_solver_.generateNativeCode(file);
+  }
+
+} // namespace CasADi
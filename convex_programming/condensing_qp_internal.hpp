@@ -0,0 +1,103 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef CONDENSING_QP_INTERNAL_HPP
+#define CONDENSING_QP_INTERNAL_HPP
+
+#include "symbolic/function/qp_solver_internal.hpp"
+
+/// \cond INTERNAL
+namespace CasADi{
+
+  /** \brief Internal class for CondensingQPInternal
+   * 
+      @copydoc QPSolver_doc
+   * */
+class CondensingQPInternal : public QPSolverInternal {
+  friend class CondensingQPSolver;
+public:
+
+  /** \brief  Clone */
+  virtual CondensingQPInternal* clone() const{ return new CondensingQPInternal(*this);}
+  
+  /** \brief  Create a new Solver */
+  explicit CondensingQPInternal(const std::vector<Sparsity> &st);
+
+  /** \brief  Destructor */
+  virtual ~CondensingQPInternal();
+
+  /** \brief  Deep copy data members */
+  virtual void deepCopyMembers(std::map<SharedObjectNode*,SharedObject>& already_copied);
+
+  /** \brief  Initialize */
+  virtual void init();
+  
+  /** \brief Solve the QP */
+  virtual void evaluate();
+  
+  /** \brief Generate native code for debugging */
+  virtual void generateNativeCode(std::ostream &file) const;
+
+  protected:
+    /// QP solver for the condensed QP
+    QPSolver qp_solver_;
+
+    /// Number of states and controls per stage, number of stages
+    int nx_, nu_, N_;
+
+    /// Number of condensed variables, path constraints and condensed constraints
+    int nz_, npath_, nc_cond_;
+
+    /// Stage of each variable and index within the stage
+    std::vector<int> var_stage_, var_ind_;
+
+    /// Index of each free variable (x_0 and the controls) in the condensed QP, -1 for the eliminated states
+    std::vector<int> var_z_;
+
+    /// Stage and index of each continuity constraint, -1 for the path constraints
+    std::vector<int> con_stage_, con_ind_;
+
+    /// Index of each path constraint in the condensed QP, -1 for the continuity constraints
+    std::vector<int> con_path_;
+
+    /// Row of each continuity constraint, stage by stage
+    std::vector<int> con_row_;
+
+    /// Hessian blocks of each stage, column-major: Q_k (nx-by-nx), S_k (nu-by-nx), R_k (nu-by-nu)
+    std::vector<std::vector<double> > Q_, S_, R_;
+
+    /// Continuity constraints D_k*x_{k+1} + C_k*x_k + F_k*u_k = b_k, with D_k inverted
+    std::vector<std::vector<double> > Dinv_, C_, F_, b_;
+
+    /// Linearized dynamics x_{k+1} = A_k*x_k + B_k*u_k + c_k
+    std::vector<std::vector<double> > A_, B_, c_;
+
+    /// Dependency of the states on the condensed variables x_k = G_k*z + m_k
+    std::vector<std::vector<double> > G_, m_;
+
+    /// Work vectors
+    std::vector<double> W_, W_next_, w_, w_next_, Hc_, Ac_, work_, lam_, grad_;
+};
+
+} // namespace CasADi
+/// \endcond
+#endif //CONDENSING_QP_INTERNAL_HPP
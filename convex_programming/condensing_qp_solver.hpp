@@ -0,0 +1,85 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef CONDENSING_QP_SOLVER_HPP
+#define CONDENSING_QP_SOLVER_HPP
+
+#include "symbolic/function/qp_solver.hpp"
+
+namespace CasADi {
+  
+  
+// Forward declaration of internal class 
+class CondensingQPInternal;
+
+  /** \brief Solve a multiple shooting structured QP by condensing out the states
+
+   The decision variables are expected to be ordered stage-wise,
+   [x_0, u_0, x_1, u_1, ..., x_{N-1}, u_{N-1}, x_N], with nx states and nu controls per stage
+   (options "nx" and "nu"), and the Hessian must be block diagonal with respect to the stages.
+   For each stage k, the continuity constraints, i.e. the nx equality constraints that only depend on
+   x_k, u_k and x_{k+1}, are detected from the sparsity pattern of A. They are used to eliminate
+   x_1, ..., x_N, which gives a dense QP in x_0 and the controls that is formed with O(N^2)
+   operations and passed to the QP solver given by the option "qp_solver". The bounds on the
+   eliminated states become linear constraints of the condensed QP. The primal and dual solution
+   of the original QP is recovered afterwards.
+
+   @copydoc QPSolver_doc
+  */
+class CondensingQPSolver : public QPSolver {
+public:
+
+  /** \brief  Default constructor */
+  CondensingQPSolver();
+  
+  
+  /** \brief Constructor
+  *  \param st Problem structure
+  *  \copydoc scheme_QPStruct
+  */
+  explicit CondensingQPSolver(const QPStructure & st);
+  
+  /** \brief  Access functions of the node */
+  CondensingQPInternal* operator->();
+  const CondensingQPInternal* operator->() const;
+
+  /// Check if the node is pointing to the right type of object
+  virtual bool checkNode() const;
+  
+  /// Static creator function
+  #ifdef SWIG
+  %callback("%s_cb");
+  #endif
+  static QPSolver creator(const QPStructure & st){ return CondensingQPSolver(st);}
+  #ifdef SWIG
+  %nocallback;
+  #endif
+  
+  /// Access the QP solver used for the condensed QP
+  QPSolver & getSolver();
+
+};
+
+
+} // namespace CasADi
+
+#endif //CONDENSING_QP_SOLVER_HPP
@@ -0,0 +1,488 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include "interior_point_qp_internal.hpp"
+#include "symbolic/matrix/sparsity_tools.hpp"
+
+#include <cmath>
+#include <limits>
+#include <iomanip>
+
+using namespace std;
+namespace CasADi {
+
+  InteriorPointQPInternal::InteriorPointQPInternal(const std::vector<Sparsity> &st) : QPSolverInternal(st) {
+    addOption("linear_solver",         OT_LINEARSOLVER, GenericType(), "The linear solver used for the KKT system, e.g. CSparse or SparseLDL");
+    addOption("linear_solver_options", OT_DICTIONARY,   GenericType(), "Options to be passed to the linear solver");
+    addOption("max_iter",              OT_INTEGER,      100,           "Maximum number of iterations");
+    addOption("tol",                   OT_REAL,         1e-8,          "Tolerance on the average complementarity and on the residuals of the KKT conditions, the latter relative to the largest bound and gradient entry");
+    addOption("regularization",        OT_REAL,         1e-10,         "Regularization of the Hessian and of the equality constraints in the KKT matrix");
+    addOption("tau_min",               OT_REAL,         0.99,          "Smallest fraction of the step to the boundary that is taken");
+    addOption("warm_start",            OT_BOOLEAN,      false,         "Start from the multipliers of the previous solution");
+    addOption("warm_start_shift",      OT_REAL,         1e-3,          "Smallest slack and multiplier in a warm start");
+  }
+
+  InteriorPointQPInternal::~InteriorPointQPInternal(){ 
+  }
+
+  void InteriorPointQPInternal::deepCopyMembers(std::map<SharedObjectNode*,SharedObject>& already_copied){
+    QPSolverInternal::deepCopyMembers(already_copied);
+    linsol_ = deepcopy(linsol_,already_copied);
+  }
+
+  void InteriorPointQPInternal::init(){
+    // Initialize the base classes
+    QPSolverInternal::init();
+
+    // Read options
+    max_iter_ = getOption("max_iter");
+    tol_ = getOption("tol");
+    reg_ = getOption("regularization");
+    tau_min_ = getOption("tau_min");
+    warm_start_ = getOption("warm_start");
+    warm_start_shift_ = getOption("warm_start_shift");
+    casadi_assert_message(tau_min_>0 && tau_min_<1, "InteriorPointQPSolver: tau_min must be in (0,1)");
+    casadi_assert_message(warm_start_shift_>0, "InteriorPointQPSolver: warm_start_shift must be positive");
+
+    // Sparsity of the KKT matrix, with all diagonal entries
+    const Sparsity& H = st_[QP_STRUCT_H];
+    const Sparsity& A = st_[QP_STRUCT_A];
+    vector<unsigned char> mapping;
+    Sparsity kkt = H.patternUnion(Sparsity::diag(n_),mapping);
+    if(nc_>0){
+      kkt = vertcat(horzcat(kkt,A.T()),horzcat(A,Sparsity::diag(nc_)));
+    }
+    m_ = n_ + nc_;
+
+    // Position of the nonzeros of H, A and A' in the KKT matrix
+    const vector<int>& H_colind = H.colind();
+    const vector<int>& H_row = H.row();
+    kkt_h_.resize(H.size());
+    for(int cc=0; cc<n_; ++cc){
+      for(int el=H_colind[cc]; el<H_colind[cc+1]; ++el){
+        kkt_h_[el] = kkt.getNZ(H_row[el],cc);
+      }
+    }
+    kkt_a_.resize(nc_>0 ? A.size() : 0);
+    kkt_at_.resize(kkt_a_.size());
+    if(nc_>0){
+      const vector<int>& A_colind = A.colind();
+      const vector<int>& A_row = A.row();
+      for(int cc=0; cc<n_; ++cc){
+        for(int el=A_colind[cc]; el<A_colind[cc+1]; ++el){
+          kkt_a_[el] = kkt.getNZ(n_+A_row[el],cc);
+          kkt_at_[el] = kkt.getNZ(cc,n_+A_row[el]);
+        }
+      }
+    }
+    kkt_diag_.resize(m_);
+    for(int k=0; k<m_; ++k) kkt_diag_[k] = kkt.getNZ(k,k);
+    kkt_.resize(kkt.size());
+
+    // Create the linear solver
+    casadi_assert_message(hasSetOption("linear_solver"), "InteriorPointQPSolver: Option \"linear_solver\" must be set");
+    linearSolverCreator linear_solver_creator = getOption("linear_solver");
+    linsol_ = linear_solver_creator(kkt,1);
+    if(hasSetOption("linear_solver_options")){
+      linsol_.setOption(getOption("linear_solver_options"));
+    }
+    linsol_.init();
+
+    // Constraints
+    type_.resize(m_);
+    lo_.resize(m_);
+    up_.resize(m_);
+
+    // Iterate
+    x_.resize(n_);
+    cx_.resize(m_);
+    sl_.resize(m_);
+    su_.resize(m_);
+    zl_.resize(m_);
+    zu_.resize(m_);
+    y_.resize(m_);
+    lam_.resize(m_);
+
+    // Residuals
+    r_d_.resize(n_);
+    r_l_.resize(m_);
+    r_u_.resize(m_);
+    r_sl_.resize(m_);
+    r_su_.resize(m_);
+
+    // Newton direction
+    dx_.resize(n_);
+    cdx_.resize(m_);
+    dsl_.resize(m_);
+    dsu_.resize(m_);
+    dzl_.resize(m_);
+    dzu_.resize(m_);
+    dy_.resize(m_);
+    rhs_.resize(m_);
+
+    has_solution_ = false;
+  }
+
+  void InteriorPointQPInternal::residuals(){
+    const DMatrix& H = input(QP_SOLVER_H);
+    const DMatrix& A = input(QP_SOLVER_A);
+    const vector<double>& g = input(QP_SOLVER_G).data();
+
+    // Constraint values
+    copy(x_.begin(),x_.end(),cx_.begin());
+    fill(cx_.begin()+n_,cx_.end(),0);
+    if(nc_>0){
+      const vector<int>& A_colind = A.colind();
+      const vector<int>& A_row = A.row();
+      const vector<double>& A_data = A.data();
+      for(int cc=0; cc<n_; ++cc){
+        for(int el=A_colind[cc]; el<A_colind[cc+1]; ++el){
+          cx_[n_+A_row[el]] += A_data[el]*x_[cc];
+        }
+      }
+    }
+
+    // Multipliers of the constraints
+    for(int k=0; k<m_; ++k){
+      lam_[k] = type_[k]==EQUALITY ? y_[k] : zu_[k] - zl_[k];
+    }
+
+    // Gradient of the Lagrangian: H*x + g + A'*lam_a + lam_x
+    copy(g.begin(),g.end(),r_d_.begin());
+    const vector<int>& H_colind = H.colind();
+    const vector<int>& H_row = H.row();
+    const vector<double>& H_data = H.data();
+    for(int cc=0; cc<n_; ++cc){
+      for(int el=H_colind[cc]; el<H_colind[cc+1]; ++el){
+        r_d_[H_row[el]] += H_data[el]*x_[cc];
+      }
+    }
+    if(nc_>0){
+      const vector<int>& A_colind = A.colind();
+      const vector<int>& A_row = A.row();
+      const vector<double>& A_data = A.data();
+      for(int cc=0; cc<n_; ++cc){
+        for(int el=A_colind[cc]; el<A_colind[cc+1]; ++el){
+          r_d_[cc] += A_data[el]*lam_[n_+A_row[el]];
+        }
+      }
+    }
+    du_inf_ = 0;
+    for(int i=0; i<n_; ++i){
+      if(type_[i]==EQUALITY){
+        // The multiplier of a fixed variable is whatever makes the gradient vanish
+        y_[i] = lam_[i] = -r_d_[i];
+        r_d_[i] = 0;
+      } else {
+        r_d_[i] += lam_[i];
+        du_inf_ = fmax(du_inf_,fabs(r_d_[i]));
+      }
+    }
+
+    // Primal residuals and complementarity
+    pr_inf_ = 0;
+    mu_ = 0;
+    for(int k=0; k<m_; ++k){
+      if(type_[k]==EQUALITY){
+        r_l_[k] = cx_[k] - lo_[k];
+        pr_inf_ = fmax(pr_inf_,fabs(r_l_[k]));
+      }
+      if(type_[k]==LOWER || type_[k]==BOUNDED){
+        r_l_[k] = cx_[k] - sl_[k] - lo_[k];
+        pr_inf_ = fmax(pr_inf_,fabs(r_l_[k]));
+        mu_ += sl_[k]*zl_[k];
+      }
+      if(type_[k]==UPPER || type_[k]==BOUNDED){
+        r_u_[k] = cx_[k] + su_[k] - up_[k];
+        pr_inf_ = fmax(pr_inf_,fabs(r_u_[k]));
+        mu_ += su_[k]*zu_[k];
+      }
+    }
+    if(nslack_>0) mu_ /= nslack_;
+  }
+
+  void InteriorPointQPInternal::assembleKKT(){
+    const DMatrix& H = input(QP_SOLVER_H);
+    const DMatrix& A = input(QP_SOLVER_A);
+    fill(kkt_.begin(),kkt_.end(),0);
+
+    // Hessian, without the rows and columns of fixed variables
+    const vector<int>& H_colind = H.colind();
+    const vector<int>& H_row = H.row();
+    const vector<double>& H_data = H.data();
+    for(int cc=0; cc<n_; ++cc){
+      if(type_[cc]==EQUALITY) continue;
+      for(int el=H_colind[cc]; el<H_colind[cc+1]; ++el){
+        if(type_[H_row[el]]!=EQUALITY) kkt_[kkt_h_[el]] += H_data[el];
+      }
+    }
+
+    // Linear constraints, without fixed variables and constraints without bounds
+    if(nc_>0){
+      const vector<int>& A_colind = A.colind();
+      const vector<int>& A_row = A.row();
+      const vector<double>& A_data = A.data();
+      for(int cc=0; cc<n_; ++cc){
+        if(type_[cc]==EQUALITY) continue;
+        for(int el=A_colind[cc]; el<A_colind[cc+1]; ++el){
+          if(type_[n_+A_row[el]]==FREE) continue;
+          kkt_[kkt_a_[el]] = kkt_[kkt_at_[el]] = A_data[el];
+        }
+      }
+    }
+
+    // Diagonal: the eliminated bound multipliers D = zl/sl + zu/su enter as D for the variables and as -1/D for the linear constraints
+    for(int k=0; k<m_; ++k){
+      double D = 0;
+      if(type_[k]==LOWER || type_[k]==BOUNDED) D += zl_[k]/sl_[k];
+      if(type_[k]==UPPER || type_[k]==BOUNDED) D += zu_[k]/su_[k];
+      double& d = kkt_[kkt_diag_[k]];
+      if(k<n_){
+        d = type_[k]==EQUALITY ? 1 : d + D + reg_;
+      } else if(type_[k]==EQUALITY){
+        d = -reg_;
+      } else if(type_[k]==FREE){
+        d = -1;
+      } else {
+        d = -1/D;
+      }
+    }
+  }
+
+  void InteriorPointQPInternal::solveKKT(const std::vector<double>& r_sl, const std::vector<double>& r_su){
+    // Right-hand side, with the slacks and the bound multipliers eliminated
+    for(int k=0; k<m_; ++k){
+      double D = 0, e = 0;
+      if(type_[k]==LOWER || type_[k]==BOUNDED){
+        D += zl_[k]/sl_[k];
+        e += (r_sl[k] + zl_[k]*r_l_[k])/sl_[k];
+      }
+      if(type_[k]==UPPER || type_[k]==BOUNDED){
+        D += zu_[k]/su_[k];
+        e += (zu_[k]*r_u_[k] - r_su[k])/su_[k];
+      }
+      if(k<n_){
+        rhs_[k] = type_[k]==EQUALITY ? 0 : -r_d_[k] - e;
+      } else if(type_[k]==EQUALITY){
+        rhs_[k] = -r_l_[k];
+      } else if(type_[k]==FREE){
+        rhs_[k] = 0;
+      } else {
+        rhs_[k] = -e/D;
+      }
+    }
+
+    // Solve the factorized KKT system
+    linsol_.solve(getPtr(rhs_),1,false);
+
+    // Step in the primal variables and the constraint values
+    copy(rhs_.begin(),rhs_.begin()+n_,dx_.begin());
+    copy(dx_.begin(),dx_.end(),cdx_.begin());
+    fill(cdx_.begin()+n_,cdx_.end(),0);
+    if(nc_>0){
+      const DMatrix& A = input(QP_SOLVER_A);
+      const vector<int>& A_colind = A.colind();
+      const vector<int>& A_row = A.row();
+      const vector<double>& A_data = A.data();
+      for(int cc=0; cc<n_; ++cc){
+        for(int el=A_colind[cc]; el<A_colind[cc+1]; ++el){
+          cdx_[n_+A_row[el]] += A_data[el]*dx_[cc];
+        }
+      }
+    }
+
+    // Recover the steps in the slacks and multipliers
+    for(int k=0; k<m_; ++k){
+      if(type_[k]==LOWER || type_[k]==BOUNDED){
+        dsl_[k] = cdx_[k] + r_l_[k];
+        dzl_[k] = -(r_sl[k] + zl_[k]*dsl_[k])/sl_[k];
+      }
+      if(type_[k]==UPPER || type_[k]==BOUNDED){
+        dsu_[k] = -r_u_[k] - cdx_[k];
+        dzu_[k] = -(r_su[k] + zu_[k]*dsu_[k])/su_[k];
+      }
+      dy_[k] = type_[k]==EQUALITY && k>=n_ ? rhs_[k] : 0;
+    }
+  }
+
+  double InteriorPointQPInternal::maxStep(double alpha) const{
+    for(int k=0; k<m_; ++k){
+      if(type_[k]==LOWER || type_[k]==BOUNDED){
+        if(dsl_[k]<0) alpha = fmin(alpha,-sl_[k]/dsl_[k]);
+        if(dzl_[k]<0) alpha = fmin(alpha,-zl_[k]/dzl_[k]);
+      }
+      if(type_[k]==UPPER || type_[k]==BOUNDED){
+        if(dsu_[k]<0) alpha = fmin(alpha,-su_[k]/dsu_[k]);
+        if(dzu_[k]<0) alpha = fmin(alpha,-zu_[k]/dzu_[k]);
+      }
+    }
+    return alpha;
+  }
+
+  void InteriorPointQPInternal::evaluate(){
+    if (inputs_check_) checkInputs();
+    
+    // Classify the constraints: the simple bounds followed by the linear constraints
+    const vector<double>& lbx = input(QP_SOLVER_LBX).data();
+    const vector<double>& ubx = input(QP_SOLVER_UBX).data();
+    const vector<double>& lba = input(QP_SOLVER_LBA).data();
+    const vector<double>& uba = input(QP_SOLVER_UBA).data();
+    double inf = numeric_limits<double>::infinity();
+    nslack_ = 0;
+    for(int k=0; k<m_; ++k){
+      lo_[k] = k<n_ ? lbx[k] : lba[k-n_];
+      up_[k] = k<n_ ? ubx[k] : uba[k-n_];
+      bool has_lo = lo_[k]!=-inf, has_up = up_[k]!=inf;
+      if(has_lo && has_up && lo_[k]==up_[k]){
+        type_[k] = EQUALITY;
+      } else if(has_lo && has_up){
+        type_[k] = BOUNDED;
+        nslack_ += 2;
+      } else if(has_lo){
+        type_[k] = LOWER;
+        nslack_++;
+      } else if(has_up){
+        type_[k] = UPPER;
+        nslack_++;
+      } else {
+        type_[k] = FREE;
+      }
+    }
+
+    // Scaling of the primal and dual residuals in the termination criterion
+    double pr_scale = 1, du_scale = 1;
+    for(int k=0; k<m_; ++k){
+      if(type_[k]!=FREE && lo_[k]!=-inf) pr_scale = fmax(pr_scale,fabs(lo_[k]));
+      if(type_[k]!=FREE && up_[k]!=inf) pr_scale = fmax(pr_scale,fabs(up_[k]));
+    }
+    const vector<double>& g = input(QP_SOLVER_G).data();
+    for(int i=0; i<n_; ++i) du_scale = fmax(du_scale,fabs(g[i]));
+
+    // Initial guess for the primal variables, fixed variables are kept at their value
+    input(QP_SOLVER_X0).get(x_);
+    for(int i=0; i<n_; ++i){
+      if(type_[i]==EQUALITY) x_[i] = lo_[i];
+    }
+    residuals();
+
+    // Initial slacks and multipliers: a margin of one, or the multipliers of the previous solution shifted away from zero
+    bool warm = warm_start_ && has_solution_;
+    double shift = warm ? warm_start_shift_ : 1;
+    for(int k=0; k<m_; ++k){
+      if(!warm || type_[k]!=EQUALITY) y_[k] = 0;
+      if(type_[k]==LOWER || type_[k]==BOUNDED){
+        sl_[k] = fmax(cx_[k]-lo_[k],shift);
+        zl_[k] = warm ? fmax(zl_[k],shift) : 1;
+      } else {
+        sl_[k] = zl_[k] = dsl_[k] = dzl_[k] = 0;
+      }
+      if(type_[k]==UPPER || type_[k]==BOUNDED){
+        su_[k] = fmax(up_[k]-cx_[k],shift);
+        zu_[k] = warm ? fmax(zu_[k],shift) : 1;
+      } else {
+        su_[k] = zu_[k] = dsu_[k] = dzu_[k] = 0;
+      }
+    }
+    
+    // Mehrotra predictor-corrector iterations
+    int iter;
+    for(iter=0; ; ++iter){
+      residuals();
+      if(verbose()){
+        if(iter % 10 == 0){
+          cout << setw(4) << "iter" << setw(10) << "mu" << setw(10) << "inf_pr" << setw(10) << "inf_du" << endl;
+        }
+        cout << setw(4) << iter << scientific << setprecision(2) << setw(10) << mu_ << setw(10) << pr_inf_ << setw(10) << du_inf_ << endl;
+      }
+      
+      // Converged?
+      if(pr_inf_<=tol_*pr_scale && du_inf_<=tol_*du_scale && mu_<=tol_) break;
+      casadi_assert_message(iter<max_iter_, "InteriorPointQPSolver: Maximum number of iterations reached (inf_pr = " << pr_inf_ << ", inf_du = " << du_inf_ << ", mu = " << mu_ << ")");
+      
+      // Factorize the KKT matrix, it is the same for the predictor and the corrector
+      assembleKKT();
+      linsol_.setInput(kkt_,LINSOL_A);
+      linsol_.prepare();
+
+      // Predictor (affine scaling) step
+      for(int k=0; k<m_; ++k){
+        r_sl_[k] = sl_[k]*zl_[k];
+        r_su_[k] = su_[k]*zu_[k];
+      }
+      solveKKT(r_sl_,r_su_);
+
+      // Corrector step, centered with Mehrotra's heuristic
+      if(nslack_>0){
+        double alpha = maxStep(1);
+        double mu_aff = 0;
+        for(int k=0; k<m_; ++k){
+          mu_aff += (sl_[k] + alpha*dsl_[k])*(zl_[k] + alpha*dzl_[k]);
+          mu_aff += (su_[k] + alpha*dsu_[k])*(zu_[k] + alpha*dzu_[k]);
+        }
+        mu_aff /= nslack_;
+        // The target is kept above a fraction of the tolerance, the KKT matrix becomes too ill-conditioned to reduce the residuals otherwise
+        double mu_target = fmax(std::pow(mu_aff/mu_,3)*mu_,0.1*tol_);
+        for(int k=0; k<m_; ++k){
+          if(type_[k]==LOWER || type_[k]==BOUNDED) r_sl_[k] += dsl_[k]*dzl_[k] - mu_target;
+          if(type_[k]==UPPER || type_[k]==BOUNDED) r_su_[k] += dsu_[k]*dzu_[k] - mu_target;
+        }
+        solveKKT(r_sl_,r_su_);
+      }
+
+      // Take the step, stopping short of the boundary, also when mu is below the machine precision
+      double tau = fmin(fmax(tau_min_,1-mu_),1-sqrt(numeric_limits<double>::epsilon()));
+      double alpha = fmin(1.0,tau*maxStep(1/tau));
+      for(int i=0; i<n_; ++i) x_[i] += alpha*dx_[i];
+      for(int k=0; k<m_; ++k){
+        sl_[k] += alpha*dsl_[k];
+        su_[k] += alpha*dsu_[k];
+        zl_[k] += alpha*dzl_[k];
+        zu_[k] += alpha*dzu_[k];
+        y_[k] += alpha*dy_[k];
+      }
+    }
+
+    // Primal solution and cost
+    output(QP_SOLVER_X).set(x_);
+    const DMatrix& H = input(QP_SOLVER_H);
+    double cost = 0;
+    for(int i=0; i<n_; ++i) cost += g[i]*x_[i];
+    const vector<int>& H_colind = H.colind();
+    const vector<int>& H_row = H.row();
+    const vector<double>& H_data = H.data();
+    for(int cc=0; cc<n_; ++cc){
+      for(int el=H_colind[cc]; el<H_colind[cc+1]; ++el){
+        cost += 0.5*x_[H_row[el]]*H_data[el]*x_[cc];
+      }
+    }
+    output(QP_SOLVER_COST).set(cost);
+
+    // Multipliers, as computed for the last residuals
+    copy(lam_.begin(),lam_.begin()+n_,output(QP_SOLVER_LAM_X).begin());
+    copy(lam_.begin()+n_,lam_.end(),output(QP_SOLVER_LAM_A).begin());
+    has_solution_ = true;
+
+    // Statistics
+    stats_["iter_count"] = iter;
+  }
+
+} // namespace CasADi
@@ -0,0 +1,119 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef INTERIOR_POINT_QP_INTERNAL_HPP
+#define INTERIOR_POINT_QP_INTERNAL_HPP
+
+#include "symbolic/function/qp_solver_internal.hpp"
+#include "symbolic/function/linear_solver.hpp"
+
+/// \cond INTERNAL
+namespace CasADi{
+
+  /** \brief Internal class for InteriorPointQPInternal
+   * 
+      @copydoc QPSolver_doc
+   * */
+class InteriorPointQPInternal : public QPSolverInternal {
+  friend class InteriorPointQPSolver;
+public:
+
+  /** \brief  Clone */
+  virtual InteriorPointQPInternal* clone() const{ return new InteriorPointQPInternal(*this);}
+  
+  /** \brief  Create a new Solver */
+  explicit InteriorPointQPInternal(const std::vector<Sparsity> &st);
+
+  /** \brief  Destructor */
+  virtual ~InteriorPointQPInternal();
+
+  /** \brief  Deep copy data members */
+  virtual void deepCopyMembers(std::map<SharedObjectNode*,SharedObject>& already_copied);
+
+  /** \brief  Initialize */
+  virtual void init();
+  
+  /** \brief Solve the QP */
+  virtual void evaluate();
+
+  protected:
+    /// Type of each constraint, i.e. of each variable followed by each linear constraint
+    enum ConstraintType{ FREE, LOWER, UPPER, BOUNDED, EQUALITY};
+
+    /// Assemble the KKT matrix for the current slacks and multipliers
+    void assembleKKT();
+
+    /// Newton step for the given complementarity residuals, the KKT matrix must be factorized
+    void solveKKT(const std::vector<double>& r_sl, const std::vector<double>& r_su);
+
+    /// Largest step, at most alpha, along the current direction that keeps the slacks and multipliers nonnegative
+    double maxStep(double alpha) const;
+
+    /// Residuals of the KKT conditions and average complementarity
+    void residuals();
+
+    /// Linear solver for the KKT system
+    LinearSolver linsol_;
+
+    /// Options
+    int max_iter_;
+    double tol_, reg_, tau_min_, warm_start_shift_;
+    bool warm_start_;
+
+    /// Number of constraints (variables and linear constraints), number of bounds with a slack
+    int m_, nslack_;
+
+    /// Type and bounds of each constraint
+    std::vector<ConstraintType> type_;
+    std::vector<double> lo_, up_;
+
+    /// Position of the nonzeros of H, A and A' and of the diagonal in the KKT matrix
+    std::vector<int> kkt_h_, kkt_a_, kkt_at_, kkt_diag_;
+
+    /// Nonzeros of the KKT matrix
+    std::vector<double> kkt_;
+
+    /// Iterate: primal variables, constraint values, slacks and multipliers of the lower and upper bounds, multipliers of the equalities
+    std::vector<double> x_, cx_, sl_, su_, zl_, zu_, y_;
+
+    /// Multipliers of the constraints, positive for active upper bounds
+    std::vector<double> lam_;
+
+    /// Residuals: gradient of the Lagrangian, constraint residuals, complementarity
+    std::vector<double> r_d_, r_l_, r_u_, r_sl_, r_su_;
+
+    /// Newton direction
+    std::vector<double> dx_, cdx_, dsl_, dsu_, dzl_, dzu_, dy_;
+
+    /// Right-hand side and solution of the KKT system
+    std::vector<double> rhs_;
+
+    /// Average complementarity and norm of the residuals
+    double mu_, pr_inf_, du_inf_;
+
+    /// A previous solution is available for a warm start
+    bool has_solution_;
+};
+
+} // namespace CasADi
+/// \endcond
+#endif //INTERIOR_POINT_QP_INTERNAL_HPP
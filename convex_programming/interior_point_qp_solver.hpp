@@ -0,0 +1,94 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef INTERIOR_POINT_QP_SOLVER_HPP
+#define INTERIOR_POINT_QP_SOLVER_HPP
+
+#include "symbolic/function/qp_solver.hpp"
+#include "symbolic/function/linear_solver.hpp"
+
+namespace CasADi {
+  
+  
+// Forward declaration of internal class 
+class InteriorPointQPInternal;
+
+  /** \brief Primal-dual interior point method for sparse QPs
+
+   Mehrotra's predictor-corrector method, applied to the QP with the simple bounds and the linear
+   constraints turned into equalities with nonnegative slack variables. The slacks and their multipliers
+   are eliminated from the Newton system, which leaves a symmetric indefinite KKT system in the primal
+   variables and the multipliers of the linear constraints:
+   \verbatim
+   [ H + D_x + reg*I       A'     ] [dx     ]   [r_x]
+   [      A           -inv(D_a)   ] [dlam_a ] = [r_a]
+   \endverbatim
+   The pattern of this matrix is fixed, it is factorized once per iteration by the linear solver
+   given by the option "linear_solver" (e.g. CSparse, or SparseLDL, which exploits the symmetry) and
+   solved twice, for the predictor and the corrector step. Equality constraints (LBA==UBA) get the diagonal entry -reg and fixed variables
+   (LBX==UBX) are removed from the system. The method stops when the average complementarity is below
+   "tol" and the residuals are below "tol" relative to the largest bound and gradient entry.
+
+   The iterates need not be feasible. The method is started from X0 with slacks and multipliers
+   of one, or, with the option "warm_start", from the multipliers of the previous solution, moved
+   away from zero by "warm_start_shift".
+
+   @copydoc QPSolver_doc
+  */
+class InteriorPointQPSolver : public QPSolver {
+public:
+
+  /** \brief  Default constructor */
+  InteriorPointQPSolver();
+  
+  
+  /** \brief Constructor
+  *  \param st Problem structure
+  *  \copydoc scheme_QPStruct
+  */
+  explicit InteriorPointQPSolver(const QPStructure & st);
+  
+  /** \brief  Access functions of the node */
+  InteriorPointQPInternal* operator->();
+  const InteriorPointQPInternal* operator->() const;
+
+  /// Check if the node is pointing to the right type of object
+  virtual bool checkNode() const;
+  
+  /// Static creator function
+  #ifdef SWIG
+  %callback("%s_cb");
+  #endif
+  static QPSolver creator(const QPStructure & st){ return InteriorPointQPSolver(st);}
+  #ifdef SWIG
+  %nocallback;
+  #endif
+  
+  /// Access the linear solver used for the KKT system
+  LinearSolver & getLinearSolver();
+
+};
+
+
+} // namespace CasADi
+
+#endif //INTERIOR_POINT_QP_SOLVER_HPP
@@ -0,0 +1,124 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/** \brief Coloring time and number of colors for large Jacobian and Hessian sparsity patterns
+ * 
+ * Usage: coloring_benchmark [n] [nthreads]
+ */
+
+#include <symbolic/casadi.hpp>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <ctime>
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif // WITH_OPENMP
+
+using namespace CasADi;
+using namespace std;
+
+/// Wall clock time
+double wallTime(){
+#ifdef WITH_OPENMP
+  return omp_get_wtime();
+#else // WITH_OPENMP
+  return double(clock())/CLOCKS_PER_SEC;
+#endif // WITH_OPENMP
+}
+
+/// Pseudo-random sparse n-by-n pattern with a banded part and nnz_rand random entries per column
+Sparsity randomPattern(int n, int bw, int nnz_rand){
+  vector<int> row, col;
+  unsigned int seed = 12345;
+  for(int j=0; j<n; ++j){
+    for(int i=max(0,j-bw); i<=min(n-1,j+bw); ++i){
+      row.push_back(i);
+      col.push_back(j);
+    }
+    for(int k=0; k<nnz_rand; ++k){
+      seed = 1103515245*seed + 12345;
+      row.push_back((seed/65536) % n);
+      col.push_back(j);
+    }
+  }
+  return Sparsity::triplet(n,n,row,col);
+}
+
+/// Check that no two columns of the same color share a row
+bool validColoring(const Sparsity& A, const Sparsity& D){
+  vector<int> owner(A.size1(),-1);
+  const vector<int>& colind = A.colind();
+  const vector<int>& row = A.row();
+  vector<bool> colored(A.size2(),false);
+  for(int c=0; c<D.size2(); ++c){
+    fill(owner.begin(),owner.end(),-1);
+    for(int el=D.colind(c); el<D.colind(c+1); ++el){
+      int j = D.row(el);
+      colored[j] = true;
+      for(int k=colind[j]; k<colind[j+1]; ++k){
+        if(owner[row[k]]>=0) return false;
+        owner[row[k]] = j;
+      }
+    }
+  }
+  for(int j=0; j<A.size2(); ++j) if(!colored[j]) return false;
+  return true;
+}
+
+int main(int argc, char* argv[]){
+  int n = argc>1 ? atoi(argv[1]) : 100000;
+  int nthreads = argc>2 ? atoi(argv[2]) : 4;
+
+  const char* ordering_names[] = {"natural","largest_first","smallest_last","incidence_degree"};
+  
+  // Jacobian patterns
+  cout << "Unidirectional (distance-2 bipartite) coloring, n = " << n << endl;
+  cout << setw(22) << "pattern" << setw(18) << "ordering" << setw(10) << "threads" << setw(10) << "colors" << setw(12) << "time [s]" << setw(8) << "valid" << endl;
+  for(int p=0; p<2; ++p){
+    Sparsity A = p==0 ? randomPattern(n,2,1) : randomPattern(n,0,3);
+    Sparsity AT = A.transpose();
+    string pname = p==0 ? "banded + random" : "random";
+    for(int ordering=0; ordering<4; ++ordering){
+      for(int t=0; t<2; ++t){
+        int nt = t==0 ? 1 : nthreads;
+        double t0 = wallTime();
+        Sparsity D = t==0 ? A.unidirectionalColoring(AT,numeric_limits<int>::max(),ordering) : A.unidirectionalColoringParallel(AT,nt,ordering);
+        double time = wallTime()-t0;
+        cout << setw(22) << pname << setw(18) << ordering_names[ordering] << setw(10) << nt << setw(10) << D.size2() << setw(12) << time << setw(8) << validColoring(A,D) << endl;
+      }
+    }
+  }
+
+  // Hessian pattern
+  cout << endl << "Star coloring of a symmetric pattern, n = " << n << endl;
+  Sparsity H = randomPattern(n,2,1);
+  H = H + H.transpose();
+  for(int ordering=0; ordering<4; ++ordering){
+    double t0 = wallTime();
+    Sparsity D = H.starColoring(ordering);
+    double time = wallTime()-t0;
+    cout << setw(18) << ordering_names[ordering] << setw(10) << D.size2() << setw(12) << time << endl;
+  }
+  
+  return 0;
+}
@@ -0,0 +1,110 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/** \brief Adaptive Dormand-Prince 5(4) integration compared with fixed step RK4 at equal accuracy
+ * 
+ * The test problem is the Arenstorf orbit of the restricted three-body problem, which is periodic
+ * with period T. The error is the distance between the initial state and the state after one period.
+ * For each tolerance, the number of finite elements of the RK4 integrator is doubled until it is at
+ * least as accurate as the adaptive integrator.
+ *
+ * Usage: dormand_prince_benchmark [nrep]
+ */
+
+#include <symbolic/casadi.hpp>
+#include <integration/dormand_prince_integrator.hpp>
+#include <integration/rk_integrator.hpp>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <ctime>
+
+using namespace CasADi;
+using namespace std;
+
+/// Integrate nrep times, return the CPU time per integration and the error after one period
+void run(Integrator& I, const DMatrix& x0, int nrep, double& t_cpu, double& err){
+  I.setInput(x0,"x0");
+  clock_t t1 = clock();
+  for(int r=0; r<nrep; ++r) I.evaluate();
+  t_cpu = double(clock()-t1)/CLOCKS_PER_SEC/nrep;
+  err = norm_inf(I.output("xf")-x0).toScalar();
+}
+
+int main(int argc, char* argv[]){
+  int nrep = argc>1 ? atoi(argv[1]) : 5;
+
+  // Arenstorf orbit
+  double mu = 0.012277471, mu1 = 1-mu;
+  double T = 17.0652165601579625588917206249;
+  SX y1 = SX::sym("y1"), y2 = SX::sym("y2"), v1 = SX::sym("v1"), v2 = SX::sym("v2");
+  SX d1 = pow(sq(y1+mu)+sq(y2),1.5);
+  SX d2 = pow(sq(y1-mu1)+sq(y2),1.5);
+  vector<SX> x(4), ode(4);
+  x[0] = y1;  ode[0] = v1;
+  x[1] = y2;  ode[1] = v2;
+  x[2] = v1;  ode[2] = y1 + 2*v2 - mu1*(y1+mu)/d1 - mu*(y1-mu1)/d2;
+  x[3] = v2;  ode[3] = y2 - 2*v1 - mu1*y2/d1 - mu*y2/d2;
+  SXFunction f(daeIn("x",vertcat(x)),daeOut("ode",vertcat(ode)));
+  f.init();
+  double x0_data[] = {0.994, 0, 0, -2.00158510637908252240537862224};
+  DMatrix x0(vector<double>(x0_data,x0_data+4));
+
+  cout << setw(8) << "tol" << " | " << setw(10) << "error" << setw(8) << "steps" << setw(8) << "f evals" << setw(12) << "time [ms]"
+       << " | " << setw(10) << "error" << setw(8) << "steps" << setw(8) << "f evals" << setw(12) << "time [ms]" << endl;
+  cout << setw(8) << "" << " | " << setw(38) << "Dormand-Prince 5(4)" << " | " << setw(38) << "RK4" << endl;
+
+  int nk = 64;
+  for(double tol=1e-5; tol>=1e-10; tol*=0.1){
+    // Adaptive integrator
+    DormandPrinceIntegrator dp(f);
+    dp.setOption("tf",T);
+    dp.setOption("abstol",tol);
+    dp.setOption("reltol",tol);
+    dp.setOption("max_num_steps",1000000);
+    dp.init();
+    double t_dp, err_dp;
+    run(dp,x0,nrep,t_dp,err_dp);
+    int nsteps = dp.getStat("nsteps");
+    int nfevals = dp.getStat("nfevals");
+
+    // Fixed step integrator with at least the same accuracy
+    double t_rk, err_rk;
+    RKIntegrator rk;
+    while(true){
+      rk = RKIntegrator(f);
+      rk.setOption("tf",T);
+      rk.setOption("number_of_finite_elements",nk);
+      rk.init();
+      run(rk,x0,1,t_rk,err_rk);
+      if(err_rk<=err_dp) break;
+      nk *= 2;
+    }
+    run(rk,x0,nrep,t_rk,err_rk);
+
+    cout << setw(8) << tol << " | " << setw(10) << err_dp << setw(8) << nsteps << setw(8) << nfevals << setw(12) << 1e3*t_dp
+         << " | " << setw(10) << err_rk << setw(8) << nk << setw(8) << 4*nk << setw(12) << 1e3*t_rk << endl;
+  }
+
+  return 0;
+}
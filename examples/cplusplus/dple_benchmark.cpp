@@ -0,0 +1,126 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/** \brief Discrete periodic Lyapunov solvers compared for growing state dimension n and period K
+ * 
+ * SimpleIndefDpleSolver solves the n^2K-by-n^2K Kronecker system with CSparse and is skipped when
+ * that system grows beyond a few thousand unknowns. PsdIndefDpleSolver is included when CasADi is
+ * built with SLICOT. The residual is the largest violation of P_{k+1} = A_k P_k A_k^T + V_k.
+ *
+ * Usage: dple_benchmark [nrep]
+ */
+
+#include <symbolic/casadi.hpp>
+#include <control/simple_indef_dple_solver.hpp>
+#include <control/doubling_dple_solver.hpp>
+#include <interfaces/csparse/csparse.hpp>
+#ifdef WITH_SLICOT
+#include <interfaces/slicot/psd_indef_dple_solver.hpp>
+#endif // WITH_SLICOT
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+
+using namespace CasADi;
+using namespace std;
+
+/// Largest violation of the periodic Lyapunov equations
+double residual(int n, int K, const DMatrix& A, const DMatrix& V, const DMatrix& P){
+  vector<DMatrix> As = horzsplit(A,n), Vs = horzsplit(V,n), Ps = horzsplit(P,n);
+  double ret = 0;
+  for(int k=0; k<K; ++k){
+    DMatrix r = Ps[(k+1)%K] - mul(As[k],mul(Ps[k],As[k].T())) - Vs[k];
+    ret = max(ret,norm_inf(r).toScalar());
+  }
+  return ret;
+}
+
+/// Solve nrep times, print the CPU time per solve and the residual
+void run(DpleSolver& f, int n, int K, const DMatrix& A, const DMatrix& V, int nrep){
+  f.init();
+  f.setInput(A,DPLE_A);
+  f.setInput(V,DPLE_V);
+  clock_t t1 = clock();
+  for(int r=0; r<nrep; ++r) f.evaluate();
+  double t_cpu = double(clock()-t1)/CLOCKS_PER_SEC/nrep;
+  cout << setw(12) << t_cpu*1000 << setw(10) << setprecision(1) << scientific << residual(n,K,A,V,f.output(DPLE_P)) << fixed << setprecision(3);
+}
+
+int main(int argc, char* argv[]){
+  int nrep = argc>1 ? atoi(argv[1]) : 5;
+  srand(1);
+
+  cout << setw(4) << "n" << setw(4) << "K" << " | " << setw(22) << "SimpleIndef+CSparse" << " | " << setw(22) << "Doubling";
+#ifdef WITH_SLICOT
+  cout << " | " << setw(22) << "PsdIndef";
+#endif // WITH_SLICOT
+  cout << endl;
+  cout << setw(8) << "" << " | " << setw(12) << "time [ms]" << setw(10) << "residual" << " | " << setw(12) << "time [ms]" << setw(10) << "residual";
+#ifdef WITH_SLICOT
+  cout << " | " << setw(12) << "time [ms]" << setw(10) << "residual";
+#endif // WITH_SLICOT
+  cout << endl << fixed << setprecision(3);
+
+  int K_list[] = {2, 5, 10};
+  int n_list[] = {4, 8, 16, 32, 64};
+  for(int ik=0; ik<3; ++ik){
+    for(int in=0; in<5; ++in){
+      int K = K_list[ik], n = n_list[in];
+      
+      // Random data with a stable monodromy matrix and positive semidefinite V_k
+      DMatrix A = DMatrix::zeros(n,K*n), B = DMatrix::zeros(n,K*n);
+      double scale = 0.9*sqrt(12.0/n);
+      for(int i=0; i<A.size(); ++i){
+        A.at(i) = scale*(rand()/double(RAND_MAX)-0.5);
+        B.at(i) = rand()/double(RAND_MAX);
+      }
+      vector<DMatrix> Bs = horzsplit(B,n), Vs(K);
+      for(int k=0; k<K; ++k) Vs[k] = mul(Bs[k],Bs[k].T());
+      DMatrix V = horzcat(Vs);
+      vector<Sparsity> sp(K,Sparsity::dense(n,n));
+      
+      cout << setw(4) << n << setw(4) << K << " | ";
+      if(n*n*K<=2000){
+        SimpleIndefDpleSolver f(sp,sp);
+        f.setOption("linear_solver",CSparse::creator);
+        run(f,n,K,A,V,nrep);
+      } else {
+        cout << setw(22) << "-";
+      }
+      cout << " | ";
+      DoublingDpleSolver g(sp,sp);
+      run(g,n,K,A,V,nrep);
+#ifdef WITH_SLICOT
+      cout << " | ";
+      PsdIndefDpleSolver h(sp,sp);
+      h.setOption("linear_solver",CSparse::creator);
+      run(h,n,K,A,V,nrep);
+#endif // WITH_SLICOT
+      cout << endl;
+    }
+  }
+  
+  return 0;
+}
@@ -0,0 +1,118 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/** \brief Time and memory needed to expand multiple shooting MX graphs into SX graphs
+ * 
+ * The test problem is a chain of nm masses integrated over nk shooting intervals with one 
+ * RK4 step each. Each shooting interval calls the integrator twice with the same arguments,
+ * once for the continuity constraints and once for the objective, as is typical for
+ * least-squares formulations.
+ *
+ * Usage: expand_benchmark [nm] [nk_max]
+ */
+
+#include <symbolic/casadi.hpp>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <ctime>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+using namespace CasADi;
+using namespace std;
+
+/// Peak resident memory of the process in MB (0 if not available)
+double peak_memory(){
+#ifndef _WIN32
+  rusage usage;
+  getrusage(RUSAGE_SELF,&usage);
+  return usage.ru_maxrss/1024.0;
+#else
+  return 0;
+#endif
+}
+
+int main(int argc, char* argv[]){
+  int nm = argc>1 ? atoi(argv[1]) : 10;
+  int nk_max = argc>2 ? atoi(argv[2]) : 400;
+  double h = 0.01;
+
+  // Right hand side of a chain of masses connected by nonlinear springs
+  SX x = SX::sym("x",2*nm), u = SX::sym("u");
+  SX p = x(Slice(0,nm)), v = x(Slice(nm,2*nm));
+  SX a = SX::zeros(nm,1);
+  for(int i=0; i<nm; ++i){
+    SX p_i = p(i), v_i = v(i);
+    SX left = i==0 ? u : SX(p(i-1));
+    SX right = i==nm-1 ? SX(0) : SX(p(i+1));
+    SX dl = p_i-left, dr = right-p_i;
+    a(i) = -9.81 - 0.1*v_i + (dr + 0.5*dr*dr*dr) - (dl + 0.5*dl*dl*dl);
+  }
+  vector<SX> f_in(2); f_in[0] = x; f_in[1] = u;
+  SXFunction f(f_in,vertcat(v,a));
+  f.init();
+
+  // One RK4 step as a matrix valued function calling f
+  MX X = MX::sym("X",2*nm), U = MX::sym("U");
+  vector<MX> arg(2); arg[1] = U;
+  arg[0] = X;        MX k1 = f.call(arg).front();
+  arg[0] = X+h/2*k1; MX k2 = f.call(arg).front();
+  arg[0] = X+h/2*k2; MX k3 = f.call(arg).front();
+  arg[0] = X+h*k3;   MX k4 = f.call(arg).front();
+  vector<MX> F_in(2); F_in[0] = X; F_in[1] = U;
+  MXFunction F(F_in,X+h/6*(k1+2*k2+2*k3+k4));
+  F.init();
+
+  cout << setw(8) << "nk" << setw(12) << "MX nodes" << setw(14) << "SX nodes" 
+       << setw(18) << "expand time [s]" << setw(18) << "peak memory [MB]" << endl;
+  for(int nk=nk_max/8; nk<=nk_max; nk*=2){
+    // Multiple shooting with nk intervals
+    MX W = MX::sym("W",(2*nm+1)*nk + 2*nm);
+    vector<MX> g;
+    MX obj = 0;
+    for(int k=0; k<nk; ++k){
+      int offset = (2*nm+1)*k;
+      arg[0] = W(Slice(offset,offset+2*nm));
+      arg[1] = W(offset+2*nm);
+      MX xf = F.call(arg).front();
+      g.push_back(xf - W(Slice(offset+2*nm+1,offset+4*nm+1)));
+      MX xf_obj = F.call(arg).front();
+      obj += inner_prod(xf_obj,xf_obj);
+    }
+    vector<MX> nlp_out(2); nlp_out[0] = obj; nlp_out[1] = vertcat(g);
+    MXFunction nlp(W,nlp_out);
+    nlp.init();
+    
+    // Expand
+    clock_t t0 = clock();
+    SXFunction nlp_sx = nlp.expand();
+    nlp_sx.init();
+    double t = double(clock()-t0)/CLOCKS_PER_SEC;
+    cout << setw(8) << nk << setw(12) << nlp.countNodes() << setw(14) << nlp_sx.countNodes() 
+         << setw(18) << t << setw(18) << peak_memory() << endl;
+  }
+  
+  return 0;
+}
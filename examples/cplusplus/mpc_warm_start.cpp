@@ -0,0 +1,199 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <ctime>
+#include <symbolic/casadi.hpp>
+#include <nonlinear_programming/sqp_method.hpp>
+#include <interfaces/qpoases/qpoases_solver.hpp>
+
+using namespace CasADi;
+using namespace std;
+/**
+ *  Benchmark of warm starting an SQP method in a model predictive control loop.
+ *  The Van der Pol oscillator is stabilized with a direct multiple shooting
+ *  formulation with N shooting intervals. In each MPC step, the initial state
+ *  is passed as a parameter and the NLP is solved either from the same cold initial
+ *  guess or warm started from the previous solution shifted by one interval.
+ *  Reports the number of SQP iterations and the solution time per MPC step.
+ *  Finally, the real-time iteration scheme is run: one SQP iteration per step,
+ *  split into a preparation phase before the new state is known and a feedback
+ *  phase, whose duration is the feedback delay of the controller.
+ */
+
+// Number of shooting intervals, states and controls
+const int N = 20;
+const int NX = 2;
+const int NU = 1;
+
+// Run a closed-loop simulation, returns the total number of SQP iterations
+// mode is "cold", "warm" or "rti", for the latter t_total is the accumulated feedback time after the initial full solve
+int runMPC(const string& hessian_approximation, const string& mode, int n_steps, double& t_total){
+  // Time step
+  double h = 0.2;
+  
+  // Explicit Runge-Kutta integrator for one shooting interval
+  SX x = SX::sym("x",NX);
+  SX u = SX::sym("u",NU);
+  SX xdot = vertcat((1-x[1]*x[1])*x[0] - x[1] + u[0], x[0]);
+  vector<SX> ode_in; ode_in.push_back(x); ode_in.push_back(u);
+  SXFunction ode(ode_in,xdot);
+  ode.init();
+  
+  // Decision variables: [x_0, u_0, x_1, u_1, ..., x_N]
+  MX V = MX::sym("V",N*(NX+NU)+NX);
+  MX P = MX::sym("P",NX);
+  vector<MX> g;
+  MX f = 0;
+  int offset = 0;
+  MX xk = V(Slice(offset,offset+NX)); offset += NX;
+  g.push_back(xk - P);
+  for(int k=0; k<N; ++k){
+    MX uk = V(Slice(offset,offset+NU)); offset += NU;
+    
+    // RK4 step
+    vector<MX> arg(2); arg[1] = uk;
+    arg[0] = xk;            MX k1 = ode.call(arg).front();
+    arg[0] = xk + h/2*k1;   MX k2 = ode.call(arg).front();
+    arg[0] = xk + h/2*k2;   MX k3 = ode.call(arg).front();
+    arg[0] = xk + h*k3;     MX k4 = ode.call(arg).front();
+    MX xk_end = xk + h/6*(k1 + 2*k2 + 2*k3 + k4);
+    
+    f += inner_prod(xk,xk) + inner_prod(uk,uk);
+    xk = V(Slice(offset,offset+NX)); offset += NX;
+    g.push_back(xk_end - xk);
+  }
+  f += 10*inner_prod(xk,xk);
+  MXFunction nlp(nlpIn("x",V,"p",P),nlpOut("f",f,"g",vertcat(g)));
+  
+  // Allocate the solver
+  SQPMethod solver(nlp);
+  solver.setOption("expand",true);
+  solver.setOption("qp_solver",QPOasesSolver::creator);
+  Dictionary qp_solver_options;
+  qp_solver_options["printLevel"] = "none";
+  solver.setOption("qp_solver_options",qp_solver_options);
+  solver.setOption("hessian_approximation",hessian_approximation);
+  solver.setOption("max_iter",200);
+  solver.setOption("print_header",false);
+  solver.setOption("print_time",false);
+  solver.setOption("warm_start",mode=="warm");
+  solver.setOption("warm_start_shift_x",NX+NU);
+  solver.setOption("warm_start_shift_g",NX);
+  solver.init();
+  
+  // Control bounds
+  double inf = numeric_limits<double>::infinity();
+  vector<double> lbx(V.size(),-inf), ubx(V.size(),inf);
+  for(int k=0; k<N; ++k){
+    lbx[NX+k*(NX+NU)] = -1;
+    ubx[NX+k*(NX+NU)] =  1;
+  }
+  solver.setInput(lbx,"lbx");
+  solver.setInput(ubx,"ubx");
+  solver.setInput(0.,"lbg");
+  solver.setInput(0.,"ubg");
+  
+  // Initial state of the plant
+  vector<double> x_plant(NX);
+  x_plant[0] = 0; x_plant[1] = 1;
+  
+  int iter_total = 0;
+  t_total = 0;
+  for(int step=0; step<n_steps; ++step){
+    // Cold initial guess, overwritten internally when warm starting
+    solver.setInput(0.,"x0");
+    
+    // Solve, suppressing the iteration output
+    stringstream ss;
+    streambuf* cout_buf = cout.rdbuf(ss.rdbuf());
+    int iter;
+    double t_step;
+    if(mode=="rti" && step>0){
+      // Preparation, then feedback as soon as the state is available
+      solver.prepare();
+      solver.setInput(x_plant,"p");
+      solver.feedback();
+      iter = 1;
+      t_step = solver.getStat("t_feedback");
+    } else {
+      // Full solve, also used to initialize the real-time iterations
+      solver.setInput(x_plant,"p");
+      double time1 = clock();
+      solver.evaluate();
+      double time2 = clock();
+      iter = solver.getStat("iter_count");
+      t_step = double(time2-time1)/CLOCKS_PER_SEC;
+    }
+    cout.rdbuf(cout_buf);
+    
+    iter_total += iter;
+    if(mode!="rti" || step>0) t_total += t_step;
+    cout << setw(6) << step << setw(8) << iter << setw(14) << t_step*1000;
+    if(mode=="rti" && step>0){
+      cout << setw(14) << double(solver.getStat("t_prepare"))*1000;
+    }
+    cout << endl;
+    
+    // Apply the first control and propagate the plant
+    double uk = solver.output("x").at(NX);
+    ode.setInput(uk,1);
+    for(int s=0; s<4; ++s){
+      // Integrate one sampling interval with a finer RK4 grid
+      double hs = h/4;
+      vector<double> x0 = x_plant, k1(NX), k2(NX), k3(NX), k4(NX), xs(NX);
+      ode.setInput(x0,0); ode.evaluate(); ode.getOutput(k1);
+      for(int i=0; i<NX; ++i) xs[i] = x0[i] + hs/2*k1[i];
+      ode.setInput(xs,0); ode.evaluate(); ode.getOutput(k2);
+      for(int i=0; i<NX; ++i) xs[i] = x0[i] + hs/2*k2[i];
+      ode.setInput(xs,0); ode.evaluate(); ode.getOutput(k3);
+      for(int i=0; i<NX; ++i) xs[i] = x0[i] + hs*k3[i];
+      ode.setInput(xs,0); ode.evaluate(); ode.getOutput(k4);
+      for(int i=0; i<NX; ++i) x_plant[i] = x0[i] + hs/6*(k1[i] + 2*k2[i] + 2*k3[i] + k4[i]);
+    }
+  }
+  return iter_total;
+}
+
+int main(){
+  int n_steps = 30;
+  const char* hess[] = {"exact", "limited-memory"};
+  for(int i=0; i<2; ++i){
+    double t_cold, t_warm, t_rti;
+    cout << "Hessian approximation: " << hess[i] << ", cold start" << endl;
+    cout << setw(6) << "step" << setw(8) << "iter" << setw(14) << "time [ms]" << endl;
+    int iter_cold = runMPC(hess[i],"cold",n_steps,t_cold);
+    cout << "Hessian approximation: " << hess[i] << ", warm start" << endl;
+    cout << setw(6) << "step" << setw(8) << "iter" << setw(14) << "time [ms]" << endl;
+    int iter_warm = runMPC(hess[i],"warm",n_steps,t_warm);
+    cout << "Hessian approximation: " << hess[i] << ", real-time iterations" << endl;
+    cout << setw(6) << "step" << setw(8) << "iter" << setw(14) << "feedback [ms]" << setw(14) << "prepare [ms]" << endl;
+    runMPC(hess[i],"rti",n_steps,t_rti);
+    cout << "Summary (" << hess[i] << "): " << endl;
+    cout << "  cold start: " << double(iter_cold)/n_steps << " iterations, " << t_cold/n_steps*1000 << " ms per MPC step" << endl;
+    cout << "  warm start: " << double(iter_warm)/n_steps << " iterations, " << t_warm/n_steps*1000 << " ms per MPC step" << endl;
+    cout << "  real-time iterations: " << t_rti/(n_steps-1)*1000 << " ms feedback delay per MPC step" << endl;
+  }
+  return 0;
+}
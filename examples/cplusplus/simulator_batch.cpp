@@ -0,0 +1,102 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/** \brief Monte-Carlo simulation of a Van der Pol oscillator with a batched Simulator
+ * 
+ * The initial conditions and the damping parameter are sampled randomly. The trajectories
+ * are not stored: a sink accumulates the mean trajectory and the largest amplitude.
+ *
+ * Usage: simulator_batch [ntraj] [nthreads]
+ */
+
+#include <symbolic/casadi.hpp>
+#include <symbolic/function/simulator.hpp>
+#include <interfaces/sundials/cvodes_integrator.hpp>
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+
+using namespace CasADi;
+using namespace std;
+
+/// Accumulates statistics of the trajectories as they are simulated
+class Statistics : public BatchSink{
+public:
+  Statistics(int ngrid) : mean(DMatrix::zeros(2,ngrid)), max_amplitude(0), ntraj(0){}
+  
+  virtual void operator()(int ind, const vector<const DMatrix*>& res){
+    const DMatrix& x = *res[INTEGRATOR_XF];
+    mean += x;
+    for(int i=0; i<x.size(); i+=2) max_amplitude = std::max(max_amplitude,std::abs(x.at(i)));
+    ntraj++;
+  }
+
+  DMatrix mean;
+  double max_amplitude;
+  int ntraj;
+};
+
+int main(int argc, char* argv[]){
+  int ntraj = argc>1 ? atoi(argv[1]) : 1000;
+  int nthreads = argc>2 ? atoi(argv[2]) : 1;
+
+  // Van der Pol oscillator
+  SX x = SX::sym("x",2), mu = SX::sym("mu");
+  SX x0 = x(0), x1 = x(1);
+  SX ode = vertcat(x1, mu*(1-x0*x0)*x1 - x0);
+  SXFunction dae(daeIn("x",x,"p",mu),daeOut("ode",ode));
+
+  CVodesIntegrator integrator(dae);
+  integrator.setOption("abstol",1e-8);
+  integrator.setOption("reltol",1e-8);
+  
+  // Output every 0.1 time units
+  int ngrid = 51;
+  vector<double> grid(ngrid);
+  for(int k=0; k<ngrid; ++k) grid[k] = 0.1*k;
+  Simulator sim(integrator,grid);
+  sim.init();
+
+  // Random initial conditions and parameters
+  srand(1);
+  vector<DMatrix> x0_samples(ntraj), p_samples(ntraj);
+  for(int k=0; k<ntraj; ++k){
+    x0_samples[k] = DMatrix::zeros(2,1);
+    x0_samples[k].at(0) = 2.0*rand()/RAND_MAX - 1;
+    x0_samples[k].at(1) = 2.0*rand()/RAND_MAX - 1;
+    p_samples[k] = 0.5 + 1.5*rand()/RAND_MAX;
+  }
+
+  // Simulate
+  Statistics stats(ngrid);
+  clock_t t0 = clock();
+  sim.simulateBatch(x0_samples,p_samples,stats,nthreads);
+  double t = double(clock()-t0)/CLOCKS_PER_SEC;
+  stats.mean /= stats.ntraj;
+
+  cout << stats.ntraj << " trajectories simulated in " << t << " s (CPU time)" << endl;
+  cout << "largest amplitude: " << stats.max_amplitude << endl;
+  cout << "mean final state: " << stats.mean(Slice(),ngrid-1) << endl;
+  
+  return 0;
+}
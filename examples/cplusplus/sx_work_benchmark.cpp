@@ -0,0 +1,116 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+
+/** \brief Work vector size and locality of large SX functions for the different topological sortings
+ * 
+ * The test models are a chain of nm masses connected by nonlinear springs, integrated with 
+ * ns unrolled RK4 steps, its Jacobian and a set of pseudo-random expression trees.
+ *
+ * Usage: sx_work_benchmark [nm] [ns]
+ */
+
+#include <symbolic/casadi.hpp>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <ctime>
+
+using namespace CasADi;
+using namespace std;
+
+/// Right hand side of the hanging chain
+SX chain_rhs(const SX& x, int nm){
+  SX p = x(Slice(0,nm)), v = x(Slice(nm,2*nm));
+  SX a = SX::zeros(nm,1);
+  for(int i=0; i<nm; ++i){
+    SX p_i = p(i), v_i = v(i);
+    SX left = i==0 ? SX(0) : SX(p(i-1));
+    SX right = i==nm-1 ? SX(0) : SX(p(i+1));
+    SX dl = p_i-left, dr = right-p_i;
+    a(i) = -9.81 - 0.1*v_i + (dr + 0.5*dr*dr*dr) - (dl + 0.5*dl*dl*dl) + sin(p_i);
+  }
+  return vertcat(v,a);
+}
+
+/// Pseudo-random expression tree
+SXElement random_tree(const SX& x, int depth, unsigned int& seed){
+  seed = 1103515245*seed + 12345;
+  int r = seed/65536;
+  if(depth==0 || r%4==0) return x.at((r/4) % x.size());
+  SXElement a = random_tree(x,depth-1,seed), b = random_tree(x,depth-1,seed);
+  switch((r/4)%3){
+    case 0: return a+b;
+    case 1: return a*b;
+    default: return sin(a)-b;
+  }
+}
+
+int main(int argc, char* argv[]){
+  int nm = argc>1 ? atoi(argv[1]) : 50;
+  int ns = argc>2 ? atoi(argv[2]) : 20;
+  double h = 0.01;
+  
+  // Unrolled RK4 integration
+  SX x0 = SX::sym("x0",2*nm);
+  SX x = x0;
+  for(int k=0; k<ns; ++k){
+    SX k1 = chain_rhs(x,nm);
+    SX k2 = chain_rhs(x+h/2*k1,nm);
+    SX k3 = chain_rhs(x+h/2*k2,nm);
+    SX k4 = chain_rhs(x+h*k3,nm);
+    x += h/6*(k1+2*k2+2*k3+k4);
+  }
+  SXFunction F(x0,x);
+  F.init();
+  SXFunction J(x0,F.jac());
+
+  // Expression trees
+  unsigned int seed = 1;
+  vector<SXElement> trees;
+  for(int i=0; i<200; ++i) trees.push_back(random_tree(x0,14,seed));
+  SXFunction T(x0,SX(trees));
+
+  const char* sortings[] = {"depth-first","sethi-ullman"};
+  const int nrep = 20;
+  DMatrix x0_val = DMatrix::ones(2*nm,1)*0.1;
+  
+  cout << setw(14) << "function" << setw(16) << "sorting" << setw(14) << "operations" << setw(12) << "work size" 
+       << setw(16) << "cache misses" << setw(16) << "eval time [s]" << endl;
+  const char* fnames[] = {"F","jacobian(F)","trees"};
+  for(int f=0; f<3; ++f){
+    for(int s=0; s<2; ++s){
+      SXFunction fcn = f==0 ? SXFunction(x0,x) : f==1 ? SXFunction(J.inputExpr(),J.outputExpr()) : SXFunction(T.inputExpr(),T.outputExpr());
+      fcn.setOption("topological_sorting",sortings[s]);
+      fcn.setOption("simulate_cache",true);
+      fcn.init();
+      fcn.setInput(x0_val);
+      clock_t t0 = clock();
+      for(int r=0; r<nrep; ++r) fcn.evaluate();
+      double t = double(clock()-t0)/CLOCKS_PER_SEC/nrep;
+      cout << setw(14) << fnames[f] << setw(16) << sortings[s] << setw(14) << fcn.getAlgorithmSize() 
+           << setw(12) << fcn.getStat("work_size") << setw(16) << fcn.getStat("work_cache_misses") << setw(16) << t << endl;
+    }
+  }
+  
+  return 0;
+}
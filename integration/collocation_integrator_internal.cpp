@@ -59,6 +59,8 @@ namespace CasADi{
 
     // All collocation time points
     std::vector<long double> tau_root = collocationPointsL(deg_,getOption("collocation_scheme"));
+    tau_root_.resize(tau_root.size());
+    copy(tau_root.begin(),tau_root.end(),tau_root_.begin());
 
     // Coefficients of the collocation equation
     vector<vector<double> > C(deg_+1,vector<double>(deg_+1,0));
@@ -280,6 +282,32 @@ namespace CasADi{
     casadi_assert(Z_it==Z_.end());
   }
 
+  void CollocationIntegratorInternal::interpolateStep(double tau, DMatrix& x, DMatrix& q){
+    if(nz_==0){
+      // Hermite interpolation of the quadratures (and of the states, overwritten below)
+      FixedStepIntegratorInternal::interpolateStep(tau,x,q);
+    } else {
+      // Linear interpolation of the quadratures
+      for(int i=0; i<q.size(); ++i){
+        q.at(i) = (1-tau)*q_prev_.at(i) + tau*q_step_.at(i);
+      }
+    }
+
+    // Evaluate the collocation polynomial, the collocated states of the last step are in Z_
+    for(int i=0; i<x.size(); ++i) x.at(i) = 0;
+    for(int j=0; j<deg_+1; ++j){
+      // Lagrange polynomial of collocation point j
+      double l_j = 1;
+      for(int r=0; r<deg_+1; ++r){
+        if(r!=j) l_j *= (tau-tau_root_[r])/(tau_root_[j]-tau_root_[r]);
+      }
+
+      // Add contribution
+      const double* x_j = j==0 ? x_prev_.ptr() : Z_.ptr() + (j-1)*(nx_+nz_);
+      for(int i=0; i<x.size(); ++i) x.at(i) += l_j*x_j[i];
+    }
+  }
+
   void CollocationIntegratorInternal::calculateInitialConditionsB(){
     vector<double>::const_iterator rx0_it = input(INTEGRATOR_RX0).begin();
     vector<double>::const_iterator rz_it = input(INTEGRATOR_RZ0).begin();
@@ -65,8 +65,17 @@ namespace CasADi{
     /// Get initial guess for the algebraic variable (backward problem)
     virtual void calculateInitialConditionsB();
 
+    /** \brief Interpolate the differential states and quadratures within the last step taken
+     * The states are given by the collocation polynomial. The quadratures are interpolated with
+     * cubic Hermite polynomials for ODEs and linearly for DAEs.
+     */
+    virtual void interpolateStep(double tau, DMatrix& x, DMatrix& q);
+
     // Interpolation order
     int deg_;
+
+    // Collocation time points
+    std::vector<double> tau_root_;
   };
 
 } // namespace CasADi
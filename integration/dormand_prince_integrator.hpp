@@ -0,0 +1,81 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef DORMAND_PRINCE_INTEGRATOR_HPP
+#define DORMAND_PRINCE_INTEGRATOR_HPP
+
+#include "symbolic/function/integrator.hpp"
+
+namespace CasADi{
+  
+  class DormandPrinceIntegratorInternal;
+  
+  /** \brief Adaptive step explicit Runge-Kutta integrator for ODEs
+      Implements the embedded Dormand-Prince 5(4) pair with error control on the
+      differential states and quadratures and a fourth order continuous extension
+      for dense output.
+
+      The accepted steps of the forward integration are taped, the backward problem
+      is integrated with the same steps, evaluating the forward states using the
+      continuous extension.
+  
+      \author Joel Andersson
+      \date 2014
+  */
+  class DormandPrinceIntegrator : public Integrator {
+  public:
+    /** \brief  Default constructor */
+    DormandPrinceIntegrator();
+    
+    /** \brief  Create an integrator for explicit ODEs
+     *   \param f dynamical system
+     * \copydoc scheme_DAEInput
+     * \copydoc scheme_DAEOutput
+     *   \param g backwards system
+     * \copydoc scheme_RDAEInput
+     * \copydoc scheme_RDAEOutput
+     */
+    explicit DormandPrinceIntegrator(const Function& f, const Function& g=Function());
+
+    //@{
+    /// Access functions of the node
+    DormandPrinceIntegratorInternal* operator->();
+    const DormandPrinceIntegratorInternal* operator->() const;
+    //@}
+
+    /// Check if the node is pointing to the right type of object
+    virtual bool checkNode() const;
+
+    /// Static creator function
+#ifdef SWIG
+    %callback("%s_cb");
+#endif
+    static Integrator creator(const Function& f, const Function& g){ return DormandPrinceIntegrator(f,g);}
+#ifdef SWIG
+    %nocallback;
+#endif
+
+  };
+
+} // namespace CasADi
+
+#endif //DORMAND_PRINCE_INTEGRATOR_HPP
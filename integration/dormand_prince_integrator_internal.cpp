@@ -0,0 +1,388 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include "dormand_prince_integrator_internal.hpp"
+#include "symbolic/std_vector_tools.hpp"
+#include <cmath>
+#include <limits>
+
+using namespace std;
+namespace CasADi{
+
+  const double DormandPrinceIntegratorInternal::c_[7] = {0, 1.0/5, 3.0/10, 4.0/5, 8.0/9, 1, 1};
+
+  const double DormandPrinceIntegratorInternal::a_[7][6] = {
+    {0},
+    {1.0/5},
+    {3.0/40, 9.0/40},
+    {44.0/45, -56.0/15, 32.0/9},
+    {19372.0/6561, -25360.0/2187, 64448.0/6561, -212.0/729},
+    {9017.0/3168, -355.0/33, 46732.0/5247, 49.0/176, -5103.0/18656},
+    {35.0/384, 0, 500.0/1113, 125.0/192, -2187.0/6784, 11.0/84}};
+
+  const double DormandPrinceIntegratorInternal::e_[7] = {71.0/57600, 0, -71.0/16695, 71.0/1920, -17253.0/339200, 22.0/525, -1.0/40};
+
+  const double DormandPrinceIntegratorInternal::d_[7] = {-12715105075.0/11282082432.0, 0, 87487479700.0/32700410799.0, -10690763975.0/1880347072.0,
+                                                         701980252875.0/199316789632.0, -1453857185.0/822651844.0, 69997945.0/29380423.0};
+
+  DormandPrinceIntegratorInternal::DormandPrinceIntegratorInternal(const Function& f, const Function& g) : IntegratorInternal(f,g){
+    addOption("max_num_steps",               OT_INTEGER,          10000,          "Maximum number of integrator steps, accepted and rejected, over the whole time horizon since the last reset");
+    addOption("reltol",                      OT_REAL,             1e-6,           "Relative tolerence for the IVP solution");
+    addOption("abstol",                      OT_REAL,             1e-8,           "Absolute tolerence  for the IVP solution");
+    addOption("initial_step_size",           OT_REAL,             GenericType(),  "Size of the first step [default: estimated from the right hand side]");
+    addOption("min_step_size",               OT_REAL,             0.0,            "Minimum step size, not enforced for the last step, which is shortened to end at the final time");
+    addOption("max_step_size",               OT_REAL,             0.0,            "Maximum step size, 0 for no limit");
+    addOption("safety_factor",               OT_REAL,             0.9,            "Safety factor in the step size selection");
+    addOption("quad_err_con",                OT_BOOLEAN,          false,          "Should the quadratures affect the step size control");
+    addOption("fsens_err_con",               OT_BOOLEAN,          false,          "Include the forward sensitivities in the error control. If false, the sensitivities are integrated using the steps of the nondifferentiated problem");
+    nx_err_ = nq_err_ = -1;
+  }
+
+  DormandPrinceIntegratorInternal::~DormandPrinceIntegratorInternal(){
+  }
+
+  void DormandPrinceIntegratorInternal::init(){
+    // Call the base class init
+    IntegratorInternal::init();
+
+    // Algebraic variables not supported
+    casadi_assert_message(nz_==0 && nrz_==0, "DormandPrinceIntegrator: explicit Runge-Kutta integrators do not support algebraic variables");
+
+    // Read options
+    max_num_steps_ = getOption("max_num_steps");
+    reltol_ = getOption("reltol");
+    abstol_ = getOption("abstol");
+    min_step_size_ = getOption("min_step_size");
+    max_step_size_ = getOption("max_step_size");
+    if(max_step_size_<=0) max_step_size_ = numeric_limits<double>::infinity();
+    safety_ = getOption("safety_factor");
+    casadi_assert_message(abstol_>0 || reltol_>0, "DormandPrinceIntegrator: abstol or reltol must be positive");
+
+    // Components subject to error control, unless restricted by setDerivativeOptions
+    if(nx_err_<0) nx_err_ = nx_;
+    if(nq_err_<0) nq_err_ = getOption("quad_err_con").toInt() ? nq_ : 0;
+
+    // Allocate work vectors
+    int ny = nx_+nq_;
+    y_.resize(ny);
+    y_new_.resize(ny);
+    w_.resize(ny);
+    k_.resize(7,vector<double>(ny));
+    cont_.resize(5*ny);
+    if(nrx_>0){
+      int nry = nrx_+nrq_;
+      rw_.resize(nry);
+      rk_.resize(6,vector<double>(nry));
+      x_stage_.resize(nx_);
+    }
+  }
+
+  void DormandPrinceIntegratorInternal::setDerivativeOptions(Integrator& integrator, const AugOffset& offset){
+    // Copy all options
+    IntegratorInternal::setDerivativeOptions(integrator,offset);
+
+    // Use the steps of the nondifferentiated problem: the first nx_ and nq_ components of the augmented problem
+    if(!getOption("fsens_err_con").toInt()){
+      DormandPrinceIntegratorInternal* node = static_cast<DormandPrinceIntegratorInternal*>(integrator.get());
+      node->nx_err_ = nx_;
+      node->nq_err_ = nq_err_;
+    }
+  }
+
+  void DormandPrinceIntegratorInternal::evaluateF(double t, const double* y, double* ydot){
+    f_.input(DAE_T).set(t);
+    f_.input(DAE_X).setArray(y,nx_);
+    f_.input(DAE_P).set(p());
+    f_.evaluate();
+    f_.output(DAE_ODE).getArray(ydot,nx_);
+    f_.output(DAE_QUAD).getArray(ydot+nx_,nq_);
+    nfevals_++;
+  }
+
+  void DormandPrinceIntegratorInternal::evaluateG(double t, const double* x, const double* ry, double* rydot){
+    g_.input(RDAE_T).set(t);
+    g_.input(RDAE_X).setArray(x,nx_);
+    g_.input(RDAE_P).set(p());
+    g_.input(RDAE_RX).setArray(ry,nrx_);
+    g_.input(RDAE_RP).set(rp());
+    g_.evaluate();
+    g_.output(RDAE_ODE).getArray(rydot,nrx_);
+    g_.output(RDAE_QUAD).getArray(rydot+nrx_,nrq_);
+    ngevals_++;
+  }
+
+  double DormandPrinceIntegratorInternal::errorNorm(const vector<double>& v, const vector<double>& y0, const vector<double>& y1) const{
+    double ret = 0;
+    int n = 0;
+    for(int j=0; j<2; ++j){
+      // Differential states, then quadratures
+      int offset = j==0 ? 0 : nx_;
+      int nerr = j==0 ? nx_err_ : nq_err_;
+      for(int i=offset; i<offset+nerr; ++i){
+        double sk = abstol_ + reltol_*std::max(fabs(y0[i]),fabs(y1[i]));
+        ret += (v[i]/sk)*(v[i]/sk);
+      }
+      n += nerr;
+    }
+    return n==0 ? 0 : sqrt(ret/n);
+  }
+
+  double DormandPrinceIntegratorInternal::initialStepSize(){
+    // Nothing to control: take the whole interval
+    if(nx_err_+nq_err_==0) return std::min(tf_-t0_,max_step_size_);
+
+    // Norms of the state and its derivative
+    double dny = errorNorm(y_,y_,y_);
+    double dnf = errorNorm(k_[0],y_,y_);
+    double h = dny<=1e-5 || dnf<=1e-5 ? 1e-6 : 0.01*dny/dnf;
+    h = std::min(h,max_step_size_);
+
+    // Explicit Euler step to estimate the second derivative
+    for(int i=0; i<y_.size(); ++i) w_[i] = y_[i] + h*k_[0][i];
+    evaluateF(t_+h,getPtr(w_),getPtr(k_[1]));
+    for(int i=0; i<y_.size(); ++i) w_[i] = k_[1][i] - k_[0][i];
+    double der2 = errorNorm(w_,y_,y_)/h;
+
+    // Step size such that h^5*max(|f'|,|f''|) = 0.01
+    double der12 = std::max(der2,dnf);
+    double h1 = der12<=1e-15 ? std::max(1e-6,h*1e-3) : pow(0.01/der12,0.2);
+    return std::min(std::min(100*h,h1),max_step_size_);
+  }
+
+  void DormandPrinceIntegratorInternal::continuousExtension(const double* cont, int n, double theta, double* y){
+    double theta1 = 1-theta;
+    for(int i=0; i<n; ++i){
+      y[i] = cont[i] + theta*(cont[n+i] + theta1*(cont[2*n+i] + theta*(cont[3*n+i] + theta1*cont[4*n+i])));
+    }
+  }
+
+  void DormandPrinceIntegratorInternal::reset(){
+    // Reset the base classes
+    IntegratorInternal::reset();
+
+    // Initial state, quadratures zero
+    x0().getArray(getPtr(y_),nx_);
+    fill(y_.begin()+nx_,y_.end(),0.0);
+
+    // Reset step size, the same sequence of steps is taken for the same inputs
+    h_ = hasSetOption("initial_step_size") ? double(getOption("initial_step_size")) : 0;
+    fsal_ = false;
+
+    // Clear the tape
+    if(nrx_>0){
+      t_tape_.clear();
+      cont_tape_.clear();
+      t_tape_.push_back(t0_);
+    }
+
+    // Reset counters
+    nsteps_ = nrejected_ = nfevals_ = nstepsB_ = ngevals_ = 0;
+  }
+
+  void DormandPrinceIntegratorInternal::integrate(double t_out){
+    int ny = y_.size();
+
+    // Was the last step attempt rejected
+    bool rejected = false;
+
+    // Take steps until the output time is inside the last step
+    while(t_<t_out){
+      casadi_assert_message(nsteps_+nrejected_<max_num_steps_, "DormandPrinceIntegrator::integrate(" << t_out << "): maximum number of steps (" << max_num_steps_ << ") reached at t = " << t_);
+
+      // First stage, shared with the last stage of the previous step
+      if(!fsal_){
+        evaluateF(t_,getPtr(y_),getPtr(k_[0]));
+        fsal_ = true;
+      }
+
+      // Step size, do not step beyond the end of the time horizon
+      if(h_<=0) h_ = initialStepSize();
+      double h = std::min(h_,max_step_size_);
+      bool last = t_ + 1.01*h >= tf_;
+      if(last) h = tf_ - t_;
+      casadi_assert_message((last || h>=min_step_size_) && t_+h>t_, "DormandPrinceIntegrator::integrate(" << t_out << "): step size " << h << " too small at t = " << t_);
+
+      // Stages, the argument of the last stage is the fifth order solution
+      for(int s=1; s<7; ++s){
+        vector<double>& w = s==6 ? y_new_ : w_;
+        for(int i=0; i<ny; ++i){
+          double d = 0;
+          for(int j=0; j<s; ++j) d += a_[s][j]*k_[j][i];
+          w[i] = y_[i] + h*d;
+        }
+        evaluateF(t_+c_[s]*h,getPtr(w),getPtr(k_[s]));
+      }
+
+      // Error estimate
+      for(int i=0; i<ny; ++i){
+        double d = 0;
+        for(int j=0; j<7; ++j) d += e_[j]*k_[j][i];
+        w_[i] = h*d;
+      }
+      double err = errorNorm(w_,y_,y_new_);
+
+      // New step size
+      double fac11 = pow(err,0.2);
+      if(err<=1){
+        // Allow the step to grow at most by a factor 10, but not directly after a rejection
+        double fac = std::max(0.1,std::min(5.0,fac11/safety_));
+        h_ = h/fac;
+        if(rejected) h_ = std::min(h_,h);
+        rejected = false;
+      } else {
+        // Reject step
+        h_ = h/std::min(5.0,fac11/safety_);
+        rejected = true;
+        nrejected_++;
+        continue;
+      }
+
+      // Continuous extension of the accepted step
+      for(int i=0; i<ny; ++i){
+        double ydiff = y_new_[i] - y_[i];
+        double bspl = h*k_[0][i] - ydiff;
+        double d = 0;
+        for(int j=0; j<7; ++j) d += d_[j]*k_[j][i];
+        cont_[i] = y_[i];
+        cont_[ny+i] = ydiff;
+        cont_[2*ny+i] = bspl;
+        cont_[3*ny+i] = ydiff - h*k_[6][i] - bspl;
+        cont_[4*ny+i] = h*d;
+      }
+
+      // Advance time
+      t_prev_ = t_;
+      h_prev_ = h;
+      t_ = last ? tf_ : t_+h;
+      y_.swap(y_new_);
+      k_[0].swap(k_[6]);
+      nsteps_++;
+
+      // Tape the differential states
+      if(nrx_>0){
+        t_tape_.push_back(t_);
+        cont_tape_.push_back(vector<double>(5*nx_));
+        vector<double>& cont_k = cont_tape_.back();
+        for(int r=0; r<5; ++r) copy(cont_.begin()+r*ny,cont_.begin()+r*ny+nx_,cont_k.begin()+r*nx_);
+      }
+    }
+
+    // Get the solution, interpolate if the output time is inside the last step
+    if(nsteps_>0 && t_out<t_){
+      continuousExtension(getPtr(cont_),ny,(t_out-t_prev_)/h_prev_,getPtr(w_));
+      xf().setArray(getPtr(w_),nx_);
+      qf().setArray(getPtr(w_)+nx_,nq_);
+    } else {
+      xf().setArray(getPtr(y_),nx_);
+      qf().setArray(getPtr(y_)+nx_,nq_);
+    }
+
+    // Save statistics
+    stats_["nsteps"] = 1.0*nsteps_;
+    stats_["nrejected"] = 1.0*nrejected_;
+    stats_["nfevals"] = 1.0*nfevals_;
+  }
+
+  void DormandPrinceIntegratorInternal::interpolate(double t, DMatrix& x){
+    if(nsteps_==0){
+      x.setArray(getPtr(y_),nx_);
+      return;
+    }
+    double theta = (t-t_prev_)/h_prev_;
+    casadi_assert_message(theta>=0 && theta<=1+1e-9, "DormandPrinceIntegrator::interpolate(" << t << "): only times in the last step taken, [" << t_prev_ << ", " << t_ << "], can be interpolated");
+    continuousExtension(getPtr(cont_),y_.size(),theta,getPtr(w_));
+    x.setArray(getPtr(w_),nx_);
+  }
+
+  void DormandPrinceIntegratorInternal::resetB(){
+    // Reset the base classes
+    IntegratorInternal::resetB();
+    casadi_assert_message(t_tape_.back()==tf_, "DormandPrinceIntegrator::resetB: the forward integration must reach the end of the time horizon before integrating backwards");
+
+    // Start with the last step on the tape
+    k_tape_ = cont_tape_.size()-1;
+  }
+
+  void DormandPrinceIntegratorInternal::integrateB(double t_out){
+    int nry = nrx_+nrq_;
+
+    // Stacked backward states and quadratures
+    vector<double> ry(nry);
+    rxf().getArray(getPtr(ry),nrx_);
+    rqf().getArray(getPtr(ry)+nrx_,nrq_);
+
+    // Take the forward steps in reverse order, stopping at the output time
+    while(t_>t_out){
+      // Step on the tape containing the current time
+      while(k_tape_>0 && t_tape_[k_tape_]>=t_) k_tape_--;
+      double t0_step = t_tape_[k_tape_];
+      double h_step = t_tape_[k_tape_+1] - t0_step;
+      const double* cont_k = getPtr(cont_tape_[k_tape_]);
+
+      // Size of the backward step
+      double t1 = std::max(t_out,t0_step);
+      double h = t_ - t1;
+
+      // Stages, the forward states are given by the continuous extension
+      for(int s=0; s<6; ++s){
+        for(int i=0; i<nry; ++i){
+          double d = 0;
+          for(int j=0; j<s; ++j) d += a_[s][j]*rk_[j][i];
+          rw_[i] = ry[i] + h*d;
+        }
+        double ts = t_ - c_[s]*h;
+        continuousExtension(cont_k,nx_,(ts-t0_step)/h_step,getPtr(x_stage_));
+        evaluateG(ts,getPtr(x_stage_),getPtr(rw_),getPtr(rk_[s]));
+      }
+
+      // Fifth order solution
+      for(int i=0; i<nry; ++i){
+        double d = 0;
+        for(int j=0; j<6; ++j) d += a_[6][j]*rk_[j][i];
+        ry[i] += h*d;
+      }
+
+      // Advance time
+      t_ = t1;
+      nstepsB_++;
+    }
+
+    // Save the solution
+    rxf().setArray(getPtr(ry),nrx_);
+    rqf().setArray(getPtr(ry)+nrx_,nrq_);
+
+    // Save statistics
+    stats_["nstepsB"] = 1.0*nstepsB_;
+    stats_["ngevals"] = 1.0*ngevals_;
+  }
+
+  void DormandPrinceIntegratorInternal::printStats(std::ostream &stream) const{
+    stream << "Number of steps taken by DormandPrinceIntegrator: " << nsteps_ << std::endl;
+    stream << "Number of rejected steps: " << nrejected_ << std::endl;
+    stream << "Number of right hand side evaluations: " << nfevals_ << std::endl;
+    if(nrx_>0){
+      stream << "Number of backward steps: " << nstepsB_ << std::endl;
+      stream << "Number of backward right hand side evaluations: " << ngevals_ << std::endl;
+    }
+  }
+
+} // namespace CasADi
@@ -0,0 +1,125 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef DORMAND_PRINCE_INTEGRATOR_INTERNAL_HPP
+#define DORMAND_PRINCE_INTEGRATOR_INTERNAL_HPP
+
+#include "dormand_prince_integrator.hpp"
+#include "symbolic/function/integrator_internal.hpp"
+
+/// \cond INTERNAL
+namespace CasADi{
+    
+  class DormandPrinceIntegratorInternal : public IntegratorInternal{
+  public:
+  
+    /// Constructor
+    explicit DormandPrinceIntegratorInternal(const Function& f, const Function& g);
+
+    /// Clone
+    virtual DormandPrinceIntegratorInternal* clone() const{ return new DormandPrinceIntegratorInternal(*this);}
+
+    /// Create a new integrator
+    virtual DormandPrinceIntegratorInternal* create(const Function& f, const Function& g) const{ return new DormandPrinceIntegratorInternal(f,g);}
+  
+    /// Destructor
+    virtual ~DormandPrinceIntegratorInternal();
+
+    /// Initialize stage
+    virtual void init();
+
+    /// Print solver statistics
+    virtual void printStats(std::ostream &stream) const;
+
+    /// Reset the forward problem and bring the time back to t0
+    virtual void reset();
+
+    /// Reset the backward problem and take time to tf 
+    virtual void resetB();
+
+    ///  Integrate until a specified time point
+    virtual void integrate(double t_out);
+
+    /// Integrate backward in time until a specified time point
+    virtual void integrateB(double t_out);
+
+    /// Interpolate the differential state at a time within the last step taken
+    virtual void interpolate(double t, DMatrix& x);
+
+    /// Restrict the error control of the augmented integrator to the nondifferentiated states
+    virtual void setDerivativeOptions(Integrator& integrator, const AugOffset& offset);
+
+    /// Evaluate the forward right hand side for the stacked differential states and quadratures
+    void evaluateF(double t, const double* y, double* ydot);
+
+    /// Evaluate the backward right hand side for the stacked backward states and quadratures
+    void evaluateG(double t, const double* x, const double* ry, double* rydot);
+
+    /// Estimate a suitable initial step size from the right hand side at the initial time
+    double initialStepSize();
+
+    /// Weighted root mean square norm of the components subject to error control
+    double errorNorm(const std::vector<double>& v, const std::vector<double>& y0, const std::vector<double>& y1) const;
+
+    /// Evaluate the continuous extension of a step with coefficients cont, n components, at normalized time theta
+    static void continuousExtension(const double* cont, int n, double theta, double* y);
+
+    /// Butcher tableau of the Dormand-Prince pair, stage coefficients and error estimate weights
+    static const double c_[7], a_[7][6], e_[7], d_[7];
+
+    /// Options
+    double abstol_, reltol_, safety_, min_step_size_, max_step_size_;
+    int max_num_steps_;
+
+    /// Number of leading differential states and quadratures entering the error estimate
+    int nx_err_, nq_err_;
+
+    /// Stacked differential states and quadratures at the current time and at the end of the trial step
+    std::vector<double> y_, y_new_;
+
+    /// Stages and a work vector (forward and backward problem)
+    std::vector<std::vector<double> > k_, rk_;
+    std::vector<double> w_, rw_, x_stage_;
+
+    /// Proposed next step size, beginning of the last step and its size
+    double h_, t_prev_, h_prev_;
+
+    /// Has the first stage of the next step already been calculated (first same as last)
+    bool fsal_;
+
+    /// Continuous extension of the last step taken
+    std::vector<double> cont_;
+
+    /// Tape: start of the accepted steps (and the end of the last one) and continuous extension of the differential states
+    std::vector<double> t_tape_;
+    std::vector<std::vector<double> > cont_tape_;
+
+    /// Step on the tape for the backward integration
+    int k_tape_;
+
+    /// Counters
+    int nsteps_, nrejected_, nfevals_, nstepsB_, ngevals_;
+  };
+
+} // namespace CasADi
+/// \endcond
+#endif //DORMAND_PRINCE_INTEGRATOR_INTERNAL_HPP
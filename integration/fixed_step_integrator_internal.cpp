@@ -33,6 +33,7 @@ namespace CasADi{
 
   FixedStepIntegratorInternal::FixedStepIntegratorInternal(const Function& f, const Function& g) : IntegratorInternal(f,g){
     addOption("number_of_finite_elements",     OT_INTEGER,  20, "Number of finite elements");
+    addOption("dense_output",                  OT_BOOLEAN,  GenericType(), "Interpolate the solution when integrating to a time between the finite elements instead of stopping at the end of the element [default: false]");
   }
 
   void FixedStepIntegratorInternal::deepCopyMembers(std::map<SharedObjectNode*,SharedObject>& already_copied){    
@@ -67,6 +68,15 @@ namespace CasADi{
       x_tape_.resize(nk_+1,vector<double>(nx_));
       Z_tape_.resize(nk_,vector<double>(nZ_));
     }
+
+    // States at the ends of the step
+    dense_output_ = hasSetOption("dense_output") && getOption("dense_output");
+    x_step_ = x0();
+    q_step_ = qf();
+    if(dense_output_){
+      x_prev_ = xdot_step_ = xdot_prev_ = x_step_;
+      q_prev_ = qdot_step_ = qdot_prev_ = q_step_;
+    }
   }
 
   void FixedStepIntegratorInternal::integrate(double t_out){
@@ -80,19 +90,25 @@ namespace CasADi{
 
     // Take time steps until end time has been reached
     while(k_<k_out){
+      // Save the beginning of the step for interpolation
+      if(dense_output_){
+        x_prev_.set(x_step_);
+        q_prev_.set(q_step_);
+      }
+
       // Take step
       F.input(DAE_T).set(t_);
-      F.input(DAE_X).set(output(INTEGRATOR_XF));
+      F.input(DAE_X).set(x_step_);
       F.input(DAE_Z).set(Z_);
       F.input(DAE_P).set(input(INTEGRATOR_P));
       F.evaluate();
-      F.output(DAE_ODE).get(output(INTEGRATOR_XF));
+      F.output(DAE_ODE).get(x_step_);
       F.output(DAE_ALG).get(Z_);
-      transform(F.output(DAE_QUAD).begin(),F.output(DAE_QUAD).end(),output(INTEGRATOR_QF).begin(),output(INTEGRATOR_QF).begin(),std::plus<double>());
+      transform(F.output(DAE_QUAD).begin(),F.output(DAE_QUAD).end(),q_step_.begin(),q_step_.begin(),std::plus<double>());
 
       // Tape
       if(nrx_>0){
-        output(INTEGRATOR_XF).get(x_tape_.at(k_+1));
+        x_step_.get(x_tape_.at(k_+1));
         Z_.get(Z_tape_.at(k_));
       }
 
@@ -100,6 +116,62 @@ namespace CasADi{
       k_++;
       t_ = t0_ + k_*h_;
     }
+
+    // Interpolate if the end time is inside the last step
+    if(dense_output_ && k_>0 && t_out<t_){
+      double tau = (t_out - (t_-h_))/h_;
+      casadi_assert_message(tau>=0, "FixedStepIntegratorInternal::integrate(" << t_out << "): dense output is only available for times in the last step taken, [" << t_-h_ << ", " << t_ << "]");
+      interpolateStep(tau,xf(),qf());
+    } else {
+      xf().set(x_step_);
+      qf().set(q_step_);
+    }
+  }
+
+  void FixedStepIntegratorInternal::interpolate(double t, DMatrix& x){
+    casadi_assert_message(dense_output_, "FixedStepIntegratorInternal::interpolate: the option \"dense_output\" must be set");
+    double tau = k_==0 ? 0 : (t - (t_-h_))/h_;
+    casadi_assert_message(tau>=0 && tau<=1+1e-9, "FixedStepIntegratorInternal::interpolate(" << t << "): only times in the last step taken, [" << (k_==0 ? t_ : t_-h_) << ", " << t_ << "], can be interpolated");
+    if(k_==0){
+      x.set(x_step_);
+    } else {
+      DMatrix q = q_step_;
+      interpolateStep(tau,x,q);
+    }
+  }
+
+  void FixedStepIntegratorInternal::interpolateStep(double tau, DMatrix& x, DMatrix& q){
+    casadi_assert_message(nz_==0, "FixedStepIntegratorInternal::interpolateStep: Hermite interpolation not available for algebraic variables");
+
+    // Calculate the time derivatives at the ends of the step, once per step
+    if(k_deriv_!=k_){
+      for(int end=0; end<2; ++end){
+        // Reuse the derivatives at the end of the previous step
+        if(end==0 && k_deriv_==k_-1){
+          xdot_prev_.set(xdot_step_);
+          qdot_prev_.set(qdot_step_);
+          continue;
+        }
+        f_.setInput(end==0 ? t_-h_ : t_, DAE_T);
+        f_.setInput(end==0 ? x_prev_ : x_step_, DAE_X);
+        f_.setInput(input(INTEGRATOR_P), DAE_P);
+        f_.evaluate();
+        (end==0 ? xdot_prev_ : xdot_step_).set(f_.output(DAE_ODE));
+        (end==0 ? qdot_prev_ : qdot_step_).set(f_.output(DAE_QUAD));
+      }
+      k_deriv_ = k_;
+    }
+
+    // Cubic Hermite basis functions
+    double tau2 = tau*tau, tau3 = tau2*tau;
+    double h00 = 2*tau3 - 3*tau2 + 1, h10 = h_*(tau3 - 2*tau2 + tau);
+    double h01 = -2*tau3 + 3*tau2, h11 = h_*(tau3 - tau2);
+    for(int i=0; i<x.size(); ++i){
+      x.at(i) = h00*x_prev_.at(i) + h10*xdot_prev_.at(i) + h01*x_step_.at(i) + h11*xdot_step_.at(i);
+    }
+    for(int i=0; i<q.size(); ++i){
+      q.at(i) = h00*q_prev_.at(i) + h10*qdot_prev_.at(i) + h01*q_step_.at(i) + h11*qdot_step_.at(i);
+    }
   }
 
   void FixedStepIntegratorInternal::integrateB(double t_out){
@@ -138,13 +210,16 @@ namespace CasADi{
 
     // Bring discrete time to the beginning
     k_ = 0;
+    k_deriv_ = -1;
+    x_step_.set(x0());
+    q_step_.set(0.0);
 
     // Get consistent initial conditions
     calculateInitialConditions();
 
     // Add the first element in the tape
     if(nrx_>0){
-      output(INTEGRATOR_XF).get(x_tape_.at(0));
+      x_step_.get(x_tape_.at(0));
     }
   }
 
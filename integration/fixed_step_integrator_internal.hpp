@@ -60,6 +60,15 @@ namespace CasADi{
     /// Integrate backward in time until a specified time point
     virtual void integrateB(double t_out);
 
+    /// Interpolate the differential state at a time within the last step taken
+    virtual void interpolate(double t, DMatrix& x);
+
+    /** \brief Interpolate the differential states and quadratures within the last step taken
+     * tau is the normalized time in the step, 0 at the beginning and 1 at the end.
+     * The default is a cubic Hermite interpolation using the state derivatives at the ends of the step.
+     */
+    virtual void interpolateStep(double tau, DMatrix& x, DMatrix& q);
+
     /// Reset the forward problem and bring the time back to t0
     virtual void reset();
 
@@ -98,6 +107,18 @@ namespace CasADi{
 
     // Tape
     std::vector<std::vector<double> > x_tape_, Z_tape_;
+
+    /// Interpolate between the steps when integrating to a time between the steps
+    bool dense_output_;
+
+    /// Differential states and quadratures at the end and at the beginning of the last step
+    DMatrix x_step_, q_step_, x_prev_, q_prev_;
+
+    /// Time derivatives of the states and quadratures at the end and at the beginning of the last step
+    DMatrix xdot_step_, qdot_step_, xdot_prev_, qdot_prev_;
+
+    /// Discrete time for which the time derivatives were calculated, -1 if none
+    int k_deriv_;
   };
 
 } // namespace CasADi
@@ -242,6 +242,8 @@ namespace CasADi{
   void IpoptInternal::evaluate(){
     if (inputs_check_) checkInputs();
     
+    // Initialize with the solution of the previous call, if requested
+    bool warm = warmStart();
     checkInitialBounds();
     
 
@@ -270,6 +272,12 @@ namespace CasADi{
     Ipopt::SmartPtr<Ipopt::TNLP> *userclass = static_cast<Ipopt::SmartPtr<Ipopt::TNLP>*>(userclass_);
     Ipopt::SmartPtr<Ipopt::IpoptApplication> *app = static_cast<Ipopt::SmartPtr<Ipopt::IpoptApplication>*>(app_);
 
+    // Let IPOPT use the multipliers of the previous solution, unless the user decides
+    if(!hasSetOption("warm_start_init_point")){
+      (*app)->Options()->SetStringValue("warm_start_init_point", warm ? "yes" : "no");
+    }
+    stats_["warm_start"] = warm;
+
     double time1 = clock();
     // Ask Ipopt to solve the problem
     Ipopt::ApplicationReturnStatus status = (*app)->OptimizeTNLP(*userclass);
@@ -328,6 +336,9 @@ namespace CasADi{
       cout << "time spent in callback preparation: " << t_callback_prepare_ << " s." << endl;
     }
 
+    // Only a successful solve can be used to warm start the next call
+    has_solution_ = status == Solve_Succeeded || status == Solved_To_Acceptable_Level;
+
     if (status == Solve_Succeeded)
       stats_["return_status"] = "Solve_Succeeded";
     if (status == Solved_To_Acceptable_Level)
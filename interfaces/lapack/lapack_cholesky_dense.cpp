@@ -0,0 +1,99 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include "lapack_cholesky_dense.hpp"
+#include "../../symbolic/std_vector_tools.hpp"
+
+using namespace std;
+namespace CasADi{
+
+  LapackCholeskyDense::LapackCholeskyDense(){
+  }
+
+  LapackCholeskyDense::LapackCholeskyDense(const Sparsity& sparsity, int nrhs){
+    assignNode(new LapackCholeskyDenseInternal(sparsity,nrhs));
+  }
+ 
+  LapackCholeskyDenseInternal* LapackCholeskyDense::operator->(){
+    return static_cast<LapackCholeskyDenseInternal*>(Function::operator->());
+  }
+
+  const LapackCholeskyDenseInternal* LapackCholeskyDense::operator->() const{
+    return static_cast<const LapackCholeskyDenseInternal*>(Function::operator->());
+  }
+
+  LapackCholeskyDenseInternal::LapackCholeskyDenseInternal(const Sparsity& sparsity, int nrhs) : LinearSolverInternal(sparsity,nrhs){
+  }
+
+  LapackCholeskyDenseInternal::~LapackCholeskyDenseInternal(){
+  }
+
+  void LapackCholeskyDenseInternal::init(){
+    // Call the base class initializer
+    LinearSolverInternal::init();
+  
+    // Get dimensions
+    ncol_ = ncol();
+    nrow_ = nrow();
+  
+    // Only square matrices
+    if(ncol_!=nrow_) throw CasadiException("LapackCholeskyDenseInternal::init: the matrix must be square.");
+  
+    // Allocate matrix
+    mat_.resize(ncol_*ncol_);
+  }
+
+  void LapackCholeskyDenseInternal::prepare(){
+    prepared_ = false;
+  
+    // Get the elements of the matrix, dense format
+    input(0).get(mat_,DENSE);
+  
+    // Factorize the matrix
+    int info = -100;
+    char uplo = 'L';
+    dpotrf_(&uplo, &ncol_, getPtr(mat_), &ncol_, &info);
+    if(info != 0) throw CasadiException("LapackCholeskyDenseInternal::prepare: dpotrf_ failed to factorize the matrix, it is not positive definite");
+
+    // Success if reached this point
+    prepared_ = true;
+  }
+    
+  void LapackCholeskyDenseInternal::solve(double* x, int nrhs, bool transpose){
+    // Solve the system of equations, the matrix is symmetric
+    int info = 100;
+    char uplo = 'L';
+    dpotrs_(&uplo, &ncol_, &nrhs, getPtr(mat_), &ncol_, x, &ncol_, &info);
+    if(info != 0) throw CasadiException("LapackCholeskyDenseInternal::solve: dpotrs_ failed to solve the linear system");
+  }
+
+  void LapackCholeskyDenseInternal::inertia(int& n_pos, int& n_neg, int& n_zero) const{
+    // The factorization only succeeds for positive definite matrices
+    n_pos = ncol_;
+    n_neg = n_zero = 0;
+  }
+
+  LapackCholeskyDenseInternal* LapackCholeskyDenseInternal::clone() const{
+    return new LapackCholeskyDenseInternal(*this);
+  }
+
+} // namespace CasADi
@@ -0,0 +1,132 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef LAPACK_CHOLESKY_DENSE_HPP
+#define LAPACK_CHOLESKY_DENSE_HPP
+
+#include "symbolic/function/linear_solver_internal.hpp"
+
+namespace CasADi{
+  
+  /** \brief  Forward declaration of internal class
+
+      @copydoc LinearSolver_doc
+  */
+  class LapackCholeskyDenseInternal;
+
+  /** \brief  Cholesky LinearSolver with Lapack Interface
+   * @copydoc LinearSolver_doc
+   *
+   * This class solves the linear system A.x=b for a symmetric positive definite A by making a Cholesky factorization of A: \n
+   * A = L.L^T, with L lower triangular
+   * 
+   * Only the lower triangular part of A is used. The factorization takes half the operations of an LU factorization,
+   * and it fails if A is not positive definite.
+   * Since A is symmetric, the transposed system is the same as the nontransposed one.
+   * 
+   * LapackCholeskyDense is an CasADi::Function mapping from 2 inputs [ A (matrix),b (vector)] to one output [x (vector)].
+   *
+   * The usual procedure to use LapackCholeskyDense is: \n
+   *  -# init()
+   *  -# set the first input (A)
+   *  -# prepare()
+   *  -# set the second input (b)
+   *  -# solve()
+   *  -# Repeat steps 4 and 5 to work with other b vectors.
+   *
+   * The method evaluate() combines the prepare() and solve() step and is therefore more expensive if A is invariant.
+   *
+   */
+  class LapackCholeskyDense : public LinearSolver{
+  public:
+
+    /// Default (empty) constructor
+    LapackCholeskyDense();
+  
+    /// Create a linear solver given a sparsity pattern
+    explicit LapackCholeskyDense(const Sparsity& sparsity, int nrhs=1);
+    
+    /// Access functions of the node
+    LapackCholeskyDenseInternal* operator->();
+    const LapackCholeskyDenseInternal* operator->() const;
+  
+    /// Static creator function
+#ifdef SWIG
+    %callback("%s_cb");
+#endif
+    static LinearSolver creator(const Sparsity& sp, int nrhs){ return LapackCholeskyDense(sp,nrhs);}
+#ifdef SWIG
+    %nocallback;
+#endif
+
+  };
+
+/// \cond INTERNAL
+#ifndef SWIG
+
+  /// Cholesky-factorize dense matrix (lapack)
+  extern "C" void dpotrf_(char *uplo, int *n, double *a, int *lda, int *info);
+
+  /// Solve a system of equation using a Cholesky-factorized matrix (lapack)
+  extern "C" void dpotrs_(char *uplo, int *n, int *nrhs, double *a, int *lda, double *b, int *ldb, int *info);
+
+  /// Internal class
+  class LapackCholeskyDenseInternal : public LinearSolverInternal{
+  public:
+    // Create a linear solver given a sparsity pattern and a number of right hand sides
+    LapackCholeskyDenseInternal(const Sparsity& sparsity, int nrhs);
+
+    // Clone
+    virtual LapackCholeskyDenseInternal* clone() const;
+    
+    // Destructor
+    virtual ~LapackCholeskyDenseInternal();
+    
+    // Initialize the solver
+    virtual void init();
+
+    // Prepare the solution of the linear system
+    virtual void prepare();
+    
+    // Solve the system of equations
+    virtual void solve(double* x, int nrhs, bool transpose);
+
+    // Inertia of the factorized matrix
+    virtual void inertia(int& n_pos, int& n_neg, int& n_zero) const;
+
+  protected:
+
+    // Matrix
+    std::vector<double> mat_;
+    
+    // Dimensions
+    int ncol_, nrow_;
+    
+  };
+
+#endif // SWIG
+/// \endcond
+
+} // namespace CasADi
+
+
+#endif //LAPACK_CHOLESKY_DENSE_HPP
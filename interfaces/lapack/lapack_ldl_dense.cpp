@@ -0,0 +1,154 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include "lapack_ldl_dense.hpp"
+#include "../../symbolic/std_vector_tools.hpp"
+
+using namespace std;
+namespace CasADi{
+
+  LapackLDLDense::LapackLDLDense(){
+  }
+
+  LapackLDLDense::LapackLDLDense(const Sparsity& sparsity, int nrhs){
+    assignNode(new LapackLDLDenseInternal(sparsity,nrhs));
+  }
+ 
+  LapackLDLDenseInternal* LapackLDLDense::operator->(){
+    return static_cast<LapackLDLDenseInternal*>(Function::operator->());
+  }
+
+  const LapackLDLDenseInternal* LapackLDLDense::operator->() const{
+    return static_cast<const LapackLDLDenseInternal*>(Function::operator->());
+  }
+
+  LapackLDLDenseInternal::LapackLDLDenseInternal(const Sparsity& sparsity, int nrhs) : LinearSolverInternal(sparsity,nrhs){
+  }
+
+  LapackLDLDenseInternal::~LapackLDLDenseInternal(){
+  }
+
+  void LapackLDLDenseInternal::init(){
+    // Call the base class initializer
+    LinearSolverInternal::init();
+  
+    // Get dimensions
+    ncol_ = ncol();
+    nrow_ = nrow();
+  
+    // Only square matrices
+    if(ncol_!=nrow_) throw CasadiException("LapackLDLDenseInternal::init: the matrix must be square.");
+  
+    // Allocate matrix
+    mat_.resize(ncol_*ncol_);
+    ipiv_.resize(ncol_);
+    singular_ = false;
+
+    // Query the optimal size of the work array
+    work_.resize(1);
+    if(ncol_>0){
+      int info = -100;
+      int lwork = -1;
+      char uplo = 'L';
+      dsytrf_(&uplo, &ncol_, getPtr(mat_), &ncol_, getPtr(ipiv_), getPtr(work_), &lwork, &info);
+      if(info != 0) throw CasadiException("LapackLDLDenseInternal::init: dsytrf_ workspace query failed");
+      work_.resize(max(1,int(work_[0])));
+    }
+  }
+
+  void LapackLDLDenseInternal::prepare(){
+    prepared_ = false;
+  
+    // Get the elements of the matrix, dense format
+    input(0).get(mat_,DENSE);
+  
+    // Factorize the matrix
+    int info = -100;
+    int lwork = work_.size();
+    char uplo = 'L';
+    dsytrf_(&uplo, &ncol_, getPtr(mat_), &ncol_, getPtr(ipiv_), getPtr(work_), &lwork, &info);
+    if(info < 0) throw CasadiException("LapackLDLDenseInternal::prepare: dsytrf_ failed to factorize the matrix");
+
+    // A positive info means that D has an exactly zero pivot: the factorization is complete and is kept for the inertia
+    singular_ = info > 0;
+
+    // Success if reached this point
+    prepared_ = true;
+  }
+    
+  void LapackLDLDenseInternal::solve(double* x, int nrhs, bool transpose){
+    if(singular_) throw CasadiException("LapackLDLDenseInternal::solve: the matrix is singular");
+
+    // Solve the system of equations, the matrix is symmetric
+    int info = 100;
+    char uplo = 'L';
+    dsytrs_(&uplo, &ncol_, &nrhs, getPtr(mat_), &ncol_, getPtr(ipiv_), x, &ncol_, &info);
+    if(info != 0) throw CasadiException("LapackLDLDenseInternal::solve: dsytrs_ failed to solve the linear system");
+  }
+
+  void LapackLDLDenseInternal::inertia(int& n_pos, int& n_neg, int& n_zero) const{
+    // By Sylvester's law of inertia, the inertia of A is the inertia of D
+    n_pos = n_neg = n_zero = 0;
+    for(int k=0; k<ncol_; ++k){
+      double a = mat_[k+k*ncol_];
+      if(ipiv_[k]>0){
+        // 1-by-1 block
+        if(a>0){
+          n_pos++;
+        } else if(a<0){
+          n_neg++;
+        } else {
+          n_zero++;
+        }
+      } else {
+        // 2-by-2 block [a b; b c], the eigenvalues have the signs of the determinant and the trace
+        double b = mat_[k+1+k*ncol_], c = mat_[k+1+(k+1)*ncol_];
+        double det = a*c - b*b;
+        if(det<0){
+          n_pos++;
+          n_neg++;
+        } else if(det>0){
+          if(a+c>0){
+            n_pos += 2;
+          } else {
+            n_neg += 2;
+          }
+        } else {
+          n_zero++;
+          if(a+c>0){
+            n_pos++;
+          } else if(a+c<0){
+            n_neg++;
+          } else {
+            n_zero++;
+          }
+        }
+        k++;
+      }
+    }
+  }
+
+  LapackLDLDenseInternal* LapackLDLDenseInternal::clone() const{
+    return new LapackLDLDenseInternal(*this);
+  }
+
+} // namespace CasADi
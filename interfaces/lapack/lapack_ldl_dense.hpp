@@ -0,0 +1,142 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef LAPACK_LDL_DENSE_HPP
+#define LAPACK_LDL_DENSE_HPP
+
+#include "symbolic/function/linear_solver_internal.hpp"
+
+namespace CasADi{
+  
+  /** \brief  Forward declaration of internal class
+
+      @copydoc LinearSolver_doc
+  */
+  class LapackLDLDenseInternal;
+
+  /** \brief  LDL LinearSolver with Lapack Interface
+   * @copydoc LinearSolver_doc
+   *
+   * This class solves the linear system A.x=b for a symmetric, possibly indefinite A by making an LDL^T factorization of A: \n
+   * P.A.P^T = L.D.L^T, with P a permutation, L unit lower triangular and D block diagonal with 1x1 and 2x2 blocks
+   * (Bunch-Kaufman pivoting)
+   * 
+   * Only the lower triangular part of A is used. The factorization takes half the operations of an LU factorization.
+   * Since A is symmetric, the transposed system is the same as the nontransposed one.
+   * The inertia of A is available after the factorization with getInertia.
+   * 
+   * LapackLDLDense is an CasADi::Function mapping from 2 inputs [ A (matrix),b (vector)] to one output [x (vector)].
+   *
+   * The usual procedure to use LapackLDLDense is: \n
+   *  -# init()
+   *  -# set the first input (A)
+   *  -# prepare()
+   *  -# set the second input (b)
+   *  -# solve()
+   *  -# Repeat steps 4 and 5 to work with other b vectors.
+   *
+   * The method evaluate() combines the prepare() and solve() step and is therefore more expensive if A is invariant.
+   *
+   */
+  class LapackLDLDense : public LinearSolver{
+  public:
+
+    /// Default (empty) constructor
+    LapackLDLDense();
+  
+    /// Create a linear solver given a sparsity pattern
+    explicit LapackLDLDense(const Sparsity& sparsity, int nrhs=1);
+    
+    /// Access functions of the node
+    LapackLDLDenseInternal* operator->();
+    const LapackLDLDenseInternal* operator->() const;
+  
+    /// Static creator function
+#ifdef SWIG
+    %callback("%s_cb");
+#endif
+    static LinearSolver creator(const Sparsity& sp, int nrhs){ return LapackLDLDense(sp,nrhs);}
+#ifdef SWIG
+    %nocallback;
+#endif
+
+  };
+
+/// \cond INTERNAL
+#ifndef SWIG
+
+  /// LDL-factorize dense symmetric matrix (lapack)
+  extern "C" void dsytrf_(char *uplo, int *n, double *a, int *lda, int *ipiv, double *work, int *lwork, int *info);
+
+  /// Solve a system of equation using an LDL-factorized matrix (lapack)
+  extern "C" void dsytrs_(char *uplo, int *n, int *nrhs, double *a, int *lda, int *ipiv, double *b, int *ldb, int *info);
+
+  /// Internal class
+  class LapackLDLDenseInternal : public LinearSolverInternal{
+  public:
+    // Create a linear solver given a sparsity pattern and a number of right hand sides
+    LapackLDLDenseInternal(const Sparsity& sparsity, int nrhs);
+
+    // Clone
+    virtual LapackLDLDenseInternal* clone() const;
+    
+    // Destructor
+    virtual ~LapackLDLDenseInternal();
+    
+    // Initialize the solver
+    virtual void init();
+
+    // Prepare the solution of the linear system
+    virtual void prepare();
+    
+    // Solve the system of equations
+    virtual void solve(double* x, int nrhs, bool transpose);
+
+    // Inertia of the factorized matrix
+    virtual void inertia(int& n_pos, int& n_neg, int& n_zero) const;
+
+  protected:
+
+    // Matrix
+    std::vector<double> mat_;
+    
+    // Pivoting elements
+    std::vector<int> ipiv_;
+
+    // Work array of the factorization
+    std::vector<double> work_;
+    
+    // Dimensions
+    int ncol_, nrow_;
+
+    // Exactly zero pivot encountered in the factorization: the inertia is available, but not the solution
+    bool singular_;
+    
+  };
+
+#endif // SWIG
+/// \endcond
+
+} // namespace CasADi
+
+
+#endif //LAPACK_LDL_DENSE_HPP
@@ -35,6 +35,10 @@
 
 #include <numeric>
 
+/// \cond INTERNAL
+extern "C" void dgemm_(char* transa, char* transb, int* m, int* n, int* k, double* alpha, const double* a, int* lda, const double* b, int* ldb, double* beta, double* c, int* ldc);
+/// \endcond
+
 INPUTSCHEME(DPLEInput)
 OUTPUTSCHEME(DPLEOutput)
 
@@ -51,6 +55,8 @@ namespace CasADi{
     
     addOption("linear_solver",            OT_LINEARSOLVER, GenericType(), "User-defined linear solver class. Needed for sensitivities.");
     addOption("linear_solver_options",    OT_DICTIONARY,   GenericType(), "Options to be passed to the linear solver.");
+    addOption("use_blas",                 OT_BOOLEAN,      false,         "Use the system BLAS (dgemm) for the dense products instead of the built-in blocked kernels.");
+    addOption("parallelization",          OT_STRING,       "serial",      "Evaluate the independent products of the different periods in parallel","serial|openmp");
     
   }
 
@@ -67,6 +73,15 @@ namespace CasADi{
     
     n_ = A_[0].size1();
     
+    use_blas_ = getOption("use_blas");
+    omp_ = getOption("parallelization")=="openmp";
+#ifndef WITH_OPENMP
+    if (omp_) {
+      casadi_warning("OpenMP parallelization is not available, switching to serial mode. Recompile CasADi setting the option WITH_OPENMP to ON.");
+      omp_ = false;
+    }
+#endif // WITH_OPENMP
+    
     // Allocate data structures
     VZ_.resize(n_*n_*K_);
     T_.resize(n_*n_*K_);
@@ -164,40 +179,120 @@ namespace CasADi{
     return k*n_*n_+(partition_[i]+r)*n_ + partition_[j]+c;
   }
 
-  //  A : n-by-l   B: m-by-l
-  //  C = A*B'
-  void dense_mul_nt(int n, int m, int l, const double *A, const double *B, double *C) {
-    for (int i=0;i<n;++i) {
-      for (int j=0;j<m;++j) {
-        for (int k=0;k<l;++k) {
-          C[n*i + j] += A[n*i + k]*B[m*j + k];
+  namespace {
+    /// Block size of the dense kernels: a block of B (block_size rows) stays in cache
+    const int block_size = 64;
+    
+    //  A : n-by-l   B: m-by-l
+    //  C = A*B'
+    void blocked_mul_nt(int n, int m, int l, const double *A, const double *B, double *C) {
+      for (int kk=0;kk<l;kk+=block_size) {
+        int kend = std::min(kk+block_size,l);
+        for (int i=0;i<n;++i) {
+          const double* Ai = A + l*i;
+          double* Ci = C + m*i;
+          // Four dot products at a time for instruction level parallelism
+          int j=0;
+          for (;j+4<=m;j+=4) {
+            const double* B0 = B + l*j;
+            const double* B1 = B0 + l;
+            const double* B2 = B1 + l;
+            const double* B3 = B2 + l;
+            double s0=0, s1=0, s2=0, s3=0;
+            for (int k=kk;k<kend;++k) {
+              double a = Ai[k];
+              s0 += a*B0[k];
+              s1 += a*B1[k];
+              s2 += a*B2[k];
+              s3 += a*B3[k];
+            }
+            Ci[j] += s0;
+            Ci[j+1] += s1;
+            Ci[j+2] += s2;
+            Ci[j+3] += s3;
+          }
+          for (;j<m;++j) {
+            const double* Bj = B + l*j;
+            double s = 0;
+            for (int k=kk;k<kend;++k) s += Ai[k]*Bj[k];
+            Ci[j] += s;
+          }
         }
       }
     }
-  }
   
-  //  A : n-by-l   B: l-by-m
-  //  C = A*B
-  void dense_mul_nn(int n, int m, int l, const double *A, const double *B, double *C) {
-    for (int i=0;i<n;++i) {
-      for (int j=0;j<m;++j) {
-        for (int k=0;k<l;++k) {
-          C[n*i + j] += A[n*i + k]*B[l*k + j];
+    //  A : n-by-l   B: l-by-m
+    //  C = A*B
+    void blocked_mul_nn(int n, int m, int l, const double *A, const double *B, double *C) {
+      for (int kk=0;kk<l;kk+=block_size) {
+        int kend = std::min(kk+block_size,l);
+        for (int jj=0;jj<m;jj+=block_size) {
+          int jend = std::min(jj+block_size,m);
+          for (int i=0;i<n;++i) {
+            double* Ci = C + m*i;
+            for (int k=kk;k<kend;++k) {
+              double a = A[l*i + k];
+              if (a==0) continue;
+              const double* Bk = B + m*k;
+              // Unit stride, vectorizable
+              for (int j=jj;j<jend;++j) Ci[j] += a*Bk[j];
+            }
+          }
         }
       }
     }
-  }
   
-  //  A : l-by-n   B: l-by-m
-  //  C = A'*B
-  void dense_mul_tn(int n, int m, int l, const double *A, const double *B, double *C) {
-    for (int i=0;i<n;++i) {
-      for (int j=0;j<m;++j) {
-        for (int k=0;k<l;++k) {
-          C[n*i + j] += A[l*k + i]*B[l*k + j];
+    //  A : l-by-n   B: l-by-m
+    //  C = A'*B
+    void blocked_mul_tn(int n, int m, int l, const double *A, const double *B, double *C) {
+      for (int kk=0;kk<l;kk+=block_size) {
+        int kend = std::min(kk+block_size,l);
+        for (int jj=0;jj<m;jj+=block_size) {
+          int jend = std::min(jj+block_size,m);
+          for (int i=0;i<n;++i) {
+            double* Ci = C + m*i;
+            for (int k=kk;k<kend;++k) {
+              double a = A[n*k + i];
+              if (a==0) continue;
+              const double* Bk = B + m*k;
+              // Unit stride, vectorizable
+              for (int j=jj;j<jend;++j) Ci[j] += a*Bk[j];
+            }
+          }
         }
       }
     }
+  } // namespace
+  
+  // The row-major products are passed to the column-major dgemm as C' += op(B)'*op(A)'
+  void PsdIndefDpleInternal::dense_mul_nt(int n, int m, int l, const double *A, const double *B, double *C) const {
+    if (use_blas_) {
+      char transa = 'T', transb = 'N';
+      double one = 1;
+      dgemm_(&transa,&transb,&m,&n,&l,&one,B,&l,A,&l,&one,C,&m);
+    } else {
+      blocked_mul_nt(n,m,l,A,B,C);
+    }
+  }
+  
+  void PsdIndefDpleInternal::dense_mul_nn(int n, int m, int l, const double *A, const double *B, double *C) const {
+    if (use_blas_) {
+      char transa = 'N', transb = 'N';
+      double one = 1;
+      dgemm_(&transa,&transb,&m,&n,&l,&one,B,&m,A,&l,&one,C,&m);
+    } else {
+      blocked_mul_nn(n,m,l,A,B,C);
+    }
+  }
+  
+  void PsdIndefDpleInternal::dense_mul_tn(int n, int m, int l, const double *A, const double *B, double *C) const {
+    if (use_blas_) {
+      char transa = 'N', transb = 'T';
+      double one = 1;
+      dgemm_(&transa,&transb,&m,&n,&l,&one,B,&m,A,&n,&one,C,&m);
+    } else {
+      blocked_mul_tn(n,m,l,A,B,C);
+    }
   }
   
   /// \endcond
@@ -219,11 +314,19 @@ namespace CasADi{
       time_start = getRealTime(); // Start timer
     }
     
-    // Transpose operation (after #554)
+    // Transpose operation (after #554), in tiles that fit in cache
+    const std::vector<double>& A_data = input(DPLE_A).data();
+#ifdef WITH_OPENMP
+#pragma omp parallel for if(omp_) schedule(static)
+#endif // WITH_OPENMP
     for (int k=0;k<K_;++k) {
-      for (int i=0;i<n_;++i) {
-        for (int j=0;j<n_;++j) {
-          X_[k*n_*n_+i*n_+j] = input(DPLE_A).data()[k*n_*n_+n_*j+i];
+      for (int ii=0;ii<n_;ii+=16) {
+        for (int jj=0;jj<n_;jj+=16) {
+          for (int i=ii;i<std::min(ii+16,n_);++i) {
+            for (int j=jj;j<std::min(jj+16,n_);++j) {
+              X_[k*n_*n_+i*n_+j] = A_data[k*n_*n_+n_*j+i];
+            }
+          }
         }
       }
     }
@@ -260,6 +363,9 @@ namespace CasADi{
     // ********** START ***************
     // V = blocks([mul([sZ[k].T,Vs[k],sZ[k]]) for k in range(p)])
     
+#ifdef WITH_OPENMP
+#pragma omp parallel for if(omp_) schedule(static)
+#endif // WITH_OPENMP
     for(int k=0;k<K_;++k) {
       nnKa_[k].set(0.0);
       nnKb_[k].set(0.0);
@@ -468,6 +574,9 @@ namespace CasADi{
     
     output(DPLE_P).set(0.0);
 
+#ifdef WITH_OPENMP
+#pragma omp parallel for if(omp_) schedule(static)
+#endif // WITH_OPENMP
     for(int k=0;k<K_;++k) {
       nnKa_[k].set(0.0);
       
@@ -489,6 +598,9 @@ namespace CasADi{
       }
       
       // dV2 = [dV+mul([a_dot,x,a.T])+mul([a,x,a_dot.T]) for vp,a,a_dot,x in zip(Vp,As,Ap,X) ]  
+#ifdef WITH_OPENMP
+#pragma omp parallel for if(omp_) schedule(static)
+#endif // WITH_OPENMP
       for(int k=0;k<K_;++k) {
         std::fill(nnKb_[k].begin(),nnKb_[k].end(),0);    
         std::fill(nnKa_[k].begin(),nnKa_[k].end(),0);
@@ -524,6 +636,9 @@ namespace CasADi{
       // ********** START ***************
       // V = blocks([mul([sZ[k].T,dV2[k],sZ[k]]) for k in range(p)])
       
+#ifdef WITH_OPENMP
+#pragma omp parallel for if(omp_) schedule(static)
+#endif // WITH_OPENMP
       for(int k=0;k<K_;++k) {
         nnKa_[k].set(0.0);
         // nnKa[k] <- dV2[k]*Z[k+1]
@@ -697,6 +812,9 @@ namespace CasADi{
         
         output(DPLE_NUM_OUT*(d+1)+DPLE_P).set(0.0);
         
+#ifdef WITH_OPENMP
+#pragma omp parallel for if(omp_) schedule(static)
+#endif // WITH_OPENMP
         for(int k=0;k<K_;++k) {
           nnKa_[k].set(0.0);
           
@@ -735,6 +853,9 @@ namespace CasADi{
       
     
       // X_bar = [mul([Z[k].T, X_bar[k] , Z[k]]) for k in range(p)]
+#ifdef WITH_OPENMP
+#pragma omp parallel for if(omp_) schedule(static)
+#endif // WITH_OPENMP
       for(int k=0;k<K_;++k) {
         nnKa_[k].set(0.0);
         
@@ -923,6 +1044,9 @@ namespace CasADi{
       
       
       // V_bar = [mul([sZ[k], V_bar[k] , sZ[k].T]) for k in range(p)]
+#ifdef WITH_OPENMP
+#pragma omp parallel for if(omp_) schedule(static)
+#endif // WITH_OPENMP
       for(int k=0;k<K_;++k) {
         nnKa_[k].set(0.0);
         dense_mul_nn(n_,n_,n_,&Vbar[n_*n_*k],&Z_[((k+1)%K_)*n_*n_],&nnKa_[k].data()[0]);
@@ -931,6 +1055,9 @@ namespace CasADi{
       }
       
       // Force symmetry
+#ifdef WITH_OPENMP
+#pragma omp parallel for if(omp_) schedule(static)
+#endif // WITH_OPENMP
       for(int k=0;k<K_;++k) {
         for (int r=0;r<n_;++r) {
           for (int l=0;l<r;++l) {
@@ -942,6 +1069,9 @@ namespace CasADi{
       }
       
       // A_bar = [mul([vb+vb.T,a,x]) for vb,x,a in zip(V_bar,X,As)]
+#ifdef WITH_OPENMP
+#pragma omp parallel for if(omp_) schedule(static)
+#endif // WITH_OPENMP
       for(int k=0;k<K_;++k) {
         std::fill(nnKa_[k].begin(),nnKa_[k].end(),0);
         dense_mul_nn(n_,n_,n_,&output(DPLE_P).data()[n_*n_*k],&input(DPLE_A).data()[n_*n_*k],&nnKa_[k].data()[0]);
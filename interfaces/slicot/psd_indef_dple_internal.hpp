@@ -117,6 +117,21 @@ namespace CasADi{
     /// Work vector for periodic Schur form
     std::vector< double > dwork_;
     
+    /// Use the system BLAS for the dense products
+    bool use_blas_;
+    
+    /// Run the independent per-period products in parallel
+    bool omp_;
+    
+    /// C += A*B' with A n-by-l, B m-by-l, C n-by-m, all row-major
+    void dense_mul_nt(int n, int m, int l, const double *A, const double *B, double *C) const;
+    
+    /// C += A*B with A n-by-l, B l-by-m, C n-by-m, all row-major
+    void dense_mul_nn(int n, int m, int l, const double *A, const double *B, double *C) const;
+    
+    /// C += A'*B with A l-by-n, B l-by-m, C n-by-m, all row-major
+    void dense_mul_tn(int n, int m, int l, const double *A, const double *B, double *C) const;
+    
   };
   
 } // namespace CasADi
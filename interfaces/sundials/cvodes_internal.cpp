@@ -131,6 +131,10 @@ namespace CasADi{
     CVodeSetMaxNumSteps(mem_, getOption("max_num_steps").toInt());
     if(flag != CV_SUCCESS) cvodes_error("CVodeSetMaxNumSteps",flag);
   
+    // Set user data, before attaching the linear solver which passes it on to the preconditioner
+    flag = CVodeSetUserData(mem_,this);
+    if(flag!=CV_SUCCESS) cvodes_error("CVodeSetUserData",flag);
+
     // attach a linear solver
     switch(linsol_f_){
     case SD_DENSE:
@@ -146,10 +150,6 @@ namespace CasADi{
       initUserDefinedLinearSolver();
       break;
     }
-      
-    // Set user data
-    flag = CVodeSetUserData(mem_,this);
-    if(flag!=CV_SUCCESS) cvodes_error("CVodeSetUserData",flag);
 
     // Quadrature equations
     if(nq_>0){
@@ -494,6 +494,14 @@ namespace CasADi{
     casadi_log("CVodesInternal::integrate(" << t_out << ") end");
   }
 
+  void CVodesInternal::interpolate(double t, DMatrix& x){
+    casadi_assert(x.size()==nx_);
+    N_Vector dky = N_VMake_Serial(nx_,x.ptr());
+    int flag = CVodeGetDky(mem_, t, 0, dky);
+    N_VDestroy_Serial(dky);
+    if(flag!=CV_SUCCESS) cvodes_error("CVodeGetDky",flag);
+  }
+
   void CVodesInternal::resetB(){
     casadi_log("CVodesInternal::resetB begin");
 
@@ -921,6 +921,15 @@ namespace CasADi{
     casadi_log("IdasInternal::integrate(" << t_out << ") end");
   }
 
+  void IdasInternal::interpolate(double t, DMatrix& x){
+    casadi_assert(x.size()==nx_);
+    N_Vector dky = N_VNew_Serial(nx_+nz_);
+    int flag = IDAGetDky(mem_, t, 0, dky);
+    if(flag==IDA_SUCCESS) copy(NV_DATA_S(dky),NV_DATA_S(dky)+nx_,x.begin());
+    N_VDestroy_Serial(dky);
+    if(flag!=IDA_SUCCESS) idas_error("IDAGetDky",flag);
+  }
+
   void IdasInternal::resetB(){
     log("IdasInternal::resetB","begin");
 
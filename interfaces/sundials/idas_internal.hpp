@@ -89,6 +89,9 @@ class IdasInternal : public SundialsInternal{
   /** \brief  Integrate backward until a specified time point */
   virtual void integrateB(double t_out);
 
+  /** \brief  Interpolate the differential state at a time within the last step taken (dense output) */
+  virtual void interpolate(double t, DMatrix& x);
+
   /** \brief  Set the stop time of the forward integration */
   virtual void setStopTime(double tf);
   
@@ -27,6 +27,7 @@
 #include "symbolic/sx/sx_tools.hpp"
 #include "symbolic/function/mx_function.hpp"
 #include "symbolic/function/sx_function.hpp"
+#include "symbolic/function/incomplete_lu.hpp"
 
 INPUTSCHEME(IntegratorInput)
 OUTPUTSCHEME(IntegratorOutput)
@@ -48,7 +49,7 @@ SundialsInternal::SundialsInternal(const Function& f, const Function& g) : Integ
   addOption("max_krylov",                  OT_INTEGER,          10,             "Maximum Krylov subspace size");
   addOption("sensitivity_method",          OT_STRING,           "simultaneous", "","simultaneous|staggered");
   addOption("max_multistep_order",         OT_INTEGER,          5);
-  addOption("use_preconditioner",          OT_BOOLEAN,          false,          "Precondition an iterative solver");
+  addOption("use_preconditioner",          OT_BOOLEAN,          false,          "Precondition an iterative solver. Unless a linear_solver is provided, an incomplete LU factorization of the sparse Jacobian is used");
   addOption("use_preconditionerB",         OT_BOOLEAN,          GenericType(),  "Precondition an iterative solver for the backwards problem [default: equal to use_preconditioner]");
   addOption("stop_at_end",                 OT_BOOLEAN,          true,          "Stop the integrator at the end of the interval");
   
@@ -190,9 +191,11 @@ void SundialsInternal::init(){
     casadi_assert_message(!jacB_.output().sparsity().isSingular(),"SundialsInternal::init: singularity - the jacobian of the backward problem is structurally rank-deficient. sprank(J)=" << sprank(jacB_.output()) << " (in stead of "<< jacB_.output().size2() << ")");
   }
   
-  if(hasSetOption("linear_solver") && !jac_.isNull()){
+  // Without a user defined linear solver, precondition an iterative solver with an incomplete LU factorization of the sparse Jacobian
+  if((hasSetOption("linear_solver") || (linsol_f_==SD_ITERATIVE && use_preconditioner_)) && !jac_.isNull()){
     // Create a linear solver
-    linearSolverCreator creator = getOption("linear_solver");
+    linearSolverCreator creator = IncompleteLU::creator;
+    if(hasSetOption("linear_solver")) creator = getOption("linear_solver");
     linsol_ = creator(jac_.output().sparsity(),1);
     // Pass options
     if(hasSetOption("linear_solver_options")){
@@ -201,9 +204,14 @@ void SundialsInternal::init(){
     linsol_.init();
   }
   
-  if((hasSetOption("linear_solverB") || hasSetOption("linear_solver")) && !jacB_.isNull()){
+  if((hasSetOption("linear_solverB") || hasSetOption("linear_solver") || (linsol_g_==SD_ITERATIVE && use_preconditionerB_)) && !jacB_.isNull()){
     // Create a linear solver
-    linearSolverCreator creator = hasSetOption("linear_solverB") ? getOption("linear_solverB") : getOption("linear_solver");
+    linearSolverCreator creator = IncompleteLU::creator;
+    if(hasSetOption("linear_solverB")){
+      creator = getOption("linear_solverB");
+    } else if(hasSetOption("linear_solver")){
+      creator = getOption("linear_solver");
+    }
     linsolB_ = creator(jacB_.output().sparsity(),1);
     // Pass options
     if(hasSetOption("linear_solver_optionsB")){
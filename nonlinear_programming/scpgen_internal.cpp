@@ -529,6 +529,8 @@ namespace CasADi{
     // Allocate QP data
     Sparsity sp_B_obj = mat_fcn_.output(mat_hes_).sparsity();
     qpH_ = DMatrix(sp_B_obj.patternProduct(sp_B_obj));
+    gn_iw_.resize(sp_B_obj.size1());
+    gn_w_.resize(sp_B_obj.size1());
     qpA_ = mat_fcn_.output(mat_jac_);
     qpB_.resize(ng_);
 
@@ -607,6 +609,9 @@ namespace CasADi{
 
   void SCPgenInternal::evaluate(){
     if (inputs_check_) checkInputs();
+
+    // Initialize with the solution of the previous call, if requested
+    bool warm = warmStart();
     checkInitialBounds();
   
     // Get problem data
@@ -635,14 +640,21 @@ namespace CasADi{
       cout << "Passed initial guess" << endl;
     }
 
-    // Reset dual guess
-    fill(g_lam_.begin(),g_lam_.end(),0);
+    // Reset dual guess, or take it from the inputs when warm starting
+    if(warm){
+      input(NLP_SOLVER_LAM_G0).get(g_lam_);
+      input(NLP_SOLVER_LAM_X0).get(x_lam_);
+    } else {
+      fill(g_lam_.begin(),g_lam_.end(),0);
+      fill(x_lam_.begin(),x_lam_.end(),0);
+    }
     fill(g_dlam_.begin(),g_dlam_.end(),0);    
-    fill(x_lam_.begin(),x_lam_.end(),0);
     fill(x_dlam_.begin(),x_dlam_.end(),0);
     if(!gauss_newton_){
+      // The multipliers of the lifted variables are kept if the horizon is not shifted
+      bool keep_lam = warm && warm_start_shift_x_==0 && warm_start_shift_g_==0;
       for(vector<Var>::iterator it=v_.begin(); it!=v_.end(); ++it){
-        fill(it->lam.begin(),it->lam.end(),0);
+        if(!keep_lam) fill(it->lam.begin(),it->lam.end(),0);
         fill(it->dlam.begin(),it->dlam.end(),0);
       }
     }
@@ -711,6 +723,7 @@ namespace CasADi{
       if(converged){
         cout << endl;
         cout << "CasADi::SCPgen: Convergence achieved after " << iter << " iterations." << endl;
+        has_solution_ = true;
         break;
       }
     
@@ -890,7 +903,7 @@ namespace CasADi{
       // Gauss-Newton Hessian
       const DMatrix& B_obj =  mat_fcn_.output(mat_hes_);
       fill(qpH_.begin(),qpH_.end(),0);
-      DMatrix::mul_no_alloc_tn(B_obj,B_obj,qpH_);
+      DMatrix::mul_no_alloc_tn(B_obj,B_obj,qpH_,getPtr(gn_iw_),gn_iw_.size(),getPtr(gn_w_),gn_w_.size());
 
       // Gradient of the objective in Gauss-Newton
       fill(gf_.begin(),gf_.end(),0);
@@ -216,6 +216,10 @@ public:
 
   // Hessian times a step
   std::vector<double> qpH_times_du_;
+
+  // Work vectors for forming the Gauss-Newton Hessian
+  std::vector<int> gn_iw_;
+  std::vector<double> gn_w_;
 };
 
 } // namespace CasADi
@@ -40,7 +40,7 @@ namespace CasADi{
     casadi_warning("The SQP method is under development");
     addOption("qp_solver",         OT_QPSOLVER,   GenericType(),    "The QP solver to be used by the SQP method");
     addOption("qp_solver_options", OT_DICTIONARY, GenericType(),    "Options to be passed to the QP solver");
-    addOption("hessian_approximation", OT_STRING, "exact",          "limited-memory|exact");
+    addOption("hessian_approximation", OT_STRING, "exact",          "limited-memory|exact|partitioned-bfgs");
     addOption("max_iter",           OT_INTEGER,      50,            "Maximum number of SQP iterations");
     addOption("max_iter_ls",        OT_INTEGER,       3,            "Maximum number of linesearch iterations");
     addOption("tol_pr",            OT_REAL,       1e-6,             "Stopping criterion for primal infeasibility");
@@ -72,22 +72,47 @@ namespace CasADi{
     c1_ = getOption("c1");
     beta_ = getOption("beta");
     merit_memsize_ = getOption("merit_memory");
+    casadi_assert_message(merit_memsize_>0, "SQPMethod: merit_memory must be positive");
     lbfgs_memory_ = getOption("lbfgs_memory");
     tol_pr_ = getOption("tol_pr");
     tol_du_ = getOption("tol_du");
     regularize_ = getOption("regularize");
     exact_hessian_ = getOption("hessian_approximation")=="exact";
+    partitioned_hessian_ = getOption("hessian_approximation")=="partitioned-bfgs";
     min_step_size_ = getOption("min_step_size");
     
     // Get/generate required functions
     gradF();
     jacG();
-    if(exact_hessian_){
+    if(exact_hessian_ || partitioned_hessian_){
       hessLag();
     }
 
     // Allocate a QP solver
     Sparsity H_sparsity = exact_hessian_ ? hessLag().output().sparsity() : Sparsity::dense(nx_,nx_);
+    if(partitioned_hessian_){
+      // Blocks of the exact Hessian, the approximation is dense within each block
+      Sparsity Hex_sparsity = hessLag().output().sparsity() + Sparsity::diag(nx_);
+      vector<int> index, offset;
+      int nblocks = Hex_sparsity.stronglyConnectedComponents(index,offset);
+      hblock_.resize(nx_);
+      vector<int> H_row, H_col;
+      for(int b=0; b<nblocks; ++b){
+        for(int k1=offset[b]; k1<offset[b+1]; ++k1){
+          hblock_[index[k1]] = b;
+          for(int k2=offset[b]; k2<offset[b+1]; ++k2){
+            H_row.push_back(index[k1]);
+            H_col.push_back(index[k2]);
+          }
+        }
+      }
+      H_sparsity = Sparsity::triplet(nx_,nx_,H_row,H_col);
+      bfgs_qk_.resize(nx_);
+      bfgs_yk_.resize(nx_);
+      bfgs_skBksk_.resize(nblocks);
+      bfgs_skyk_.resize(nblocks);
+      bfgs_omega_.resize(nblocks);
+    }
     H_sparsity = H_sparsity + Sparsity::diag(nx_);
     Sparsity A_sparsity = jacG().isNull() ? Sparsity::sparse(0,nx_) : jacG().output().sparsity();
 
@@ -138,8 +163,14 @@ namespace CasADi{
     // Gradient of the objective
     gf_.resize(nx_);
 
+    // Merit function values of the last iterations
+    merit_mem_.resize(merit_memsize_);
+
     // Create Hessian update function
-    if(!exact_hessian_){
+    if(partitioned_hessian_){
+      // Initial Hessian approximation
+      B_init_ = DMatrix::eye(nx_);
+    } else if(!exact_hessian_){
       // Create expressions corresponding to Bk, x, x_old, gLag and gLag_old
       SX Bk = SX::sym("Bk",H_sparsity);
       SX x = SX::sym("x",input(NLP_SOLVER_X0).sparsity());
@@ -175,12 +206,18 @@ namespace CasADi{
       B_init_ = DMatrix::eye(nx_);
     }
   
+    // No real-time iteration in progress
+    rti_prepared_ = rti_continue_ = rti_update_h_ = false;
+    rti_iter_ = 0;
+
     // Header
     if(bool(getOption("print_header"))){
       cout << "-------------------------------------------" << endl;
       cout << "This is CasADi::SQPMethod." << endl;
       if(exact_hessian_){
         cout << "Using exact Hessian" << endl;
+      } else if(partitioned_hessian_){
+        cout << "Using partitioned BFGS Hessian approximation (" << bfgs_omega_.size() << " blocks)" << endl;
       } else {
         cout << "Using limited memory BFGS Hessian approximation" << endl;
       }
@@ -195,6 +232,9 @@ namespace CasADi{
 
   void SQPInternal::evaluate(){
     if (inputs_check_) checkInputs();
+
+    // Initialize with the solution of the previous call, if requested
+    bool warm = warmStart();
     checkInitialBounds();
     
     if (gather_stats_) {
@@ -205,6 +245,12 @@ namespace CasADi{
       iterations["d_norm"] = std::vector<double>();
       iterations["obj"] = std::vector<double>();
       stats_["iterations"] = iterations;
+
+      // Reserve the storage so that the iterations need not reallocate
+      Dictionary& iter_stats = stats_["iterations"];
+      for(Dictionary::iterator it=iter_stats.begin(); it!=iter_stats.end(); ++it){
+        static_cast<std::vector<double>&>(it->second).reserve(max_iter_+1);
+      }
     }
     
   
@@ -234,11 +280,11 @@ namespace CasADi{
     // Initial objective gradient
     eval_grad_f(x_,fk_,gf_);
   
-    // Initialize or reset the Hessian or Hessian approximation
+    // Initialize or reset the Hessian or Hessian approximation, a warm start keeps the quasi-Newton memory
     reg_ = 0;
     if(exact_hessian_){
       eval_h(x_,mu_,1.0,Bk_);
-    } else {
+    } else if(!warm){
       reset_h();
     }
 
@@ -258,8 +304,8 @@ namespace CasADi{
     bool ls_success = true;
   
     // Reset
-    merit_mem_.clear();
-    sigma_ = 0.;    // NOTE: Move this into the main optimization loop
+    merit_ind_ = merit_count_ = 0;
+    if(!warm) sigma_ = 0.;    // NOTE: Move this into the main optimization loop
 
     // Default stepsize
     double t = 0;
@@ -329,6 +375,7 @@ namespace CasADi{
         cout << endl;
         cout << "CasADi::SQPMethod: Convergence achieved after " << iter << " iterations." << endl;
         stats_["return_status"] = "Solve_Succeeded";
+        has_solution_ = true;
         break;
       }
     
@@ -379,10 +426,10 @@ namespace CasADi{
       double L1merit = fk_ + sigma_ * l1_infeas;
 
       // Storing the actual merit function value in a list
-      merit_mem_.push_back(L1merit);
-      if (merit_mem_.size() > merit_memsize_){
-        merit_mem_.pop_front();
-      }
+      merit_mem_[merit_ind_] = L1merit;
+      merit_ind_ = (merit_ind_+1) % merit_memsize_;
+      merit_count_ = std::min(merit_count_+1, merit_memsize_);
+
       // Stepsize
       t = 1.0;
       double fk_cand;
@@ -420,7 +467,7 @@ namespace CasADi{
       
           L1merit_cand = fk_cand + sigma_ * l1_infeas;
           // Calculating maximal merit function value so far
-          double meritmax = *max_element(merit_mem_.begin(), merit_mem_.end());
+          double meritmax = *max_element(merit_mem_.begin(), merit_mem_.begin()+merit_count_);
           if (L1merit_cand <= meritmax + t * c1_ * L1dir){
             // Accepting candidate
             log("Line-search completed, candidate accepted");
@@ -481,31 +528,7 @@ namespace CasADi{
       // Updating Lagrange Hessian
       if( !exact_hessian_){
         log("Updating Hessian (BFGS)");
-        // BFGS with careful updates and restarts
-        if (iter % lbfgs_memory_ == 0){
-          // Reset Hessian approximation by dropping all off-diagonal entries
-          const vector<int>& colind = Bk_.colind();      // Access sparsity (column offset)
-          const vector<int>& row = Bk_.row();            // Access sparsity (row)
-          vector<double>& data = Bk_.data();             // Access nonzero elements
-          for(int cc=0; cc<colind.size()-1; ++cc){          // Loop over the columns of the Hessian
-            for(int el=colind[cc]; el<colind[cc+1]; ++el){ // Loop over the nonzero elements of the column
-              if(cc!=row[el]) data[el] = 0;               // Remove if off-diagonal entries
-            }
-          }
-        }
-      
-        // Pass to BFGS update function
-        bfgs_.setInput(Bk_,BFGS_BK);
-        bfgs_.setInput(x_,BFGS_X);
-        bfgs_.setInput(x_old_,BFGS_X_OLD);
-        bfgs_.setInput(gLag_,BFGS_GLAG);
-        bfgs_.setInput(gLag_old_,BFGS_GLAG_OLD);
-      
-        // Update the Hessian approximation
-        bfgs_.evaluate();
-      
-        // Get the updated Hessian
-        bfgs_.getOutput(Bk_);
+        update_h(iter);
       } else {
         // Exact Hessian
         log("Evaluating hessian");
@@ -550,8 +573,13 @@ namespace CasADi{
       cout << "time spent in callback preparation: " << t_callback_prepare_ << " s." << endl;
     }
   
+    // Real-time iterations continue from the solution
+    rti_prepared_ = rti_update_h_ = false;
+    rti_continue_ = true;
+
     // Save statistics
     stats_["iter_count"] = iter;
+    stats_["warm_start"] = warm;
     
     stats_["t_eval_f"] = t_eval_f_;
     stats_["t_eval_grad_f"] = t_eval_grad_f_;
@@ -626,6 +654,110 @@ namespace CasADi{
     return ret;
   }
 
+  void SQPInternal::prepare(){
+    double time1 = clock();
+    t_eval_f_ = t_eval_grad_f_ = t_eval_g_ = t_eval_jac_g_ = t_eval_h_ = 0;
+    n_eval_f_ = n_eval_grad_f_ = n_eval_g_ = n_eval_jac_g_ = n_eval_h_ = 0;
+
+    // Linearization point: the iterate of the last feedback phase (shifted if requested) or the initial guess
+    bool shift = warm_start_shift_x_>0 || warm_start_shift_g_>0;
+    if(rti_continue_){
+      if(shift){
+        shiftWarmStart(x_,x_,warm_start_shift_x_);
+        shiftWarmStart(mu_x_,mu_x_,warm_start_shift_x_);
+        shiftWarmStart(mu_,mu_,warm_start_shift_g_);
+      }
+    } else {
+      input(NLP_SOLVER_X0).get(x_);
+      input(NLP_SOLVER_LAM_G0).get(mu_);
+      input(NLP_SOLVER_LAM_X0).get(mu_x_);
+    }
+
+    // Linearize the constraints and the objective
+    eval_jac_g(x_,gk_,Jk_);
+    eval_grad_f(x_,fk_,gf_);
+
+    // Hessian of the Lagrangian
+    reg_ = 0;
+    if(exact_hessian_){
+      eval_h(x_,mu_,1.0,Bk_);
+    } else if(!rti_continue_){
+      reset_h();
+    } else if(rti_update_h_ && !shift && norm_inf(dx_) > min_step_size_){
+      // Gradient of the Lagrangian in the new iterate
+      copy(gf_.begin(),gf_.end(),gLag_.begin());
+      if(ng_>0) DMatrix::mul_no_alloc_tn(Jk_,mu_,gLag_);
+      transform(gLag_.begin(),gLag_.end(),mu_x_.begin(),gLag_.begin(),plus<double>());
+      update_h(++rti_iter_);
+    }
+
+    // Pass the matrices and the gradient to the QP solver
+    prepare_QP(Bk_,gf_,Jk_);
+    rti_prepared_ = true;
+    rti_update_h_ = false;
+
+    double time2 = clock();
+    t_prepare_ = double(time2-time1)/CLOCKS_PER_SEC;
+    stats_["t_prepare"] = t_prepare_;
+    stats_["t_eval_jac_g"] = t_eval_jac_g_;
+    stats_["t_eval_grad_f"] = t_eval_grad_f_;
+    stats_["t_eval_h"] = t_eval_h_;
+  }
+
+  void SQPInternal::feedback(){
+    casadi_assert_message(rti_prepared_, "SQPMethod::feedback: No prepared QP, call prepare first");
+    double time1 = clock();
+    t_eval_g_ = 0;
+    n_eval_g_ = 0;
+
+    // Constraint values for the current parameters
+    eval_g(x_,gk_);
+
+    // Bounds of the QP
+    const vector<double>& lbx = input(NLP_SOLVER_LBX).data();
+    const vector<double>& ubx = input(NLP_SOLVER_UBX).data();
+    const vector<double>& lbg = input(NLP_SOLVER_LBG).data();
+    const vector<double>& ubg = input(NLP_SOLVER_UBG).data();
+    transform(lbx.begin(),lbx.end(),x_.begin(),qp_LBX_.begin(),minus<double>());
+    transform(ubx.begin(),ubx.end(),x_.begin(),qp_UBX_.begin(),minus<double>());
+    transform(lbg.begin(),lbg.end(),gk_.begin(),qp_LBA_.begin(),minus<double>());
+    transform(ubg.begin(),ubg.end(),gk_.begin(),qp_UBA_.begin(),minus<double>());
+
+    // Solve the prepared QP
+    double time_qp1 = clock();
+    feedback_QP(qp_LBX_,qp_UBX_,qp_LBA_,qp_UBA_,dx_,qp_DUAL_X_,qp_DUAL_A_);
+    double time_qp2 = clock();
+
+    // Full step
+    copy(qp_DUAL_A_.begin(),qp_DUAL_A_.end(),mu_.begin());
+    copy(qp_DUAL_X_.begin(),qp_DUAL_X_.end(),mu_x_.begin());
+    copy(x_.begin(),x_.end(),x_old_.begin());
+    transform(x_.begin(),x_.end(),dx_.begin(),x_.begin(),plus<double>());
+
+    // Save results to outputs, objective and constraints refer to the linearization point
+    output(NLP_SOLVER_F).set(fk_);
+    output(NLP_SOLVER_X).set(x_);
+    output(NLP_SOLVER_LAM_G).set(mu_);
+    output(NLP_SOLVER_LAM_X).set(mu_x_);
+    output(NLP_SOLVER_G).set(gk_);
+    rti_prepared_ = false;
+    rti_continue_ = true;
+
+    double time2 = clock();
+    t_feedback_ = double(time2-time1)/CLOCKS_PER_SEC;
+    stats_["t_feedback"] = t_feedback_;
+    stats_["t_solve_qp"] = double(time_qp2-time_qp1)/CLOCKS_PER_SEC;
+    stats_["t_eval_g"] = t_eval_g_;
+
+    // Gradient of the Lagrangian with the old x but new multipliers, for the BFGS update in the next preparation phase
+    if(!exact_hessian_){
+      copy(gf_.begin(),gf_.end(),gLag_old_.begin());
+      if(ng_>0) DMatrix::mul_no_alloc_tn(Jk_,mu_,gLag_old_);
+      transform(gLag_old_.begin(),gLag_old_.end(),mu_x_.begin(),gLag_old_.begin(),plus<double>());
+      rti_update_h_ = true;
+    }
+  }
+
   void SQPInternal::reset_h(){
     // Initial Hessian approximation of BFGS
     if ( !exact_hessian_){
@@ -639,6 +771,98 @@ namespace CasADi{
     }
   }
 
+  void SQPInternal::update_h(int iter){
+    // BFGS with careful updates and restarts
+    if (iter % lbfgs_memory_ == 0){
+      // Reset Hessian approximation by dropping all off-diagonal entries
+      const vector<int>& colind = Bk_.colind();      // Access sparsity (column offset)
+      const vector<int>& row = Bk_.row();            // Access sparsity (row)
+      vector<double>& data = Bk_.data();             // Access nonzero elements
+      for(int cc=0; cc<colind.size()-1; ++cc){          // Loop over the columns of the Hessian
+        for(int el=colind[cc]; el<colind[cc+1]; ++el){ // Loop over the nonzero elements of the column
+          if(cc!=row[el]) data[el] = 0;               // Remove if off-diagonal entries
+        }
+      }
+    }
+      
+    if(partitioned_hessian_){
+      // Update each block separately
+      update_partitioned_bfgs();
+    } else {
+      // Pass to BFGS update function
+      bfgs_.setInput(Bk_,BFGS_BK);
+      bfgs_.setInput(x_,BFGS_X);
+      bfgs_.setInput(x_old_,BFGS_X_OLD);
+      bfgs_.setInput(gLag_,BFGS_GLAG);
+      bfgs_.setInput(gLag_old_,BFGS_GLAG_OLD);
+      
+      // Update the Hessian approximation
+      bfgs_.evaluate();
+      
+      // Get the updated Hessian
+      bfgs_.getOutput(Bk_);
+    }
+  }
+
+  void SQPInternal::update_partitioned_bfgs(){
+    // Access the Hessian approximation
+    const vector<int>& colind = Bk_.colind();
+    const vector<int>& row = Bk_.row();
+    vector<double>& data = Bk_.data();
+
+    // qk = Bk*sk with sk = x - x_old
+    fill(bfgs_qk_.begin(),bfgs_qk_.end(),0);
+    for(int cc=0; cc<nx_; ++cc){
+      double sk_cc = x_[cc] - x_old_[cc];
+      for(int el=colind[cc]; el<colind[cc+1]; ++el){
+        bfgs_qk_[row[el]] += data[el]*sk_cc;
+      }
+    }
+
+    // Inner products sk'*Bk*sk and sk'*yk for each block, with yk = gLag - gLag_old
+    fill(bfgs_skBksk_.begin(),bfgs_skBksk_.end(),0);
+    fill(bfgs_skyk_.begin(),bfgs_skyk_.end(),0);
+    for(int i=0; i<nx_; ++i){
+      double sk_i = x_[i] - x_old_[i];
+      bfgs_skBksk_[hblock_[i]] += sk_i*bfgs_qk_[i];
+      bfgs_skyk_[hblock_[i]] += sk_i*(gLag_[i] - gLag_old_[i]);
+    }
+
+    // Powell damping factor of each block, blocks without a step are not updated
+    for(int b=0; b<bfgs_omega_.size(); ++b){
+      double skBksk = bfgs_skBksk_[b];
+      double skyk = bfgs_skyk_[b];
+      if(skBksk<=0){
+        bfgs_omega_[b] = 0;
+      } else if(skyk < 0.2*skBksk){
+        bfgs_omega_[b] = 0.8*skBksk/(skBksk - skyk);
+      } else {
+        bfgs_omega_[b] = 1;
+      }
+      
+      // Inner product with the damped yk
+      bfgs_skyk_[b] = bfgs_omega_[b]*skyk + (1-bfgs_omega_[b])*skBksk;
+    }
+
+    // Damped yk
+    for(int i=0; i<nx_; ++i){
+      double omega = bfgs_omega_[hblock_[i]];
+      bfgs_yk_[i] = omega*(gLag_[i] - gLag_old_[i]) + (1-omega)*bfgs_qk_[i];
+    }
+
+    // Rank-2 update of each block: Bk += yk*yk'/(sk'*yk) - qk*qk'/(sk'*Bk*sk)
+    for(int cc=0; cc<nx_; ++cc){
+      int b = hblock_[cc];
+      if(bfgs_skBksk_[b]<=0) continue;
+      double theta = 1./bfgs_skyk_[b];
+      double phi = 1./bfgs_skBksk_[b];
+      for(int el=colind[cc]; el<colind[cc+1]; ++el){
+        int rr = row[el];
+        data[el] += theta*bfgs_yk_[rr]*bfgs_yk_[cc] - phi*bfgs_qk_[rr]*bfgs_qk_[cc];
+      }
+    }
+  }
+
   double SQPInternal::getRegularization(const Matrix<double>& H){
     const vector<int>& colind = H.colind();
     const vector<int>& row = H.row();
@@ -677,6 +901,8 @@ namespace CasADi{
   
   void SQPInternal::eval_h(const std::vector<double>& x, const std::vector<double>& lambda, double sigma, Matrix<double>& H){
     try{
+      double time1 = clock();
+
       // Get function
       Function& hessLag = this->hessLag();
 
@@ -706,6 +932,10 @@ namespace CasADi{
         }
       }
 
+      double time2 = clock();
+      t_eval_h_ += double(time2-time1)/CLOCKS_PER_SEC;
+      n_eval_h_ += 1;
+
     } catch (exception& ex){
       cerr << "eval_h failed: " << ex.what() << endl;
       throw;
@@ -854,11 +1084,30 @@ namespace CasADi{
                              const std::vector<double>& lbx, const std::vector<double>& ubx,
                              const Matrix<double>& A, const std::vector<double>& lbA, const std::vector<double>& ubA,
                              std::vector<double>& x_opt, std::vector<double>& lambda_x_opt, std::vector<double>& lambda_A_opt){
+    prepare_QP(H,g,A);
+    feedback_QP(lbx,ubx,lbA,ubA,x_opt,lambda_x_opt,lambda_A_opt);
+  }
 
+  void SQPInternal::prepare_QP(const Matrix<double>& H, const std::vector<double>& g, const Matrix<double>& A){
     // Pass data to QP solver
     qp_solver_.setInput(H, QP_SOLVER_H);
     qp_solver_.setInput(g,QP_SOLVER_G);
+    if(ng_>0){
+      qp_solver_.setInput(A, QP_SOLVER_A);
+    }
 
+    if (monitored("qp")) {
+      cout << "H = " << endl;
+      H.printDense();
+      cout << "A = " << endl;
+      A.printDense();
+      cout << "g = " << g << endl;
+    }
+  }
+
+  void SQPInternal::feedback_QP(const std::vector<double>& lbx, const std::vector<double>& ubx,
+                                const std::vector<double>& lbA, const std::vector<double>& ubA,
+                                std::vector<double>& x_opt, std::vector<double>& lambda_x_opt, std::vector<double>& lambda_A_opt){
     // Hot-starting if possible
     qp_solver_.setInput(x_opt, QP_SOLVER_X0);
   
@@ -871,17 +1120,11 @@ namespace CasADi{
 
     // Pass linear bounds
     if(ng_>0){
-      qp_solver_.setInput(A, QP_SOLVER_A);
       qp_solver_.setInput(lbA, QP_SOLVER_LBA);
       qp_solver_.setInput(ubA, QP_SOLVER_UBA);
     }
   
     if (monitored("qp")) {
-      cout << "H = " << endl;
-      H.printDense();
-      cout << "A = " << endl;
-      A.printDense();
-      cout << "g = " << g << endl;
       cout << "lbx = " << lbx << endl;
       cout << "ubx = " << ubx << endl;
       cout << "lbA = " << lbA << endl;
@@ -26,7 +26,6 @@
 #include "sqp_method.hpp"
 #include "symbolic/function/nlp_solver_internal.hpp"
 #include "symbolic/function/qp_solver.hpp"
-#include <deque>
 
 /// \cond INTERNAL
 namespace CasADi{
@@ -47,6 +46,9 @@ public:
   /// Exact Hessian?
   bool exact_hessian_;
 
+  /// Partitioned (block-diagonal) BFGS following the sparsity of the exact Hessian?
+  bool partitioned_hessian_;
+
   /// maximum number of sqp iterations
   int max_iter_; 
 
@@ -74,6 +76,27 @@ public:
   
   /// Access QPSolver
   const QPSolver getQPSolver() const { return qp_solver_;}
+
+  /// Real-time iteration, preparation phase: linearize in the current iterate
+  void prepare();
+
+  /// Real-time iteration, feedback phase: solve the prepared QP for the current inputs and take a full step
+  void feedback();
+
+  /// Real-time iteration: prepared QP available
+  bool rti_prepared_;
+
+  /// Real-time iteration: continue from the internal iterate rather than the initial guess
+  bool rti_continue_;
+
+  /// Real-time iteration: Hessian approximation to be updated in the next preparation phase
+  bool rti_update_h_;
+
+  /// Real-time iteration: number of Hessian approximation updates
+  int rti_iter_;
+
+  /// Real-time iteration: duration of the last preparation and feedback phases
+  double t_prepare_, t_feedback_;
   
   /// Lagrange multipliers of the NLP
   std::vector<double> mu_, mu_x_;
@@ -102,6 +125,15 @@ public:
   
   /// Current Hessian approximation
   DMatrix Bk_;
+
+  /// Block of each variable in the partitioned BFGS update
+  std::vector<int> hblock_;
+
+  /// Work vectors for the partitioned BFGS update: Bk*sk and damped yk
+  std::vector<double> bfgs_qk_, bfgs_yk_;
+
+  /// Inner products and damping factor of each block in the partitioned BFGS update
+  std::vector<double> bfgs_skBksk_, bfgs_skyk_, bfgs_omega_;
   
   // Current Jacobian
   DMatrix Jk_;
@@ -115,8 +147,9 @@ public:
   /// Regularization
   bool regularize_;
 
-  // Storage for merit function
-  std::deque<double> merit_mem_;
+  // Storage for merit function, a ring buffer of the last merit_memory values
+  std::vector<double> merit_mem_;
+  int merit_ind_, merit_count_;
 
   /// Print iteration header
   void printIteration(std::ostream &stream);
@@ -128,6 +161,12 @@ public:
   // Reset the Hessian or Hessian approximation
   void reset_h();
 
+  // Update the Hessian approximation with the last step, dropping the off-diagonal entries every lbfgs_memory iterations
+  void update_h(int iter);
+
+  // Damped BFGS update of each diagonal block of the Hessian approximation
+  void update_partitioned_bfgs();
+
   // Evaluate the gradient of the objective
   virtual void eval_f(const std::vector<double>& x, double& f);
   
@@ -155,6 +194,14 @@ public:
                         const Matrix<double>& A, const std::vector<double>& lbA, const std::vector<double>& ubA,
                         std::vector<double>& x_opt, std::vector<double>& lambda_x_opt, std::vector<double>& lambda_A_opt);
   
+  // Pass the Hessian, gradient and constraint Jacobian of the QP subproblem to the QP solver
+  void prepare_QP(const Matrix<double>& H, const std::vector<double>& g, const Matrix<double>& A);
+
+  // Pass the bounds of the QP subproblem to the QP solver and solve
+  void feedback_QP(const std::vector<double>& lbx, const std::vector<double>& ubx,
+                   const std::vector<double>& lbA, const std::vector<double>& ubA,
+                   std::vector<double>& x_opt, std::vector<double>& lambda_x_opt, std::vector<double>& lambda_A_opt);
+
   // Calculate the L1-norm of the primal infeasibility
   double primalInfeasibility(const std::vector<double>& x, const std::vector<double>& lbx, const std::vector<double>& ubx,
                              const std::vector<double>& g, const std::vector<double>& lbg, const std::vector<double>& ubg);
@@ -55,4 +55,12 @@ namespace CasADi{
     return (*this)->getQPSolver();
   }
 
+  void SQPMethod::prepare(){
+    (*this)->prepare();
+  }
+
+  void SQPMethod::feedback(){
+    (*this)->feedback();
+  }
+
 } // namespace CasADi
@@ -33,7 +33,9 @@ namespace CasADi{
      \brief Sequential Quadratic Programming method.
      
      The algorithm is a classical SQP method with either exact (may be also provided) or 
-     damped BFGS Lagrange Hessian approximation.
+     damped BFGS Lagrange Hessian approximation. The BFGS approximation is either dense or, with
+     hessian_approximation set to "partitioned-bfgs", block-diagonal following the block structure
+     of the exact Hessian, which keeps the memory linear for e.g. multiple shooting problems.
      Two different line-search algorithms are available.
      First, Armijo (Wolfe) condition with backtracking (suffers from Maratos effect).
      Seco#ifndef WITHOUT_PRE_1_9_Xnd, a line-search method that checks if the merit function is lower
@@ -51,7 +53,11 @@ namespace CasADi{
      \endverbatim
   
      Nonlinear equalities can be introduced by setting LBG and UBG equal at the correct positions.
-  
+
+     All work vectors are allocated in init(): apart from the QP solver, the iterations do not allocate
+     memory on the heap, unless a callback or monitors are used. With gather_stats, the storage of the
+     iteration statistics is reserved for max_iter iterations before the first iteration.
+
      The method is still under development and should be used with care
   
      \author Attila Kozma, Joel Andersson and Joris Gillis
@@ -91,6 +97,25 @@ namespace CasADi{
 
     /// Access the QPSolver used internally
     const QPSolver getQPSolver() const;
+
+    /** \brief Real-time iteration, preparation phase
+     *
+     * Evaluates the constraint Jacobian, objective gradient and Hessian (approximation) in the
+     * current iterate and passes them to the QP solver. The current iterate is the one of the last
+     * call to feedback or evaluate, shifted according to the options "warm_start_shift_x" and
+     * "warm_start_shift_g", or the inputs X0, LAM_X0 and LAM_G0 for the first iteration.
+     * Can be called before the new parameter values are known.
+     * The duration of the phase is available as the stat "t_prepare".
+     */
+    void prepare();
+
+    /** \brief Real-time iteration, feedback phase
+     *
+     * Evaluates the constraints for the current parameters and bounds, solves the QP prepared by
+     * prepare and takes a full step. The outputs X, LAM_X and LAM_G hold the new iterate, F and G
+     * refer to the linearization point. The duration of the phase is available as the stat "t_feedback".
+     */
+    void feedback();
     
   };
 
@@ -661,6 +661,8 @@ memberbinops(pow,argtype,argCast,selfCast,returntype) \
 #include "symbolic/function/mx_function.hpp"
 #include "symbolic/function/linear_solver.hpp"
 #include "symbolic/function/symbolic_qr.hpp"
+#include "symbolic/function/incomplete_lu.hpp"
+#include "symbolic/function/sparse_ldl.hpp"
 #include "symbolic/function/implicit_function.hpp"
 #include "symbolic/function/integrator.hpp"
 #include "symbolic/function/simulator.hpp"
@@ -690,6 +692,7 @@ memberbinops(pow,argtype,argCast,selfCast,returntype) \
 #include "integration/fixed_step_integrator.hpp"
 #include "integration/implicit_fixed_step_integrator.hpp"
 #include "integration/rk_integrator.hpp"
+#include "integration/dormand_prince_integrator.hpp"
 #include "integration/collocation_integrator.hpp"
 #include "integration/old_collocation_integrator.hpp"
 #include "integration/integration_tools.hpp"
@@ -703,6 +706,7 @@ memberbinops(pow,argtype,argCast,selfCast,returntype) \
 
 #include "control/dple_solver.hpp"
 #include "control/simple_indef_dple_solver.hpp"
+#include "control/doubling_dple_solver.hpp"
 
 using namespace CasADi;
 
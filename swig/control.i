@@ -23,8 +23,10 @@
 %{
 #include "control/dple_solver.hpp"
 #include "control/simple_indef_dple_solver.hpp"
+#include "control/doubling_dple_solver.hpp"
 %}
 
 %include "control/dple_solver.hpp"
 %include "control/simple_indef_dple_solver.hpp"
+%include "control/doubling_dple_solver.hpp"
 
@@ -25,12 +25,16 @@
 #include "convex_programming/qcqp_qp_solver.hpp"
 #include "convex_programming/sdp_socp_solver.hpp"
 #include "convex_programming/qp_stabilizer.hpp"
+#include "convex_programming/condensing_qp_solver.hpp"
+#include "convex_programming/interior_point_qp_solver.hpp"
 %}
 
 %include "convex_programming/qp_lp_solver.hpp"
 %include "convex_programming/qcqp_qp_solver.hpp"
 %include "convex_programming/sdp_socp_solver.hpp"
 %include "convex_programming/qp_stabilizer.hpp"
+%include "convex_programming/condensing_qp_solver.hpp"
+%include "convex_programming/interior_point_qp_solver.hpp"
 
 #ifdef WITH_CSPARSE
 %{
@@ -27,6 +27,8 @@
 #include "symbolic/function/mx_function.hpp"
 #include "symbolic/function/linear_solver.hpp"
 #include "symbolic/function/symbolic_qr.hpp"
+#include "symbolic/function/incomplete_lu.hpp"
+#include "symbolic/function/sparse_ldl.hpp"
 #include "symbolic/function/implicit_function.hpp"
 #include "symbolic/function/integrator.hpp"
 #include "symbolic/function/simulator.hpp"
@@ -108,6 +110,8 @@
 %include "symbolic/function/mx_function.hpp"
 %include "symbolic/function/linear_solver.hpp"
 %include "symbolic/function/symbolic_qr.hpp"
+%include "symbolic/function/incomplete_lu.hpp"
+%include "symbolic/function/sparse_ldl.hpp"
 %include "symbolic/function/implicit_function.hpp"
 %include "symbolic/function/integrator.hpp"
 %include "symbolic/function/simulator.hpp"
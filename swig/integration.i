@@ -24,6 +24,7 @@
 #include "integration/fixed_step_integrator.hpp"
 #include "integration/implicit_fixed_step_integrator.hpp"
 #include "integration/rk_integrator.hpp"
+#include "integration/dormand_prince_integrator.hpp"
 #include "integration/collocation_integrator.hpp"
 #include "integration/old_collocation_integrator.hpp"
 #include "integration/integration_tools.hpp"
@@ -32,6 +33,7 @@
 %include "integration/fixed_step_integrator.hpp"
 %include "integration/implicit_fixed_step_integrator.hpp"
 %include "integration/rk_integrator.hpp"
+%include "integration/dormand_prince_integrator.hpp"
 %include "integration/collocation_integrator.hpp"
 %include "integration/old_collocation_integrator.hpp"
 %include "integration/integration_tools.hpp"
@@ -23,7 +23,11 @@
 %{
 #include "interfaces/lapack/lapack_lu_dense.hpp"
 #include "interfaces/lapack/lapack_qr_dense.hpp"
+#include "interfaces/lapack/lapack_cholesky_dense.hpp"
+#include "interfaces/lapack/lapack_ldl_dense.hpp"
 %}
 
 %include "interfaces/lapack/lapack_lu_dense.hpp"
 %include "interfaces/lapack/lapack_qr_dense.hpp"
+%include "interfaces/lapack/lapack_cholesky_dense.hpp"
+%include "interfaces/lapack/lapack_ldl_dense.hpp"
@@ -0,0 +1,34 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+ 
+#include "casadi_meta.hpp"
+
+namespace CasADi {
+  const std::string CasadiMeta::version = "1.9.0";
+  const std::string CasadiMeta::git_revision = "4a2b8368c55355a0ff2b60e0e39248e16b99a2bb";
+  const std::string CasadiMeta::git_describe = "";
+  const std::string CasadiMeta::feature_list = "\n * dynamic-loading, Compile with support for dynamic loading of generated functions (needed for ExternalFunction)\n * using-c++11, Using C++11 features (improves efficiency and is required for some examples).\n * sundials-interface, Interface to the ODE/DAE integrator suite SUNDIALS.\n * csparse-interface, Interface to the sparse direct linear solver CSparse.\n * lapack-interface, Interface to LAPACK.\n * qpoases-interface, Interface to the active-set QP solver qpOASES.\n * dsdp-interface, Interface to the interior point SDP solver DSDP (requires BLAS and LAPACK).\n";
+  const std::string CasadiMeta::build_type = "Release";
+  const std::string CasadiMeta::compiler_id = "GNU";
+  const std::string CasadiMeta::compiler = "/usr/bin/c++";
+  const std::string CasadiMeta::compiler_flags =" -Wall -Wextra -Wno-unused-parameter -Wno-sign-compare -Wno-delete-non-virtual-dtor -fPIC -O3 -DNDEBUG";
+}
@@ -257,6 +257,34 @@ namespace CasADi{
     case AUX_FILL: 
       auxiliaries_ << codegen_str_fill << endl; 
       break;
+    case AUX_GEMM_TN:
+      addAuxiliary(AUX_DOT);
+      auxiliaries_ << codegen_str_gemm_tn << endl;
+      break;
+    case AUX_GEMM_NN:
+      addAuxiliary(AUX_AXPY);
+      auxiliaries_ << codegen_str_gemm_nn << endl;
+      break;
+    case AUX_SYRK_TN:
+      addAuxiliary(AUX_DOT);
+      auxiliaries_ << codegen_str_syrk_tn << endl;
+      break;
+    case AUX_TRSM:
+      addAuxiliary(AUX_AXPY);
+      addAuxiliary(AUX_DOT);
+      auxiliaries_ << codegen_str_trsm << endl;
+      break;
+    case AUX_GETRF:
+      addAuxiliary(AUX_SWAP);
+      addAuxiliary(AUX_SCAL);
+      addAuxiliary(AUX_AXPY);
+      auxiliaries_ << codegen_str_getrf << endl;
+      break;
+    case AUX_GETRS:
+      addAuxiliary(AUX_SWAP);
+      addAuxiliary(AUX_TRSM);
+      auxiliaries_ << codegen_str_getrs << endl;
+      break;
     case AUX_MM_TN_SPARSE: 
       auxiliaries_ << codegen_str_mm_tn_sparse << endl; 
       break;
@@ -75,6 +75,14 @@ namespace CasADi{
       AUX_FILL,
       AUX_ASUM,
 
+      // BLAS Level 3 and LAPACK
+      AUX_GEMM_TN,
+      AUX_GEMM_NN,
+      AUX_SYRK_TN,
+      AUX_TRSM,
+      AUX_GETRF,
+      AUX_GETRS,
+
       // Misc
       AUX_SQ,
       AUX_SIGN,
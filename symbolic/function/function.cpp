@@ -126,6 +126,10 @@ namespace CasADi{
     evaluate();
   }
 
+  void Function::evaluateBatch(const std::vector<std::vector<Matrix<double> > >& arg, BatchSink& sink, int nthreads){
+    (*this)->evaluateBatch(arg,sink,nthreads);
+  }
+
   int Function::getNumInputNonzeros() const{
     return (*this)->getNumInputNonzeros();
   }
@@ -29,6 +29,24 @@ namespace CasADi{
   
   /** Forward declaration of internal class */
   class FunctionInternal;
+
+#ifndef SWIG
+  /** \brief Receives the outputs of a batched evaluation, see Function::evaluateBatch
+      The calls are serialized, so an implementation need not be thread safe,
+      but the order of the evaluations is not guaranteed when several threads are used.
+  */
+  class BatchSink{
+  public:
+    /// Destructor
+    virtual ~BatchSink(){}
+    
+    /** \brief Called once for each evaluation in the batch with the outputs of the function
+     * The outputs are not copied: res[i] points to output i of the evaluating instance
+     * and is only valid until the call returns.
+     */
+    virtual void operator()(int ind, const std::vector<const Matrix<double>*>& res) = 0;
+  };
+#endif // SWIG
   
   /** \brief General function
       
@@ -152,6 +170,16 @@ namespace CasADi{
   
     /// the same as evaluate()
     void solve();
+
+#ifndef SWIG
+    /** \brief Evaluate for a batch of inputs, passing the outputs to a sink
+     * arg[k][i] is input i of evaluation k. Empty entries take the value that the input had
+     * when evaluateBatch was called. With nthreads>1 and OpenMP support, the evaluations are
+     * distributed over threads, each using its own deep copy of the function. The inputs and
+     * outputs of the function are restored on return.
+     */
+    void evaluateBatch(const std::vector<std::vector<Matrix<double> > >& arg, BatchSink& sink, int nthreads=1);
+#endif // SWIG
     
     //@{
     /** \brief Generate a Jacobian function of output oind with respect to input iind
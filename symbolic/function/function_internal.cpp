@@ -39,6 +39,10 @@
 #include <ctime>
 #endif // WITH_DL 
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif // WITH_OPENMP
+
 using namespace std;
 
 namespace CasADi{
@@ -47,6 +51,9 @@ namespace CasADi{
     setOption("name","unnamed_function"); // name of the function
     addOption("verbose",                  OT_BOOLEAN,             false,          "Verbose evaluation -- for debugging");
     addOption("ad_mode",                  OT_STRING,              "automatic",    "How to calculate the Jacobians.","forward: only forward mode|reverse: only adjoint mode|automatic: a heuristic decides which is more appropriate");
+    addOption("coloring_ordering",        OT_STRING,              "default",      "Vertex ordering in the graph coloring of the Jacobian and Hessian sparsity patterns","default: natural ordering for Jacobians, largest first for Hessians|natural|largest_first|smallest_last|incidence_degree");
+    addOption("coloring_threads",         OT_INTEGER,             1,              "Number of threads for speculative parallel coloring of the Jacobian sparsity patterns, requires OpenMP");
+    addOption("bidirectional_coloring",   OT_BOOLEAN,             false,          "Also try to combine forward and adjoint directional derivatives when ad_mode is automatic. Pays off for Jacobians with both dense rows and dense columns, but the extra colorings can be as expensive as the unidirectional ones");
     addOption("user_data",                OT_VOIDPTR,             GenericType(),  "A user-defined field that can be used to identify the function or pass additional information");
     addOption("monitor",                  OT_STRINGVECTOR,        GenericType(),  "Monitors to be activated","inputs|outputs");
     addOption("regularity_check",         OT_BOOLEAN,             true,           "Throw exceptions when NaN or Inf appears during evaluation");
@@ -69,7 +76,9 @@ namespace CasADi{
     for(vector<vector<WeakRef> >::iterator i=derivative_fcn_.begin(); i!=derivative_fcn_.end(); ++i){
       for(vector<WeakRef>::iterator j=i->begin(); j!=i->end(); ++j){
         if(!j->isNull()){
-          *j = getcopy(j->shared(),already_copied);
+          // Only keep cached derivatives that have been copied as well, others are regenerated
+          SharedObject cached = getcopy(j->shared(),already_copied);
+          *j = cached.isNull() ? WeakRef() : WeakRef(cached);
         }
       }
     }
@@ -282,6 +291,12 @@ namespace CasADi{
     }
   }
 
+  void FunctionInternal::log(const char* msg) const{
+    if(verbose()){
+      cout << "CasADi log message: " << msg << endl;
+    }
+  }
+
   void FunctionInternal::log(const string& fcn, const string& msg) const{
     if(verbose()){
       cout << "CasADi log message: In \"" << fcn << "\" --- " << msg << endl;
@@ -1121,12 +1136,33 @@ namespace CasADi{
       casadi_error("FunctionInternal::jac: Unknown ad_mode \"" << getOption("ad_mode") << "\". Possible values are \"forward\", \"reverse\" and \"automatic\".");
     }
   
+    // Vertex ordering for the coloring
+    int ordering;
+    if(getOption("coloring_ordering")=="default"){
+      ordering = symmetric ? 1 : 0;
+    } else if(getOption("coloring_ordering")=="natural"){
+      ordering = 0;
+    } else if(getOption("coloring_ordering")=="largest_first"){
+      ordering = 1;
+    } else if(getOption("coloring_ordering")=="smallest_last"){
+      ordering = 2;
+    } else if(getOption("coloring_ordering")=="incidence_degree"){
+      ordering = 3;
+    } else {
+      casadi_error("FunctionInternal::getPartition: Unknown coloring_ordering \"" << getOption("coloring_ordering") << "\".");
+    }
+
+    // Use speculative parallel coloring?
+    int coloring_threads = getOption("coloring_threads");
+    casadi_assert_message(coloring_threads>=1, "FunctionInternal::getPartition: coloring_threads must be positive");
+    bool parallel = coloring_threads>1;
+  
     // Get seed matrices by graph coloring
     if(symmetric){
   
       // Star coloring if symmetric
       log("FunctionInternal::getPartition starColoring");
-      D1 = A.starColoring();
+      D1 = A.starColoring(ordering);
       casadi_log("Star coloring completed: " << D1.size2() << " directional derivatives needed (" << A.size1() << " without coloring).");
     
     } else {
@@ -1153,7 +1189,12 @@ namespace CasADi{
         // Perform the coloring
         if(fwd){
           log("FunctionInternal::getPartition unidirectional coloring (forward mode)");
-          D1 = AT.unidirectionalColoring(A,best_coloring);
+          if(parallel){
+            D1 = AT.unidirectionalColoringParallel(A,coloring_threads,ordering);
+            if(D1.size2()>best_coloring) D1 = Sparsity();
+          } else {
+            D1 = AT.unidirectionalColoring(A,best_coloring,ordering);
+          }
           if(D1.isNull()){
             if(verbose()) cout << "Forward mode coloring interrupted (more than " << best_coloring << " needed)." << endl; 
           } else {
@@ -1164,7 +1205,12 @@ namespace CasADi{
         } else {
           log("FunctionInternal::getPartition unidirectional coloring (adjoint mode)");
           int max_colorings_to_test = best_coloring/adj_penalty;
-          D2 = A.unidirectionalColoring(AT,max_colorings_to_test);        
+          if(parallel){
+            D2 = A.unidirectionalColoringParallel(AT,coloring_threads,ordering);
+            if(D2.size2()>max_colorings_to_test) D2 = Sparsity();
+          } else {
+            D2 = A.unidirectionalColoring(AT,max_colorings_to_test,ordering);
+          }
           if(D2.isNull()){
             if(verbose()) cout << "Adjoint mode coloring interrupted (more than " << max_colorings_to_test << " needed)." << endl; 
           } else {
@@ -1175,6 +1221,24 @@ namespace CasADi{
         }
       }
 
+      // Try to combine forward and adjoint directions if both modes are allowed and it has been requested
+      if(test_ad_fwd && test_ad_adj && getOption("bidirectional_coloring")){
+        // Cost of the best unidirectional coloring, counting adjoint directions adj_penalty times
+        int best_cost = D2.isNull() ? best_coloring : adj_penalty*best_coloring;
+        if(best_cost>2){
+          log("FunctionInternal::getPartition bidirectional coloring");
+          Sparsity D1_bi, D2_bi;
+          AT.bidirectionalColoring(D1_bi,D2_bi,A,adj_penalty,best_cost);
+          if(D1_bi.isNull()){
+            if(verbose()) cout << "Bidirectional coloring interrupted (cost " << best_cost << " or more)." << endl;
+          } else {
+            if(verbose()) cout << "Bidirectional coloring completed: " << D1_bi.size2() << " forward and " << D2_bi.size2() << " adjoint directional derivatives needed (" 
+                               << (D1.isNull() ? 0 : D1.size2()) << " forward and " << (D2.isNull() ? 0 : D2.size2()) << " adjoint with unidirectional coloring)." << endl;
+            D1 = D1_bi;
+            D2 = D2_bi;
+          }
+        }
+      }
     }
     log("FunctionInternal::getPartition end");
   }
@@ -2566,6 +2630,101 @@ namespace CasADi{
     }
   }
 
+  void FunctionInternal::evaluateBatch(const vector<vector<DMatrix> >& arg, BatchSink& sink, int nthreads){
+    assertInit();
+    int n = arg.size();
+    
+#ifndef WITH_OPENMP
+    // Serial evaluation if OpenMP is not available
+    nthreads = 1;
+#endif // WITH_OPENMP
+    nthreads = std::max(1,std::min(nthreads,n));
+
+    // Inputs and outputs before the call: missing inputs are taken from here and both are restored on return
+    vector<DMatrix> input0(getNumInputs()), output0(getNumOutputs());
+    for(int i=0; i<input0.size(); ++i) input0[i] = input(i);
+    for(int i=0; i<output0.size(); ++i) output0[i] = output(i);
+
+    // One instance of the function for each thread, the first thread uses this instance
+    vector<Function> instances(nthreads);
+    instances[0] = shared_from_this<Function>();
+    for(int t=1; t<nthreads; ++t){
+      instances[t] = deepcopy(instances[0]);
+    }
+    
+    // Outputs passed to the sink, referring to the outputs of the instance of each thread
+    vector<vector<const DMatrix*> > res(nthreads,vector<const DMatrix*>(getNumOutputs()));
+    for(int t=0; t<nthreads; ++t){
+      for(int i=0; i<res[t].size(); ++i){
+        res[t][i] = &instances[t].output(i);
+      }
+    }
+
+    // Error messages encountered in the parallel region
+    string error_message;
+    bool failed = false;
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+#endif // WITH_OPENMP
+    for(int k=0; k<n; ++k){
+#ifdef WITH_OPENMP
+      int t = omp_get_thread_num();
+#else // WITH_OPENMP
+      int t = 0;
+#endif // WITH_OPENMP
+      Function& f = instances[t];
+
+      // Skip the remaining evaluations after a failure
+      bool skip;
+#ifdef WITH_OPENMP
+#pragma omp critical(evaluate_batch)
+#endif // WITH_OPENMP
+      skip = failed;
+      if(skip) continue;
+
+      try{
+        // Pass the inputs
+        casadi_assert_message(arg[k].size()<=f.getNumInputs(),"FunctionInternal::evaluateBatch: evaluation " << k << " has " << arg[k].size() << " inputs, but the function only has " << f.getNumInputs() << ".");
+        for(int i=0; i<input0.size(); ++i){
+          f.setInput(i<arg[k].size() && !arg[k][i].isEmpty() ? arg[k][i] : input0[i],i);
+        }
+        
+        // Evaluate
+        f.evaluate();
+        
+      } catch(exception& ex){
+#ifdef WITH_OPENMP
+#pragma omp critical(evaluate_batch)
+#endif // WITH_OPENMP
+        {
+          if(!failed) error_message = ex.what();
+          failed = true;
+        }
+        continue;
+      }
+        
+      // Pass the result to the sink, one at a time
+#ifdef WITH_OPENMP
+#pragma omp critical(evaluate_batch)
+#endif // WITH_OPENMP
+      {
+        try{
+          if(!failed) sink(k,res[t]);
+        } catch(exception& ex){
+          error_message = ex.what();
+          failed = true;
+        }
+      }
+    }
+
+    // Restore the inputs and outputs
+    for(int i=0; i<input0.size(); ++i) input(i).set(input0[i]);
+    for(int i=0; i<output0.size(); ++i) output(i).set(output0[i]);
+    
+    casadi_assert_message(!failed,"FunctionInternal::evaluateBatch failed: " << error_message);
+  }
+
   void FunctionInternal::evaluateD(MXNode* node, const DMatrixPtrV& arg, DMatrixPtrV& res, std::vector<int>& itmp, std::vector<double>& rtmp) {
                              
     // Set up timers for profiling
@@ -63,6 +63,9 @@ namespace CasADi{
     /** \brief  Evaluate */
     virtual void evaluate() = 0;
 
+    /** \brief  Evaluate for a batch of inputs */
+    virtual void evaluateBatch(const std::vector<std::vector<Matrix<double> > >& arg, BatchSink& sink, int nthreads);
+
     /** \brief Initialize
         Initialize and make the object ready for setting arguments and evaluation. This method is typically called after setting options but before evaluating. 
         If passed to another class (in the constructor), this class should invoke this function when initialized. */
@@ -297,6 +300,9 @@ namespace CasADi{
     /** \brief  Log the status of the solver */
     void log(const std::string& msg) const;
 
+    /** \brief  Log the status of the solver, no string is constructed unless verbose */
+    void log(const char* msg) const;
+
     /** \brief  Log the status of the solver, function given */
     void log(const std::string& fcn, const std::string& msg) const;
 
@@ -0,0 +1,73 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef INCOMPLETE_LU_HPP
+#define INCOMPLETE_LU_HPP
+
+#include "linear_solver.hpp"
+
+namespace CasADi{
+  
+  // Forward declaration of internal class
+  class IncompleteLUInternal;
+
+  /** \brief  Incomplete LU factorization without fill-in, ILU(0)
+      The factors are restricted to the sparsity pattern of the matrix, so the memory
+      requirement is linear in the number of nonzeros. The solution is only approximate,
+      the class is intended as a preconditioner for iterative linear solvers.
+      Diagonal entries missing in the sparsity pattern are added to the factors.
+      @copydoc LinearSolver_doc
+      \author Joel Andersson 
+      \date 2014
+  */
+  class IncompleteLU : public LinearSolver{
+  public:
+  
+    /// Default (empty) constructor
+    IncompleteLU();
+  
+    /// Create a linear solver given a sparsity pattern
+    explicit IncompleteLU(const Sparsity& sp, int nrhs=1);
+
+    /// Access functions of the node
+    IncompleteLUInternal* operator->();
+
+    /// Const access functions of the node
+    const IncompleteLUInternal* operator->() const;
+  
+    /// Check if the node is pointing to the right type of object
+    virtual bool checkNode() const;
+
+    /// Static creator function
+#ifdef SWIG
+    %callback("%s_cb");
+#endif
+    static LinearSolver creator(const Sparsity& sp, int nrhs){ return IncompleteLU(sp,nrhs);}
+#ifdef SWIG
+    %nocallback;
+#endif
+
+  };
+
+} // namespace CasADi
+
+#endif //INCOMPLETE_LU_HPP
@@ -0,0 +1,143 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include "incomplete_lu_internal.hpp"
+#include "../std_vector_tools.hpp"
+#include <cmath>
+
+using namespace std;
+namespace CasADi{
+
+  IncompleteLUInternal::IncompleteLUInternal(const Sparsity& sparsity, int nrhs) : LinearSolverInternal(sparsity,nrhs){
+  }
+
+  IncompleteLUInternal::~IncompleteLUInternal(){
+  }
+
+  void IncompleteLUInternal::init(){
+    // Call the base class initializer
+    LinearSolverInternal::init();
+
+    // Compressed row storage of the pattern is the compressed column storage of the transpose
+    vector<int> mapping;
+    Sparsity spT = input(LINSOL_A).sparsity().transpose(mapping);
+    const vector<int>& spT_colind = spT.colind();
+    const vector<int>& spT_row = spT.row();
+
+    // Add missing diagonal entries, structurally zero in the matrix but possibly not in the factors
+    int n = nrow();
+    rowind_.resize(n+1);
+    col_.clear();
+    mapping_.clear();
+    diag_.resize(n);
+    rowind_[0] = 0;
+    for(int i=0; i<n; ++i){
+      diag_[i] = -1;
+      for(int el=spT_colind[i]; el<=spT_colind[i+1]; ++el){
+        // Insert the diagonal before the first entry to the right of it
+        if(diag_[i]<0 && (el==spT_colind[i+1] || spT_row[el]>=i)){
+          diag_[i] = col_.size();
+          if(el==spT_colind[i+1] || spT_row[el]>i){
+            col_.push_back(i);
+            mapping_.push_back(-1);
+          }
+        }
+        if(el<spT_colind[i+1]){
+          col_.push_back(spT_row[el]);
+          mapping_.push_back(mapping[el]);
+        }
+      }
+      rowind_[i+1] = col_.size();
+    }
+
+    // Allocate memory
+    lu_.resize(col_.size());
+    iw_.resize(n,-1);
+  }
+
+  void IncompleteLUInternal::prepare(){
+    prepared_ = false;
+
+    // Copy the nonzeros to compressed row storage
+    const vector<double>& a = input(LINSOL_A).data();
+    for(int el=0; el<lu_.size(); ++el) lu_[el] = mapping_[el]<0 ? 0 : a[mapping_[el]];
+
+    // Gaussian elimination restricted to the sparsity pattern, row by row (IKJ variant)
+    int n = nrow();
+    for(int i=0; i<n; ++i){
+      // Mark the nonzeros of row i
+      for(int el=rowind_[i]; el<rowind_[i+1]; ++el) iw_[col_[el]] = el;
+
+      // Eliminate the entries to the left of the diagonal, in increasing column order
+      for(int el=rowind_[i]; el<diag_[i]; ++el){
+        int k = col_[el];
+        lu_[el] /= lu_[diag_[k]];
+        double l_ik = lu_[el];
+
+        // Update the remaining entries of row i that are in the pattern
+        for(int el2=diag_[k]+1; el2<rowind_[k+1]; ++el2){
+          int j = iw_[col_[el2]];
+          if(j>=0) lu_[j] -= l_ik*lu_[el2];
+        }
+      }
+
+      // Unmark
+      for(int el=rowind_[i]; el<rowind_[i+1]; ++el) iw_[col_[el]] = -1;
+
+      // Make sure that the pivot is nonzero
+      casadi_assert_message(lu_[diag_[i]]!=0, "IncompleteLUInternal::prepare: zero pivot in row " << i);
+    }
+    
+    prepared_ = true;
+  }
+
+  void IncompleteLUInternal::solve(double* x, int nrhs, bool transpose){
+    int n = nrow();
+    for(int r=0; r<nrhs; ++r){
+      if(!transpose){
+        // Forward substitution with the unit lower triangular factor
+        for(int i=0; i<n; ++i){
+          for(int el=rowind_[i]; el<diag_[i]; ++el) x[i] -= lu_[el]*x[col_[el]];
+        }
+
+        // Backward substitution with the upper triangular factor
+        for(int i=n-1; i>=0; --i){
+          for(int el=diag_[i]+1; el<rowind_[i+1]; ++el) x[i] -= lu_[el]*x[col_[el]];
+          x[i] /= lu_[diag_[i]];
+        }
+      } else {
+        // Forward substitution with the transpose of the upper triangular factor
+        for(int i=0; i<n; ++i){
+          x[i] /= lu_[diag_[i]];
+          for(int el=diag_[i]+1; el<rowind_[i+1]; ++el) x[col_[el]] -= lu_[el]*x[i];
+        }
+
+        // Backward substitution with the transpose of the unit lower triangular factor
+        for(int i=n-1; i>=0; --i){
+          for(int el=rowind_[i]; el<diag_[i]; ++el) x[col_[el]] -= lu_[el]*x[i];
+        }
+      }
+      x += n;
+    }
+  }
+
+} // namespace CasADi
@@ -0,0 +1,72 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef INCOMPLETE_LU_INTERNAL_HPP
+#define INCOMPLETE_LU_INTERNAL_HPP
+
+#include "incomplete_lu.hpp"
+#include "linear_solver_internal.hpp"
+
+/// \cond INTERNAL
+
+namespace CasADi{
+  
+  class IncompleteLUInternal : public LinearSolverInternal{
+  public:
+    // Constructor
+    IncompleteLUInternal(const Sparsity& sparsity, int nrhs);
+        
+    // Destructor
+    virtual ~IncompleteLUInternal();
+    
+    /** \brief  Clone */
+    virtual IncompleteLUInternal* clone() const{ return new IncompleteLUInternal(*this);}
+
+    // Initialize
+    virtual void init();
+    
+    // Prepare the factorization
+    virtual void prepare();
+
+    // Solve the system of equations
+    virtual void solve(double* x, int nrhs, bool transpose);
+
+    // Sparsity pattern of the factors, compressed row storage
+    std::vector<int> rowind_, col_;
+
+    // Position of the diagonal in each row
+    std::vector<int> diag_;
+
+    // For each nonzero in compressed row storage, the corresponding nonzero in compressed column storage
+    std::vector<int> mapping_;
+
+    // Unit lower triangular factor L below the diagonal, upper triangular factor U on and above
+    std::vector<double> lu_;
+
+    // Work vector: position of the nonzeros in the current row, -1 if not in the pattern
+    std::vector<int> iw_;
+  };  
+
+} // namespace CasADi
+
+/// \endcond
+#endif //INCOMPLETE_LU_INTERNAL_HPP
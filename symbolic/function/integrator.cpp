@@ -55,6 +55,12 @@ namespace CasADi{
   void Integrator::integrate(double t_out){
     (*this)->integrate(t_out);
   }
+
+  Matrix<double> Integrator::interpolate(double t){
+    Matrix<double> x = (*this)->x0();
+    (*this)->interpolate(t,x);
+    return x;
+  }
     
   bool Integrator::checkNode() const{
     return dynamic_cast<const IntegratorInternal*>(get())!=0;
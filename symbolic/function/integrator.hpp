@@ -195,6 +195,11 @@ namespace CasADi{
     /// Integrate forward until a specified time point 
     void integrate(double t_out);
 
+    /** \brief Differential state at a time within the last step taken (dense output)
+     * The state is interpolated, no integration steps are taken.
+     */
+    Matrix<double> interpolate(double t);
+
     /** \brief Reset the backward problem
      * Time will be set to tf and backward state to input(INTEGRATOR_RX0)
      */
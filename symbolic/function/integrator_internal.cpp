@@ -28,6 +28,7 @@
 #include "../sx/sx_tools.hpp"
 #include "mx_function.hpp"
 #include "sx_function.hpp"
+#include "parallelizer.hpp"
 
 INPUTSCHEME(IntegratorInput)
 OUTPUTSCHEME(IntegratorOutput)
@@ -45,6 +46,8 @@ namespace CasADi{
     addOption("tf",                       OT_REAL,        1.0, "End of the time horizon");
     addOption("augmented_options",        OT_DICTIONARY,  GenericType(), "Options to be passed down to the augmented integrator, if one is constructed.");
     addOption("expand_augmented",         OT_BOOLEAN,     true, "If DAE callback functions are SXFunction, have augmented DAE callback function also be SXFunction.");
+    addOption("sensitivity_group_size",   OT_INTEGER,     0, "Maximum number of forward or adjoint sensitivity directions integrated by one augmented integrator. If more directions are requested, they are split into groups that are integrated independently. 0 means no limit.");
+    addOption("sensitivity_parallelization", OT_STRING,   "serial", "Parallelization of the evaluation of the sensitivity groups","serial|openmp|mpi");
   
     // Negative number of parameters for consistancy checking
     np_ = -1;
@@ -658,8 +661,91 @@ namespace CasADi{
   }
 
   Function IntegratorInternal::getDerivative(int nfwd, int nadj){
+    // Integrate all directions with the same augmented integrator if possible
+    int group_size = getOption("sensitivity_group_size");
+    if(group_size<=0 || nfwd+nadj<=group_size) return getAugmentedDerivative(nfwd,nadj);
     log("IntegratorInternal::getDerivative","begin");
 
+    // Split the directions into groups, forward and adjoint directions are not mixed
+    vector<int> group_nfwd, group_nadj;
+    for(int offset=0; offset<nfwd; offset+=group_size){
+      group_nfwd.push_back(std::min(group_size,nfwd-offset));
+      group_nadj.push_back(0);
+    }
+    for(int offset=0; offset<nadj; offset+=group_size){
+      group_nfwd.push_back(0);
+      group_nadj.push_back(std::min(group_size,nadj-offset));
+    }
+    int ngroups = group_nfwd.size();
+
+    // Derivative function for each group, evaluated independently of each other
+    // When the groups are evaluated in parallel, each group gets its own copy of the DAE and
+    // derivative functions, which are otherwise shared (e.g. f_ for all adjoint groups)
+    bool parallel = getOption("sensitivity_parallelization")!="serial";
+    vector<Function> groups(ngroups);
+    for(int g=0; g<ngroups; ++g){
+      groups[g] = getAugmentedDerivative(group_nfwd[g],group_nadj[g]);
+      if(parallel){
+        groups[g].init();
+        groups[g] = deepcopy(groups[g]);
+      }
+    }
+    Parallelizer parallelizer(groups);
+    parallelizer.setOption("parallelization",getOption("sensitivity_parallelization"));
+    parallelizer.init();
+
+    // All inputs of the return function: nondifferentiated inputs, forward seeds and adjoint seeds
+    static const char* in_names[INTEGRATOR_NUM_IN] = {"x0","p","z0","rx0","rp","rz0"};
+    static const char* out_names[INTEGRATOR_NUM_OUT] = {"xf","qf","zf","rxf","rqf","rzf"};
+    vector<MX> ret_in;
+    ret_in.reserve(INTEGRATOR_NUM_IN*(1+nfwd) + INTEGRATOR_NUM_OUT*nadj);
+    stringstream ss;
+    for(int dir=-1; dir<nfwd; ++dir){
+      for(int i=0; i<INTEGRATOR_NUM_IN; ++i){
+        ss.str("");
+        ss << in_names[i];
+        if(dir>=0) ss << "_" << dir;
+        ret_in.push_back(MX::sym(ss.str(),input(i).sparsity()));
+      }
+    }
+    for(int dir=0; dir<nadj; ++dir){
+      for(int i=0; i<INTEGRATOR_NUM_OUT; ++i){
+        ss.str("");
+        ss << out_names[i] << "_" << dir;
+        ret_in.push_back(MX::sym(ss.str(),output(i).sparsity()));
+      }
+    }
+
+    // Arguments of the groups: the nondifferentiated inputs followed by the seeds of the group
+    vector<MX> par_in;
+    vector<MX>::const_iterator seed_it = ret_in.begin()+INTEGRATOR_NUM_IN;
+    for(int g=0; g<ngroups; ++g){
+      par_in.insert(par_in.end(),ret_in.begin(),ret_in.begin()+INTEGRATOR_NUM_IN);
+      int nseed = INTEGRATOR_NUM_IN*group_nfwd[g] + INTEGRATOR_NUM_OUT*group_nadj[g];
+      par_in.insert(par_in.end(),seed_it,seed_it+nseed);
+      seed_it += nseed;
+    }
+    vector<MX> par_out = parallelizer.call(par_in);
+
+    // Nondifferentiated results from the first group, followed by the sensitivities of each group
+    vector<MX> ret_out(par_out.begin(),par_out.begin()+INTEGRATOR_NUM_OUT);
+    ret_out.reserve(INTEGRATOR_NUM_OUT*(1+nfwd) + INTEGRATOR_NUM_IN*nadj);
+    vector<MX>::const_iterator sens_it = par_out.begin();
+    for(int g=0; g<ngroups; ++g){
+      sens_it += INTEGRATOR_NUM_OUT;
+      int nsens = INTEGRATOR_NUM_OUT*group_nfwd[g] + INTEGRATOR_NUM_IN*group_nadj[g];
+      ret_out.insert(ret_out.end(),sens_it,sens_it+nsens);
+      sens_it += nsens;
+    }
+    log("IntegratorInternal::getDerivative","end");
+
+    // Create derivative function and return
+    return MXFunction(ret_in,ret_out);
+  }
+
+  Function IntegratorInternal::getAugmentedDerivative(int nfwd, int nadj){
+    log("IntegratorInternal::getAugmentedDerivative","begin");
+
     // Form the augmented DAE
     AugOffset offset;
     std::pair<Function,Function> aug_dae = getAugmented(nfwd,nadj,offset);
@@ -838,7 +924,7 @@ namespace CasADi{
       if(nrz_>0) dd[INTEGRATOR_RZ0] = *zf_aug_it++;
       ret_out.insert(ret_out.end(),dd.begin(),dd.end());
     }
-    log("IntegratorInternal::getDerivative","end");
+    log("IntegratorInternal::getAugmentedDerivative","end");
   
     // Create derivative function and return
     return MXFunction(ret_in,ret_out);
@@ -869,6 +955,10 @@ namespace CasADi{
     log("IntegratorInternal::reset","end");
   }
 
+  void IntegratorInternal::interpolate(double t, DMatrix& x){
+    casadi_error("IntegratorInternal::interpolate: dense output not supported by the integrator \"" << getOption("name") << "\"");
+  }
+
   void IntegratorInternal::resetB(){
     log("IntegratorInternal::resetB","begin");
 
@@ -68,6 +68,9 @@ namespace CasADi{
     /** \brief  Integrate backward until a specified time point */
     virtual void integrateB(double t_out) = 0;
 
+    /** \brief  Interpolate the differential state at a time within the last step taken (dense output) */
+    virtual void interpolate(double t, DMatrix& x);
+
     /** \brief  evaluate */
     virtual void evaluate();
 
@@ -83,6 +86,9 @@ namespace CasADi{
     /// Generate a function that calculates nfwd forward derivatives and nadj adjoint derivatives
     virtual Function getDerivative(int nfwd, int nadj);
 
+    /// Generate a function that calculates nfwd forward and nadj adjoint derivatives with one augmented integrator
+    Function getAugmentedDerivative(int nfwd, int nadj);
+
     /** \brief Calculate the jacobian of output oind with respect to input iind */
     virtual Function getJacobian(int iind, int oind, bool compact, bool symmetric);
 
@@ -77,6 +77,13 @@ namespace CasADi{
     (*this)->spSolve(X,B,transpose);
   }
 
+  std::vector<int> LinearSolver::getInertia() const{
+    casadi_assert_message(prepared(), "LinearSolver::getInertia: the matrix has not been factorized");
+    std::vector<int> ret(3);
+    (*this)->inertia(ret[0],ret[1],ret[2]);
+    return ret;
+  }
+
 
 } // namespace CasADi
 
@@ -99,6 +99,13 @@ enum LinsolOutput{
 #endif // SWIG
 /// \endcond
 
+    /** \brief Inertia of the factorized matrix: the number of positive, negative and zero eigenvalues
+        Returned as a vector [n_pos, n_neg, n_zero]. Only available for solvers for symmetric matrices
+        that compute it, e.g. SparseLDL. Can be used by optimization methods to check if a KKT matrix
+        needs to be regularized.
+    */
+    std::vector<int> getInertia() const;
+
     /// Create a solve node
     MX solve(const MX& A, const MX& B, bool transpose=false);
 
@@ -372,6 +372,10 @@ namespace CasADi{
     casadi_error("LinearSolverInternal::solve not defined for class " << typeid(*this).name());
   }
 
+  void LinearSolverInternal::inertia(int& n_pos, int& n_neg, int& n_zero) const{
+    casadi_error("LinearSolverInternal::inertia not defined for class " << typeid(*this).name());
+  }
+
 
 } // namespace CasADi
  
@@ -59,6 +59,9 @@ namespace CasADi{
     // Solve the system of equations
     virtual void solve(double* x, int nrhs, bool transpose);
 
+    // Number of positive, negative and zero eigenvalues of the factorized matrix
+    virtual void inertia(int& n_pos, int& n_neg, int& n_zero) const;
+
     /// Create a solve node
     MX solve(const MX& A, const MX& B, bool transpose);
 
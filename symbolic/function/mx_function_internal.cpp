@@ -22,6 +22,8 @@
 
 #include "mx_function_internal.hpp"
 #include "../mx/call_function.hpp"
+#include "../mx/getnonzeros.hpp"
+#include "../mx/setnonzeros.hpp"
 #include "../mx/mx_tools.hpp"
 #include "../sx/sx_tools.hpp"
 
@@ -40,6 +42,7 @@ namespace CasADi{
   MXFunctionInternal::MXFunctionInternal(const std::vector<MX>& inputv, const std::vector<MX>& outputv) :
     XFunctionInternal<MXFunction,MXFunctionInternal,MX,MXNode>(inputv,outputv) {
   
+    addOption("optimize_graph", OT_BOOLEAN, false, "Fold constant subexpressions and fuse nonzero mappings in the expression graph during initialization. The output expressions are not modified.");
     setOption("name", "unnamed_mx_function");
   
     // Check for inputs that are not symbolic primitives
@@ -81,6 +84,12 @@ namespace CasADi{
     // Call the init function of the base class
     XFunctionInternal<MXFunction,MXFunctionInternal,MX,MXNode>::init();    
 
+    // Expressions the algorithm is built from, simplified if requested
+    vector<MX> outputv = outputv_;
+    if(getOption("optimize_graph")){
+      optimizeGraph(outputv);
+    }
+
     // Stack used to sort the computational graph
     stack<MXNode*> s;
 
@@ -88,15 +97,22 @@ namespace CasADi{
     vector<MXNode*> nodes;
   
     // Add the list of nodes
+    vector<MXNode*> roots;
     int ind=0;
-    for(vector<MX>::iterator it = outputv_.begin(); it != outputv_.end(); ++it, ++ind){
+    for(vector<MX>::iterator it = outputv.begin(); it != outputv.end(); ++it, ++ind){
       // Add outputs to the list
       s.push(static_cast<MXNode*>(it->get()));
       sort_depth_first(s,nodes);
+      roots.push_back(static_cast<MXNode*>(it->get()));
     
       // A null pointer means an output instruction
       nodes.push_back(static_cast<MXNode*>(0));
     }
+
+    // Resort to reduce the size of the work vector
+    if(getOption("topological_sorting")=="sethi-ullman"){
+      resort_sethi_ullman(nodes,roots);
+    }
   
     // Make sure that all inputs have been added also // TODO REMOVE THIS
     for(vector<MX>::iterator it = inputv_.begin(); it != inputv_.end(); ++it){
@@ -152,7 +168,7 @@ namespace CasADi{
         // Add input and output argument
         if(op==OP_OUTPUT){
           ae.arg.resize(1);
-          ae.arg[0] = outputv_.at(curr_oind)->temp;
+          ae.arg[0] = outputv.at(curr_oind)->temp;
           ae.res.resize(1);
           ae.res[0] = curr_oind++;
         } else {
@@ -276,6 +292,8 @@ namespace CasADi{
       }
     }
   
+    // Statistics on the work vector
+    stats_["work_size"] = worksize;
     if(verbose()){
       if(live_variables){
         cout << "Using live variables: work array is " <<  worksize << " instead of " << nodes.size() << endl;
@@ -305,6 +323,12 @@ namespace CasADi{
     }
     itmp_.resize(nitmp);
     rtmp_.resize(nrtmp);
+
+    // Total number of nonzeros in the work vector
+    int work_nnz = 0;
+    for(int i=0; i<work_.size(); ++i) work_nnz += work_[i].first.size();
+    stats_["work_nnz"] = work_nnz;
+    if(verbose()) cout << "Work array holds " << work_nnz << " nonzeros" << endl;
   
     // Reset the temporary variables
     for(int i=0; i<nodes.size(); ++i){
@@ -627,6 +651,233 @@ namespace CasADi{
     }
   }
 
+  MX MXFunctionInternal::fuseNonzeros(const MX& e){
+    if(e->getOp()==OP_GETNONZEROS){
+      vector<int> nz = static_cast<const GetNonzeros*>(e.get())->getAll();
+      const MX& x = e->dep(0);
+      if(x->getOp()==OP_RESHAPE){
+        // Indexing into a reshape: the nonzero order is unchanged by the reshape
+        return fuseNonzeros(x->dep(0)->getGetNonzeros(e.sparsity(),nz));
+      } else if(x->getOp()==OP_SETNONZEROS || x->getOp()==OP_ADDNONZEROS){
+        // Indexing into an assignment: the nonzero of the assigned expression for each nonzero, -1 if untouched
+        vector<int> nz_set = x->getOp()==OP_SETNONZEROS ? static_cast<const SetNonzeros<false>*>(x.get())->getAll() : static_cast<const SetNonzeros<true>*>(x.get())->getAll();
+        vector<int> src(x.size(),-1);
+        for(int k=0; k<nz_set.size(); ++k){
+          if(nz_set[k]>=0) src[nz_set[k]] = k;
+        }
+
+        // Read directly from the target if all requested nonzeros are untouched or, for an assignment,
+        // from the assigned expression if all of them are assigned
+        bool all_untouched = true, all_assigned = x->getOp()==OP_SETNONZEROS;
+        vector<int> nz_x(nz.size());
+        for(int k=0; k<nz.size(); ++k){
+          if(nz[k]<0){
+            nz_x[k] = -1;
+          } else {
+            nz_x[k] = src[nz[k]];
+            if(nz_x[k]<0){
+              all_assigned = false;
+            } else {
+              all_untouched = false;
+            }
+          }
+        }
+        if(all_untouched){
+          return fuseNonzeros(x->dep(0)->getGetNonzeros(e.sparsity(),nz));
+        } else if(all_assigned){
+          return fuseNonzeros(x->dep(1)->getGetNonzeros(e.sparsity(),nz_x));
+        }
+      }
+    } else if(e->getOp()==OP_SETNONZEROS){
+      const MX& y = e->dep(0);
+      const MX& x = e->dep(1);
+      vector<int> nz = static_cast<const SetNonzeros<false>*>(e.get())->getAll();
+
+      // The nonzero of x assigned to each nonzero of the result, -1 if untouched
+      vector<int> src(y.size(),-1);
+      for(int k=0; k<nz.size(); ++k){
+        if(nz[k]>=0) src[nz[k]] = k;
+      }
+    
+      // If all nonzeros are assigned, the result does not depend on y
+      bool assign_all = true;
+      for(vector<int>::const_iterator i=src.begin(); i!=src.end() && assign_all; ++i){
+        assign_all = *i>=0;
+      }
+      if(assign_all){
+        return fuseNonzeros(x->getGetNonzeros(y.sparsity(),src));
+      }
+
+      // Skip previous assignments to y that are completely overwritten
+      MX y_eff = y;
+      while(y_eff->getOp()==OP_SETNONZEROS){
+        vector<int> nz_prev = static_cast<const SetNonzeros<false>*>(y_eff.get())->getAll();
+        bool overwritten = true;
+        for(vector<int>::const_iterator i=nz_prev.begin(); i!=nz_prev.end() && overwritten; ++i){
+          overwritten = *i<0 || src[*i]>=0;
+        }
+        if(!overwritten) break;
+        y_eff = y_eff->dep(0);
+      }
+      if(y_eff.get()!=y.get()){
+        return x->getSetNonzeros(y_eff,nz);
+      }
+    }
+    return e;
+  }
+
+  void MXFunctionInternal::optimizeGraph(std::vector<MX>& ex){
+    // Sort the expression graph
+    stack<MXNode*> s;
+    vector<MXNode*> nodes;
+    for(vector<MX>::iterator it = ex.begin(); it != ex.end(); ++it){
+      s.push(static_cast<MXNode*>(it->get()));
+      sort_depth_first(s,nodes);
+    }
+    int nodes_before = nodes.size();
+
+    // Mark each node with its (1-based) place in the sorted graph
+    for(int i=0; i<nodes.size(); ++i){
+      nodes[i]->temp = i+1;
+    }
+
+    // Replacement expressions for the outputs of each node and whether they differ from the original
+    vector<vector<MX> > replacement(nodes.size());
+    vector<bool> changed(nodes.size(),false);
+    
+    // Arguments and results of a node, and pointers to them
+    vector<MX> arg, res;
+    MXPtrV input_p, output_p;
+    DMatrixPtrV dinput_p, doutput_p;
+    vector<DMatrix> dinput;
+    vector<int> itmp;
+    vector<double> rtmp;
+    int num_folded = 0;
+    
+    for(int i=0; i<nodes.size(); ++i){
+      MXNode* n = nodes[i];
+      MX self;
+      self.assignNode(n);
+      
+      // Outputs of a multiple output node are taken from the parent
+      if(n->isOutputNode()){
+        int p = n->dep(0)->temp-1;
+        changed[i] = changed[p];
+        replacement[i].resize(1);
+        replacement[i][0] = changed[i] ? replacement[p].at(n->getFunctionOutput()) : self;
+        continue;
+      }
+      
+      // Get the (possibly replaced) arguments
+      arg.resize(n->ndep());
+      bool args_changed = false, args_constant = n->ndep()>0;
+      for(int j=0; j<n->ndep(); ++j){
+        if(n->dep(j).isNull()){
+          arg[j] = MX();
+          args_constant = false;
+        } else {
+          int k = n->dep(j)->temp-1;
+          arg[j] = replacement[k][0];
+          args_changed = args_changed || changed[k];
+          args_constant = args_constant && arg[j]->getOp()==OP_CONST;
+        }
+      }
+      
+      // Constant folding
+      int op = n->getOp();
+      if(args_constant && !n->isMultipleOutput() && op!=OP_CALL && op!=OP_ASSERTION){
+        dinput.resize(arg.size());
+        dinput_p.resize(arg.size());
+        bool consistent = true;
+        for(int j=0; j<arg.size(); ++j){
+          dinput[j] = arg[j]->getMatrixValue();
+          consistent = consistent && dinput[j].sparsity()==arg[j].sparsity();
+          dinput_p[j] = &dinput[j];
+        }
+        if(consistent){
+          DMatrix value(n->sparsity(),0);
+          doutput_p.resize(1);
+          doutput_p[0] = &value;
+          size_t ni=0, nr=0;
+          n->nTmp(ni,nr);
+          itmp.resize(ni);
+          rtmp.resize(nr);
+          n->evaluateD(dinput_p,doutput_p,itmp,rtmp);
+          replacement[i].resize(1);
+          replacement[i][0] = MX(value);
+          changed[i] = true;
+          num_folded++;
+          continue;
+        }
+      }
+      
+      // Recreate the node if any of the arguments changed
+      int nout = n->getNumOutputs();
+      res.resize(nout);
+      if(args_changed){
+        input_p.resize(arg.size());
+        for(int j=0; j<arg.size(); ++j){
+          input_p[j] = arg[j].isNull() ? 0 : &arg[j];
+        }
+        output_p.resize(nout);
+        for(int j=0; j<nout; ++j){
+          output_p[j] = &res[j];
+        }
+        n->evaluateMX(input_p,output_p);
+        
+        // Keep the original node if the sparsity pattern is not preserved
+        changed[i] = true;
+        for(int j=0; j<nout && changed[i]; ++j){
+          changed[i] = !res[j].isNull() && res[j].sparsity()==n->sparsity(j);
+        }
+      }
+      if(changed[i]){
+        replacement[i] = res;
+      } else {
+        replacement[i].resize(1);
+        replacement[i][0] = self;
+      }
+
+      // Fuse nonzero mappings
+      if(nout==1){
+        MX fused = fuseNonzeros(replacement[i][0]);
+        if(fused.get()!=replacement[i][0].get()){
+          replacement[i][0] = fused;
+          changed[i] = true;
+        }
+      }
+    }
+
+    // Replace the output expressions
+    for(vector<MX>::iterator it = ex.begin(); it != ex.end(); ++it){
+      *it = replacement[(*it)->temp-1][0];
+    }
+    
+    // Reset the temporary variables
+    for(int i=0; i<nodes.size(); ++i){
+      nodes[i]->temp = 0;
+    }
+    replacement.clear();
+    
+    // Count the nodes in the simplified graph
+    nodes.clear();
+    for(vector<MX>::iterator it = ex.begin(); it != ex.end(); ++it){
+      s.push(static_cast<MXNode*>(it->get()));
+      sort_depth_first(s,nodes);
+    }
+    for(int i=0; i<nodes.size(); ++i){
+      nodes[i]->temp = 0;
+    }
+    
+    // Statistics
+    stats_["graph_nodes_before"] = nodes_before;
+    stats_["graph_nodes_after"] = static_cast<int>(nodes.size());
+    stats_["graph_nodes_folded"] = num_folded;
+    if(verbose()){
+      cout << "MXFunctionInternal::optimizeGraph: " << nodes_before << " nodes reduced to " << nodes.size() << ", " << num_folded << " constant subexpressions folded" << endl;
+    }
+  }
+
   void MXFunctionInternal::evalMX(const std::vector<MX>& arg1, std::vector<MX>& res1, 
                                   const std::vector<std::vector<MX> >& fseed, std::vector<std::vector<MX> >& fsens, 
                                   const std::vector<std::vector<MX> >& aseed, std::vector<std::vector<MX> >& asens){
@@ -987,25 +1238,36 @@ namespace CasADi{
     log("MXFunctionInternal::evalMX end");
   }
 
+  namespace{
+    /// Expansion of a function call. Holds references to the function and the argument expressions, so that the
+    /// nodes addressed by the key of the entry stay alive, and cannot be recycled for other expressions
+    struct CallCacheEntry{
+      Function fcn;
+      vector<SX> arg;
+      vector<SX> res;
+    };
+  } // namespace
+
   void MXFunctionInternal::evalSXsparse(const std::vector<SX>& input_s, std::vector<SX>& output_s, 
                                   const std::vector<std::vector<SX> >& fwdSeed, std::vector<std::vector<SX> >& fwdSens, 
                                   const std::vector<std::vector<SX> >& adjSeed, std::vector<std::vector<SX> >& adjSens){
     casadi_assert_message(fwdSens.empty(),"Not implemented");
     casadi_assert_message(adjSeed.empty(),"Not implemented");
       
-    // Create a work array
+    // Create a work array, each element has a fixed sparsity pattern
     vector<SX> swork(work_.size());
-    for(vector<AlgEl>::iterator it=algorithm_.begin(); it!=algorithm_.end(); it++){
-      if(it->op!=OP_OUTPUT){
-        for(int i=0; i<it->res.size(); ++i){
-          if (it->res[i]>=0)
-            swork[it->res[i]] = SX(it->data->sparsity(i));
-        }
-      }
+    for(int i=0; i<swork.size(); ++i){
+      swork[i] = SX(work_[i].first.sparsity());
     }
 
     // Create a temporary vector
     vector<SXElement> rtmp(rtmp_.size());
+
+    // Expansions of function calls, indexed by the function and the expressions of the arguments
+    typedef map<vector<const void*>,CallCacheEntry> CallCache;
+    CallCache call_cache;
+    vector<const void*> call_key;
+    int num_calls = 0, num_reused = 0;
   
     // Evaluate all of the nodes of the algorithm: should only evaluate nodes that have not yet been calculated!
     vector<SX*> sxarg;
@@ -1030,9 +1292,61 @@ namespace CasADi{
           int ind = it->res[c];
           sxres[c] = ind<0 ? 0 : &swork[ind];
         }
-        it->data->evaluateSX(sxarg,sxres,itmp_,rtmp);
+
+        if(it->op==OP_CALL){
+          // Identify the call by the function and the nonzeros of the arguments
+          call_key.clear();
+          call_key.push_back(it->data->getFunction().get());
+          for(int c=0; c<sxarg.size(); ++c){
+            if(sxarg[c]==0){
+              call_key.push_back(0);
+            } else {
+              call_key.push_back(sxarg[c]->sparsity().get());
+              for(vector<SXElement>::const_iterator k=sxarg[c]->begin(); k!=sxarg[c]->end(); ++k){
+                call_key.push_back(k->get());
+              }
+            }
+          }
+          num_calls++;
+          
+          // Expand the function call only if it has not been expanded for the same arguments before
+          pair<CallCache::iterator,bool> ins = call_cache.insert(make_pair(call_key,CallCacheEntry()));
+          vector<SX>& call_res = ins.first->second.res;
+          if(ins.second){
+            // Keep the function and the arguments alive
+            ins.first->second.fcn = it->data->getFunction();
+            vector<SX>& call_arg = ins.first->second.arg;
+            call_arg.resize(sxarg.size());
+            for(int c=0; c<sxarg.size(); ++c){
+              if(sxarg[c]!=0) call_arg[c] = *sxarg[c];
+            }
+
+            // Calculate all outputs, they may be needed at another call site
+            call_res.resize(sxres.size());
+            vector<SX*> call_res_p(sxres.size());
+            for(int c=0; c<sxres.size(); ++c){
+              call_res_p[c] = &call_res[c];
+            }
+            it->data->evaluateSX(sxarg,call_res_p,itmp_,rtmp);
+          } else {
+            num_reused++;
+          }
+          
+          // Pass the result
+          for(int c=0; c<sxres.size(); ++c){
+            if(sxres[c]!=0){
+              *sxres[c] = call_res[c];
+            }
+          }
+        } else {
+          it->data->evaluateSX(sxarg,sxres,itmp_,rtmp);
+        }
       }
     }
+    
+    if(verbose() && num_calls>0){
+      cout << "MXFunctionInternal::evalSXsparse: " << num_calls << " function calls expanded, " << num_reused << " reused an earlier expansion" << endl;
+    }
   }
 
   SXFunction MXFunctionInternal::expand(const std::vector<SX>& inputvsx ){
@@ -1128,7 +1442,6 @@ namespace CasADi{
     for(vector<AlgEl>::const_iterator it=algorithm_.begin(); it!=algorithm_.end(); ++it){
       switch(it->op){
       case OP_CALL:
-      case OP_SOLVE:
         gen.addDependency(it->data->getFunction());
         break;
       default:
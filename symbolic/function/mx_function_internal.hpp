@@ -139,6 +139,19 @@ namespace CasADi{
     
     /// Allocate tape
     void allocTape(std::vector<std::pair<std::pair<int,int>,MX> >& tape);
+
+    /** \brief Simplify the expression graph of the expressions ex, a copy of the outputs, before sorting
+     * Subexpressions depending only on constants are evaluated and nodes depending on simplified
+     * subexpressions are recreated. Nonzero mappings (indexing, assignments, reshapes) are fused.
+     */
+    void optimizeGraph(std::vector<MX>& ex);
+
+    /** \brief Fuse a nonzero mapping with the nonzero mapping it depends on
+     * Indexing into a reshape or into an assignment reads directly from the reshaped, assigned or original
+     * expression. An assignment of all nonzeros does not depend on the target, and earlier assignments that
+     * are completely overwritten are skipped. Returns e if nothing can be fused.
+     */
+    static MX fuseNonzeros(const MX& e);
     
     // print an element of an algorithm
     void print(std::ostream &stream, const AlgEl& el) const;
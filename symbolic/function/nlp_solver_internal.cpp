@@ -49,6 +49,9 @@ namespace CasADi{
     addOption("iteration_callback_ignore_errors", OT_BOOLEAN, false, "If set to true, errors thrown by iteration_callback will be ignored.");
     addOption("ignore_check_vec",   OT_BOOLEAN,  false,          "If set to true, the input shape of F will not be checked.");
     addOption("warn_initial_bounds",OT_BOOLEAN,  false,          "Warn if the initial guess does not satisfy LBX and UBX");
+    addOption("warm_start",         OT_BOOLEAN,  false,          "Initialize with the primal-dual solution of the previous call, overwriting X0, LAM_X0 and LAM_G0. Solvers that support it also reuse internal memory such as Hessian approximations.");
+    addOption("warm_start_shift_x", OT_INTEGER,  0,              "Shift the previous primal solution and bound multipliers this many entries towards the start before a warm start, repeating the trailing entries (time-shifted horizons).");
+    addOption("warm_start_shift_g", OT_INTEGER,  0,              "Shift the previous constraint multipliers this many entries towards the start before a warm start, repeating the trailing entries (time-shifted horizons).");
 
     // Legacy options, will go away. See #566.
     addOption("expand_f",           OT_BOOLEAN,  GenericType(),  "Expand the objective function in terms of scalar operations, i.e. MX->SX. Deprecated, use \"expand\" instead.");
@@ -142,6 +145,33 @@ namespace CasADi{
     }
   
     callback_step_ = getOption("iteration_callback_step");
+
+    // Warm start
+    warm_start_ = getOption("warm_start");
+    warm_start_shift_x_ = getOption("warm_start_shift_x");
+    warm_start_shift_g_ = getOption("warm_start_shift_g");
+    casadi_assert_message(warm_start_shift_x_>=0 && warm_start_shift_x_<=nx_, "NLPSolver: Option \"warm_start_shift_x\" out of range");
+    casadi_assert_message(warm_start_shift_g_>=0 && warm_start_shift_g_<=ng_, "NLPSolver: Option \"warm_start_shift_g\" out of range");
+    has_solution_ = false;
+  }
+
+  void NLPSolverInternal::shiftWarmStart(const vector<double>& prev, vector<double>& init, int n){
+    copy(prev.begin()+n,prev.end(),init.begin());
+    copy(prev.end()-n,prev.end(),init.end()-n);
+  }
+
+  bool NLPSolverInternal::warmStart(){
+    bool warm = warm_start_ && has_solution_;
+    if(warm){
+      log("Warm starting from the previous solution");
+      shiftWarmStart(output(NLP_SOLVER_X).data(),input(NLP_SOLVER_X0).data(),warm_start_shift_x_);
+      shiftWarmStart(output(NLP_SOLVER_LAM_X).data(),input(NLP_SOLVER_LAM_X0).data(),warm_start_shift_x_);
+      shiftWarmStart(output(NLP_SOLVER_LAM_G).data(),input(NLP_SOLVER_LAM_G0).data(),warm_start_shift_g_);
+    }
+
+    // The outputs are overwritten by this call, the solver sets the flag again after a successful solve
+    has_solution_ = false;
+    return warm;
   }
 
   void NLPSolverInternal::checkInitialBounds() { 
@@ -57,6 +57,15 @@ namespace CasADi{
     /// Warns the user about inital bounds, if option 'warn_initial_bounds' is true
     virtual void checkInitialBounds();
   
+    /** \brief Overwrite the initial guess with the (shifted) solution of the previous call
+     * Returns true if a warm start took place, i.e. if option "warm_start" is set
+     * and the last call since the initialization solved the problem successfully.
+     */
+    bool warmStart();
+
+    /// Shift a vector n entries towards the start, repeating the trailing entries (prev and init may coincide)
+    static void shiftWarmStart(const std::vector<double>& prev, std::vector<double>& init, int n);
+
     /// Set options that make the NLP solver more suitable for solving QPs
     virtual void setQPOptions() { };
 
@@ -111,6 +120,15 @@ namespace CasADi{
     /// Execute the callback function only after this amount of iterations
     int callback_step_;
   
+    /// Warm start from the previous solution
+    bool warm_start_;
+
+    /// Shift of the previous solution when warm starting
+    int warm_start_shift_x_, warm_start_shift_g_;
+
+    /// Did the last call solve the problem successfully, set by the solver at the end of evaluate
+    bool has_solution_;
+
     /// The NLP
     Function nlp_;
 
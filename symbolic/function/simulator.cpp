@@ -50,6 +50,20 @@ namespace CasADi{
   }
 
 
+  void Simulator::simulateBatch(const vector<Matrix<double> >& x0, const vector<Matrix<double> >& p, BatchSink& sink, int nthreads){
+    int n = std::max(x0.size(),p.size());
+    casadi_assert_message(x0.size()<=1 || x0.size()==n, "Simulator::simulateBatch: got " << x0.size() << " initial conditions for " << n << " trajectories");
+    casadi_assert_message(p.size()<=1 || p.size()==n, "Simulator::simulateBatch: got " << p.size() << " parameter sets for " << n << " trajectories");
+    
+    // Inputs of each trajectory
+    vector<vector<Matrix<double> > > arg(n,vector<Matrix<double> >(INTEGRATOR_NUM_IN));
+    for(int k=0; k<n; ++k){
+      if(!x0.empty()) arg[k][INTEGRATOR_X0] = x0.size()==1 ? x0.front() : x0[k];
+      if(!p.empty()) arg[k][INTEGRATOR_P] = p.size()==1 ? p.front() : p[k];
+    }
+    evaluateBatch(arg,sink,nthreads);
+  }
+
   SimulatorInternal* Simulator::operator->(){
     return static_cast<SimulatorInternal*>(Function::operator->());
   }
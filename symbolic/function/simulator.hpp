@@ -62,6 +62,15 @@ public:
   /// Output function equal to the state
   Simulator(const Integrator& integrator, const std::vector<double>& grid);
   Simulator(const Integrator& integrator, const Matrix<double>& grid);
+
+#ifndef SWIG
+  /** \brief Simulate a batch of trajectories
+  * Trajectory k starts from x0[k] with parameters p[k]. If x0 or p has a single entry, it is used
+  * for all trajectories, if it is empty, the current input is used. The outputs of each trajectory
+  * are passed to the sink as soon as they are available, see Function::evaluateBatch.
+  */
+  void simulateBatch(const std::vector<Matrix<double> >& x0, const std::vector<Matrix<double> >& p, BatchSink& sink, int nthreads=1);
+#endif // SWIG
   
   /// Access functions of the node.
   SimulatorInternal* operator->();
@@ -35,6 +35,7 @@ namespace CasADi{
   SimulatorInternal::SimulatorInternal(const Integrator& integrator, const Function& output_fcn, const vector<double>& grid) : integrator_(integrator), output_fcn_(output_fcn), grid_(grid){
     setOption("name","unnamed simulator");
     addOption("monitor",      OT_STRINGVECTOR, GenericType(),  "", "initial|step", true);
+    addOption("dense_output", OT_BOOLEAN,      false,          "Set the option \"dense_output\" of the integrator, if it has one, so that grid points between its steps are interpolated instead of rounded up to the end of a step. Integrators without the option (e.g. the SUNDIALS ones) always interpolate.");
   
     input_.scheme = SCHEME_IntegratorInput;
   }
@@ -53,6 +54,8 @@ namespace CasADi{
     if (!grid_.empty()) integrator_.setOption("t0",grid_[0]);
     // Let the integration time stop at the last point of the time grid.
     if (!grid_.empty()) integrator_.setOption("tf",grid_[grid_.size()-1]);
+    // Interpolate between the integrator steps for grid points that do not coincide with them
+    if (getOption("dense_output") && integrator_.hasOption("dense_output")) integrator_.setOption("dense_output",true);
   
     casadi_assert_message(isNonDecreasing(grid_),"The supplied time grid must be non-decreasing."); 
   
@@ -0,0 +1,81 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef SPARSE_LDL_HPP
+#define SPARSE_LDL_HPP
+
+#include "linear_solver.hpp"
+
+namespace CasADi{
+  
+  // Forward declaration of internal class
+  class SparseLDLInternal;
+
+  /** \brief  Sparse LDL^T factorization for symmetric, possibly indefinite matrices
+      The matrix is permuted with an approximate minimum degree ordering of its sparsity pattern,
+      after which the factor L is computed row by row ("up-looking") with the elimination tree.
+      D is diagonal, there is no pivoting during the factorization. Instead, pivots that are smaller in
+      magnitude than "pivot_tolerance" times the largest entry in their row are replaced by that value
+      (static pivoting), and the solution is improved with iterative refinement against the original matrix.
+      This makes the solver suited for quasi-definite KKT matrices and for matrices that are only
+      slightly singular, but less robust than LU with partial pivoting for general indefinite matrices.
+
+      The inertia of the matrix (the number of positive, negative and zero eigenvalues) is available
+      after the factorization with getInertia, the perturbed pivots are counted as zero eigenvalues.
+
+      Only the upper triangular part of the matrix is used, the sparsity pattern must be symmetric.
+      @copydoc LinearSolver_doc
+      \author Joel Andersson 
+      \date 2014
+  */
+  class SparseLDL : public LinearSolver{
+  public:
+  
+    /// Default (empty) constructor
+    SparseLDL();
+  
+    /// Create a linear solver given a sparsity pattern
+    explicit SparseLDL(const Sparsity& sp, int nrhs=1);
+
+    /// Access functions of the node
+    SparseLDLInternal* operator->();
+
+    /// Const access functions of the node
+    const SparseLDLInternal* operator->() const;
+  
+    /// Check if the node is pointing to the right type of object
+    virtual bool checkNode() const;
+
+    /// Static creator function
+#ifdef SWIG
+    %callback("%s_cb");
+#endif
+    static LinearSolver creator(const Sparsity& sp, int nrhs){ return SparseLDL(sp,nrhs);}
+#ifdef SWIG
+    %nocallback;
+#endif
+
+  };
+
+} // namespace CasADi
+
+#endif //SPARSE_LDL_HPP
@@ -0,0 +1,257 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include "sparse_ldl_internal.hpp"
+#include "../matrix/sparsity_internal.hpp"
+#include "../std_vector_tools.hpp"
+#include <cmath>
+#include <limits>
+
+using namespace std;
+namespace CasADi{
+
+  SparseLDLInternal::SparseLDLInternal(const Sparsity& sparsity, int nrhs) : LinearSolverInternal(sparsity,nrhs){
+    addOption("ordering",             OT_STRING,  "amd",  "Fill-reducing ordering","amd: approximate minimum degree|natural");
+    addOption("pivot_tolerance",      OT_REAL,    1e-8,   "Pivots smaller in magnitude than this, relative to the largest entry in the same row of the matrix, are replaced by this value with the sign of the pivot");
+    addOption("max_refinement_steps", OT_INTEGER, 3,      "Maximum number of iterative refinement steps when pivots have been perturbed");
+  }
+
+  SparseLDLInternal::~SparseLDLInternal(){
+  }
+
+  void SparseLDLInternal::init(){
+    // Call the base class initializer
+    LinearSolverInternal::init();
+
+    // Read options
+    pivot_tol_ = getOption("pivot_tolerance");
+    max_refinement_steps_ = getOption("max_refinement_steps");
+    casadi_assert_message(pivot_tol_>=0, "SparseLDLInternal::init: pivot_tolerance must be nonnegative");
+
+    const Sparsity& sp = input(LINSOL_A).sparsity();
+    casadi_assert_message(sp.isSymmetric(), "SparseLDLInternal::init: the sparsity pattern must be symmetric");
+    int n = nrow();
+
+    // Fill-reducing ordering, the permuted matrix is A(perm_,perm_)
+    if(n>0 && getOption("ordering")=="amd"){
+      perm_ = sp->approximateMinimumDegree(1);
+      perm_.resize(n);
+    } else {
+      perm_.resize(n);
+      for(int k=0; k<n; ++k) perm_[k] = k;
+    }
+    pinv_.resize(n);
+    for(int k=0; k<n; ++k) pinv_[perm_[k]] = k;
+
+    // Upper triangular part of the permuted matrix
+    const vector<int>& colind = sp.colind();
+    const vector<int>& row = sp.row();
+    c_colind_.resize(n+1);
+    fill(c_colind_.begin(),c_colind_.end(),0);
+    for(int cc=0; cc<n; ++cc){
+      for(int el=colind[cc]; el<colind[cc+1]; ++el){
+        int i = pinv_[row[el]], j = pinv_[cc];
+        if(i<=j) c_colind_[j+1]++;
+      }
+    }
+    for(int k=0; k<n; ++k) c_colind_[k+1] += c_colind_[k];
+    c_row_.resize(c_colind_[n]);
+    c_map_.resize(c_colind_[n]);
+    vector<int> next(c_colind_.begin(),c_colind_.end()-1);
+    for(int cc=0; cc<n; ++cc){
+      for(int el=colind[cc]; el<colind[cc+1]; ++el){
+        int i = pinv_[row[el]], j = pinv_[cc];
+        if(i<=j){
+          c_row_[next[j]] = i;
+          c_map_[next[j]++] = el;
+        }
+      }
+    }
+
+    // Elimination tree and number of nonzeros in each column of L
+    parent_.resize(n);
+    flag_.resize(n);
+    l_nz_.resize(n);
+    for(int k=0; k<n; ++k){
+      parent_[k] = -1;
+      flag_[k] = k;
+      l_nz_[k] = 0;
+      for(int el=c_colind_[k]; el<c_colind_[k+1]; ++el){
+        // Follow the path from i to the root of the tree, stop at the first node already flagged
+        for(int i=c_row_[el]; flag_[i]!=k; i=parent_[i]){
+          if(parent_[i]==-1) parent_[i] = k;
+          l_nz_[i]++;
+          flag_[i] = k;
+        }
+      }
+    }
+    l_colind_.resize(n+1);
+    l_colind_[0] = 0;
+    for(int k=0; k<n; ++k) l_colind_[k+1] = l_colind_[k] + l_nz_[k];
+
+    // Allocate memory
+    l_row_.resize(l_colind_[n]);
+    l_.resize(l_colind_[n]);
+    d_.resize(n);
+    pattern_.resize(n);
+    y_.resize(n);
+    r_.resize(n);
+    x0_.resize(n);
+    dy_.resize(n);
+    n_pos_ = n_neg_ = n_zero_ = 0;
+  }
+
+  void SparseLDLInternal::prepare(){
+    prepared_ = false;
+    const vector<double>& a = input(LINSOL_A).data();
+    int n = nrow();
+
+    // Largest entry in each row of the permuted matrix, for the thresholds of the static pivoting
+    fill(r_.begin(),r_.end(),0);
+    for(int j=0; j<n; ++j){
+      for(int el=c_colind_[j]; el<c_colind_[j+1]; ++el){
+        double a_ij = fabs(a[c_map_[el]]);
+        r_[j] = fmax(r_[j],a_ij);
+        r_[c_row_[el]] = fmax(r_[c_row_[el]],a_ij);
+      }
+    }
+    
+    // Compute L and D row by row
+    n_pos_ = n_neg_ = n_zero_ = 0;
+    for(int k=0; k<n; ++k){
+      // Scatter column k of the upper triangular part, the nonzero pattern of row k of L is given by the elimination tree
+      y_[k] = 0;
+      int top = n;
+      flag_[k] = k;
+      l_nz_[k] = 0;
+      for(int el=c_colind_[k]; el<c_colind_[k+1]; ++el){
+        int i = c_row_[el];
+        y_[i] += a[c_map_[el]];
+        int len;
+        for(len=0; flag_[i]!=k; i=parent_[i]){
+          pattern_[len++] = i;
+          flag_[i] = k;
+        }
+        while(len>0) pattern_[--top] = pattern_[--len];
+      }
+
+      // Sparse triangular solve for row k of L, in topological order
+      d_[k] = y_[k];
+      y_[k] = 0;
+      for(; top<n; ++top){
+        int i = pattern_[top];
+        double yi = y_[i];
+        y_[i] = 0;
+        int p2 = l_colind_[i] + l_nz_[i];
+        for(int p=l_colind_[i]; p<p2; ++p) y_[l_row_[p]] -= l_[p]*yi;
+        double l_ki = yi/d_[i];
+        d_[k] -= l_ki*yi;
+        l_row_[p2] = k;
+        l_[p2] = l_ki;
+        l_nz_[i]++;
+      }
+
+      // Inertia, pivots too small in magnitude are perturbed and counted as zero eigenvalues
+      double thres = pivot_tol_*(r_[k]>0 ? r_[k] : 1);
+      if(d_[k]>thres){
+        n_pos_++;
+      } else if(d_[k]<-thres){
+        n_neg_++;
+      } else {
+        casadi_assert_message(thres>0, "SparseLDLInternal::prepare: zero pivot in row " << perm_[k]);
+        d_[k] = d_[k]<0 ? -thres : thres;
+        n_zero_++;
+      }
+    }
+    
+    prepared_ = true;
+  }
+
+  void SparseLDLInternal::solveFactors(double* x) const{
+    int n = d_.size();
+
+    // Forward substitution with L
+    for(int j=0; j<n; ++j){
+      for(int p=l_colind_[j]; p<l_colind_[j+1]; ++p) x[l_row_[p]] -= l_[p]*x[j];
+    }
+    
+    // Diagonal
+    for(int j=0; j<n; ++j) x[j] /= d_[j];
+    
+    // Backward substitution with L'
+    for(int j=n-1; j>=0; --j){
+      for(int p=l_colind_[j]; p<l_colind_[j+1]; ++p) x[j] -= l_[p]*x[l_row_[p]];
+    }
+  }
+
+  void SparseLDLInternal::solve(double* x, int nrhs, bool transpose){
+    // The matrix is symmetric, transpose has no effect
+    const vector<double>& a = input(LINSOL_A).data();
+    int n = nrow();
+    bool refine = n_zero_>0 && max_refinement_steps_>0;
+    for(int r=0; r<nrhs; ++r){
+      // Solve in the permuted ordering
+      for(int k=0; k<n; ++k) y_[k] = x[perm_[k]];
+      if(refine) copy(y_.begin(),y_.end(),x0_.begin());
+      solveFactors(getPtr(y_));
+
+      // Iterative refinement with the unperturbed matrix, as long as the residual decreases.
+      // The residual is also checked after the last correction
+      double r_prev = numeric_limits<double>::infinity();
+      for(int step=0; refine && step<=max_refinement_steps_; ++step){
+        copy(x0_.begin(),x0_.end(),r_.begin());
+        for(int j=0; j<n; ++j){
+          for(int el=c_colind_[j]; el<c_colind_[j+1]; ++el){
+            int i = c_row_[el];
+            double a_ij = a[c_map_[el]];
+            r_[i] -= a_ij*y_[j];
+            if(i!=j) r_[j] -= a_ij*y_[i];
+          }
+        }
+        double r_norm = 0;
+        for(int k=0; k<n; ++k) r_norm = fmax(r_norm,fabs(r_[k]));
+        if(r_norm==0) break;
+        if(r_norm>=r_prev){
+          // The last correction increased the residual: revert to the previous iterate
+          for(int k=0; k<n; ++k) y_[k] -= dy_[k];
+          break;
+        }
+        if(step==max_refinement_steps_) break;
+        r_prev = r_norm;
+        copy(r_.begin(),r_.end(),dy_.begin());
+        solveFactors(getPtr(dy_));
+        for(int k=0; k<n; ++k) y_[k] += dy_[k];
+      }
+      
+      for(int k=0; k<n; ++k) x[perm_[k]] = y_[k];
+      x += n;
+    }
+  }
+
+  void SparseLDLInternal::inertia(int& n_pos, int& n_neg, int& n_zero) const{
+    n_pos = n_pos_;
+    n_neg = n_neg_;
+    n_zero = n_zero_;
+  }
+
+} // namespace CasADi
+
@@ -0,0 +1,90 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef SPARSE_LDL_INTERNAL_HPP
+#define SPARSE_LDL_INTERNAL_HPP
+
+#include "sparse_ldl.hpp"
+#include "linear_solver_internal.hpp"
+
+/// \cond INTERNAL
+
+namespace CasADi{
+  
+  class SparseLDLInternal : public LinearSolverInternal{
+  public:
+    // Constructor
+    SparseLDLInternal(const Sparsity& sparsity, int nrhs);
+        
+    // Destructor
+    virtual ~SparseLDLInternal();
+    
+    /** \brief  Clone */
+    virtual SparseLDLInternal* clone() const{ return new SparseLDLInternal(*this);}
+
+    // Initialize
+    virtual void init();
+    
+    // Prepare the factorization
+    virtual void prepare();
+
+    // Solve the system of equations
+    virtual void solve(double* x, int nrhs, bool transpose);
+
+    // Inertia of the factorized matrix
+    virtual void inertia(int& n_pos, int& n_neg, int& n_zero) const;
+
+    // Solve with the factors, in the permuted ordering
+    void solveFactors(double* x) const;
+
+    // Fill-reducing permutation and its inverse
+    std::vector<int> perm_, pinv_;
+
+    // Upper triangular part of the permuted matrix, compressed column storage, with the corresponding nonzeros of the matrix
+    std::vector<int> c_colind_, c_row_, c_map_;
+
+    // Elimination tree of the permuted matrix
+    std::vector<int> parent_;
+
+    // Strictly lower triangular factor L, compressed column storage
+    std::vector<int> l_colind_, l_row_;
+    std::vector<double> l_;
+
+    // Diagonal factor D
+    std::vector<double> d_;
+
+    // Work vectors
+    std::vector<int> l_nz_, pattern_, flag_;
+    std::vector<double> y_, r_, x0_, dy_;
+
+    // Options
+    double pivot_tol_;
+    int max_refinement_steps_;
+
+    // Inertia of the last factorization
+    int n_pos_, n_neg_, n_zero_;
+  };  
+
+} // namespace CasADi
+
+/// \endcond
+#endif //SPARSE_LDL_INTERNAL_HPP
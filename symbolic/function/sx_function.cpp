@@ -27,6 +27,7 @@
 #include <deque>
 #include <fstream>
 #include <sstream>
+#include <iterator>
 #include "../std_vector_tools.hpp"
 #include "../sx/sx_node.hpp"
 #include "../sx/sx_tools.hpp"
@@ -149,6 +150,24 @@ void SXFunction::clearSymbolic(){
   (*this)->clearSymbolic();
 }
 
+void SXFunction::save(const std::string& filename) const{
+  casadi_assert_message(isInit(),"SXFunction::save: Function not initialized.");
+  ofstream file(filename.c_str(), ios::out | ios::binary);
+  casadi_assert_message(file.good(),"SXFunction::save: Cannot open \"" << filename << "\" for writing.");
+  (*this)->serialize(file);
+  casadi_assert_message(file.good(),"SXFunction::save: Failed writing to \"" << filename << "\".");
+}
+
+SXFunction SXFunction::load(const std::string& filename){
+  // Read the whole file into memory, the deserialized function keeps its own copy of the data
+  ifstream file(filename.c_str(), ios::in | ios::binary);
+  casadi_assert_message(file.good(),"SXFunction::load: Cannot open \"" << filename << "\".");
+  vector<char> buf((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+  casadi_assert_message(!buf.empty(),"SXFunction::load: \"" << filename << "\" is empty.");
+  const char* buf_begin = &buf.front();
+  return SXFunctionInternal::deserialize(buf_begin, buf_begin+buf.size());
+}
+
 SXFunction::SXFunction(const MXFunction& f){
   MXFunction f2 = f;
   SXFunction t = f2.expand();
@@ -192,6 +192,22 @@ namespace CasADi{
   
     /** \brief Clear the function from its symbolic representation, to free up memory, no symbolic evaluations are possible after this */
     void clearSymbolic();
+
+    /** \brief Save the initialized function to a binary file
+     *
+     * The file contains the algorithm, the input and output sparsity patterns as well as the cached
+     * Jacobian sparsity patterns and any cached (SXFunction) Jacobian and derivative functions.
+     * The symbolic representation is not saved.
+     */
+    void save(const std::string& filename) const;
+
+    /** \brief Load an initialized function from a binary file created with save
+     *
+     * The returned function is initialized and behaves as after a call to clearSymbolic: it can be
+     * evaluated numerically, propagate sparsity patterns, generate code and return the cached
+     * derivative functions, but no symbolic evaluations are possible.
+     */
+    static SXFunction load(const std::string& filename);
  
     /** \brief Get all the free variables of the function */
     std::vector<SXElement> getFree() const;
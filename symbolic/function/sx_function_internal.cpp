@@ -25,6 +25,7 @@
 #include <limits>
 #include <stack>
 #include <deque>
+#include <list>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
@@ -40,12 +41,88 @@ namespace CasADi{
 
   using namespace std;
 
+  namespace{
+    // Identification of the binary format written by SXFunctionInternal::serialize
+    const char serialize_magic[8] = {'C','A','S','A','D','I','S','X'};
+    const int serialize_version = 1;
+
+    // Write plain data to a binary stream
+    template<typename T>
+    void writeBinary(ostream& stream, const T& v){
+      stream.write(reinterpret_cast<const char*>(&v), sizeof(T));
+    }
+
+    // Write a vector of plain data to a binary stream, prefixed by its length
+    template<typename T>
+    void writeBinary(ostream& stream, const vector<T>& v){
+      writeBinary(stream,int(v.size()));
+      if(!v.empty()) stream.write(reinterpret_cast<const char*>(&v.front()), v.size()*sizeof(T));
+    }
+
+    // Write a string to a binary stream, prefixed by its length
+    void writeBinary(ostream& stream, const string& v){
+      writeBinary(stream,int(v.size()));
+      stream.write(v.data(), v.size());
+    }
+
+    // Write a sparsity pattern to a binary stream
+    void writeBinary(ostream& stream, const Sparsity& sp){
+      writeBinary(stream,sp.size1());
+      writeBinary(stream,sp.size2());
+      writeBinary(stream,sp.colind());
+      writeBinary(stream,sp.row());
+    }
+
+    // Read plain data from a memory buffer
+    template<typename T>
+    void readBinary(const char*& buf, const char* buf_end, T& v){
+      casadi_assert_message(buf_end-buf>=ptrdiff_t(sizeof(T)),"SXFunction::load: Unexpected end of data.");
+      copy(buf, buf+sizeof(T), reinterpret_cast<char*>(&v));
+      buf += sizeof(T);
+    }
+
+    // Read a vector of plain data from a memory buffer
+    template<typename T>
+    void readBinary(const char*& buf, const char* buf_end, vector<T>& v){
+      int n;
+      readBinary(buf,buf_end,n);
+      casadi_assert_message(n>=0 && (buf_end-buf)/ptrdiff_t(sizeof(T))>=n,"SXFunction::load: Unexpected end of data.");
+      v.resize(n);
+      if(n>0) copy(buf, buf+n*sizeof(T), reinterpret_cast<char*>(&v.front()));
+      buf += n*sizeof(T);
+    }
+
+    // Read a string from a memory buffer
+    void readBinary(const char*& buf, const char* buf_end, string& v){
+      vector<char> tmp;
+      readBinary(buf,buf_end,tmp);
+      v.assign(tmp.begin(),tmp.end());
+    }
+
+    // Read a sparsity pattern from a memory buffer
+    void readBinary(const char*& buf, const char* buf_end, Sparsity& sp){
+      int nrow, ncol;
+      vector<int> colind, row;
+      readBinary(buf,buf_end,nrow);
+      readBinary(buf,buf_end,ncol);
+      readBinary(buf,buf_end,colind);
+      readBinary(buf,buf_end,row);
+      sp = Sparsity(nrow,ncol,colind,row);
+    }
+
+    // Get a cached SXFunction that can be serialized, or a null pointer
+    const SXFunctionInternal* serializable(const Function& f){
+      const SXFunctionInternal* n = dynamic_cast<const SXFunctionInternal*>(f.get());
+      return n!=0 && n->isInit() && n->free_vars_.empty() ? n : 0;
+    }
+  } // namespace
 
   SXFunctionInternal::SXFunctionInternal(const vector<SX >& inputv, const vector<SX >& outputv) : 
-    XFunctionInternal<SXFunction,SXFunctionInternal,SX,SXNode>(inputv,outputv) {
+    XFunctionInternal<SXFunction,SXFunctionInternal,SX,SXNode>(inputv,outputv), has_symbolic_(true) {
     setOption("name","unnamed_sx_function");
     addOption("just_in_time_sparsity", OT_BOOLEAN,false,"Propagate sparsity patterns using just-in-time compilation to a CPU or GPU using OpenCL");
     addOption("just_in_time_opencl", OT_BOOLEAN,false,"Just-in-time compilation for numeric evaluation using OpenCL (experimental)");
+    addOption("simulate_cache", OT_BOOLEAN,false,"Count the work vector accesses missing a simulated LRU cache, reported as the statistic work_cache_misses (always done when verbose)");
 
     // Check for duplicate entries among the input expressions
     bool has_duplicates = false;
@@ -87,6 +164,33 @@ namespace CasADi{
 #endif // WITH_OPENCL
   }
 
+  SXFunctionInternal::SXFunctionInternal(const vector<Sparsity>& sp_in, const vector<Sparsity>& sp_out) : 
+    XFunctionInternal<SXFunction,SXFunctionInternal,SX,SXNode>(vector<SX>(),vector<SX>()), has_symbolic_(false) {
+    setOption("name","unnamed_sx_function");
+    addOption("just_in_time_sparsity", OT_BOOLEAN,false,"Propagate sparsity patterns using just-in-time compilation to a CPU or GPU using OpenCL");
+    addOption("just_in_time_opencl", OT_BOOLEAN,false,"Just-in-time compilation for numeric evaluation using OpenCL (experimental)");
+    addOption("simulate_cache", OT_BOOLEAN,false,"Count the work vector accesses missing a simulated LRU cache, reported as the statistic work_cache_misses (always done when verbose)");
+
+    // Allocate space for inputs
+    setNumInputs(sp_in.size());
+    for(int i=0; i<sp_in.size(); ++i)
+      input(i) = DMatrix(sp_in[i]);
+  
+    // Allocate space for outputs
+    setNumOutputs(sp_out.size());
+    for(int i=0; i<sp_out.size(); ++i)
+      output(i) = DMatrix(sp_out[i]);
+
+    // Reset OpenCL memory
+#ifdef WITH_OPENCL
+    kernel_ = 0;
+    program_ = 0;
+    sp_fwd_kernel_ = 0;
+    sp_adj_kernel_ = 0;
+    sp_program_ = 0;
+#endif // WITH_OPENCL
+  }
+
   SXFunctionInternal::~SXFunctionInternal(){
     // Free OpenCL memory
 #ifdef WITH_OPENCL
@@ -95,6 +199,53 @@ namespace CasADi{
 #endif // WITH_OPENCL
   }
 
+  int SXFunctionInternal::workCacheMisses() const{
+    // Work vector elements accessed by the algorithm
+    int worksize = 0;
+    for(vector<AlgEl>::const_iterator it=algorithm_.begin(); it!=algorithm_.end(); ++it){
+      if(it->op!=OP_OUTPUT) worksize = max(worksize,it->i0+1);
+    }
+    int nlines = worksize/CACHE_LINE_SIZE + 1;
+  
+    // Lines in the cache, most recently used first
+    list<int> cache;
+    vector<list<int>::iterator> cache_pos(nlines,cache.end());
+  
+    // Simulate the accesses: the arguments are read, then the result is written
+    int misses = 0;
+    int acc[3];
+    for(vector<AlgEl>::const_iterator it=algorithm_.begin(); it!=algorithm_.end(); ++it){
+      int nacc = 0;
+      switch(it->op){
+        case OP_CONST:
+        case OP_PARAMETER:
+        case OP_INPUT: acc[nacc++] = it->i0; break;
+        case OP_OUTPUT: acc[nacc++] = it->i1; break;
+        default:
+          acc[nacc++] = it->i1;
+          if(casadi_math<double>::ndeps(it->op)==2) acc[nacc++] = it->i2;
+          acc[nacc++] = it->i0;
+      }
+      for(int k=0; k<nacc; ++k){
+        int line = acc[k]/CACHE_LINE_SIZE;
+        if(cache_pos[line]!=cache.end()){
+          // Hit: move to front
+          cache.splice(cache.begin(),cache,cache_pos[line]);
+        } else {
+          // Miss: load the line, evicting the least recently used one
+          misses++;
+          if(cache.size()==CACHE_LINES){
+            cache_pos[cache.back()] = cache.end();
+            cache.pop_back();
+          }
+          cache.push_front(line);
+        }
+        cache_pos[line] = cache.begin();
+      }
+    }
+    return misses;
+  }
+
   void SXFunctionInternal::evaluate(){
     double time_start=0;
     double time_stop=0;
@@ -297,6 +448,19 @@ namespace CasADi{
   
     // Call the init function of the base class
     XFunctionInternal<SXFunction,SXFunctionInternal,SX,SXNode>::init();
+
+    // Without a symbolic representation (clearSymbolic or deserialization), keep the existing algorithm
+    if(!has_symbolic_){
+      stats_["work_size"] = static_cast<int>(work_.size());
+      if(getOption("simulate_cache")){
+        stats_["work_cache_misses"] = workCacheMisses();
+      }
+      initJustInTime();
+      if(verbose()){
+        cout << "SXFunctionInternal::init No symbolic representation, reusing the algorithm of " << getOption("name") << " (" << algorithm_.size() << " elementary operations)" << endl;
+      }
+      return;
+    }
   
     // Stack used to sort the computational graph
     stack<SXNode*> s;
@@ -305,6 +469,7 @@ namespace CasADi{
     vector<SXNode*> nodes;
 
     // Add the list of nodes
+    vector<SXNode*> roots;
     int ind=0;
     for(vector<SX >::iterator it = outputv_.begin(); it != outputv_.end(); ++it, ++ind){
       int nz=0;
@@ -312,11 +477,17 @@ namespace CasADi{
         // Add outputs to the list
         s.push(itc->get());
         sort_depth_first(s,nodes);
+        roots.push_back(itc->get());
       
         // A null pointer means an output instruction
         nodes.push_back(static_cast<SXNode*>(0));
       }
     }
+
+    // Resort to reduce the size of the work vector
+    if(getOption("topological_sorting")=="sethi-ullman"){
+      resort_sethi_ullman(nodes,roots);
+    }
   
     // Make sure that all inputs have been added also // TODO REMOVE THIS
     for(vector<SX >::iterator it = inputv_.begin(); it != inputv_.end(); ++it){
@@ -470,12 +641,18 @@ namespace CasADi{
       }
     }
   
+    // Statistics on the work vector
+    stats_["work_size"] = worksize;
+    if(verbose() || getOption("simulate_cache")){
+      stats_["work_cache_misses"] = workCacheMisses();
+    }
     if(verbose()){
       if(live_variables){
         cout << "Using live variables: work array is " <<  worksize << " instead of " << nodes.size() << endl;
       } else {
         cout << "Live variables disabled." << endl;
       }
+      cout << "Work vector accesses missing a simulated " << CACHE_LINES << " x " << CACHE_LINE_SIZE*sizeof(double) << " byte LRU cache: " << stats_["work_cache_misses"] << endl;
     }
   
     // Allocate work vectors (symbolic/numeric)
@@ -525,27 +702,8 @@ namespace CasADi{
       }
     }
   
-    // Initialize just-in-time compilation for numeric evaluation using OpenCL
-    just_in_time_opencl_ = getOption("just_in_time_opencl");
-    if(just_in_time_opencl_){
-#ifdef WITH_OPENCL
-      freeOpenCL();
-      allocOpenCL();
-#else // WITH_OPENCL
-      casadi_error("Option \"just_in_time_opencl\" true requires CasADi to have been compiled with WITH_OPENCL=ON");
-#endif // WITH_OPENCL
-    }
-
-    // Initialize just-in-time compilation for sparsity propagation using OpenCL
-    just_in_time_sparsity_ = getOption("just_in_time_sparsity");
-    if(just_in_time_sparsity_){
-#ifdef WITH_OPENCL
-      spFreeOpenCL();
-      spAllocOpenCL();
-#else // WITH_OPENCL
-      casadi_error("Option \"just_in_time_sparsity\" true requires CasADi to have been compiled with WITH_OPENCL=ON");
-#endif // WITH_OPENCL
-    }
+    // Initialize just-in-time compilation
+    initJustInTime();
     
     if (CasadiOptions::profiling && CasadiOptions::profilingBinary) {
       
@@ -596,6 +754,30 @@ namespace CasADi{
     }
   }
 
+  void SXFunctionInternal::initJustInTime(){
+    // Initialize just-in-time compilation for numeric evaluation using OpenCL
+    just_in_time_opencl_ = getOption("just_in_time_opencl");
+    if(just_in_time_opencl_){
+#ifdef WITH_OPENCL
+      freeOpenCL();
+      allocOpenCL();
+#else // WITH_OPENCL
+      casadi_error("Option \"just_in_time_opencl\" true requires CasADi to have been compiled with WITH_OPENCL=ON");
+#endif // WITH_OPENCL
+    }
+
+    // Initialize just-in-time compilation for sparsity propagation using OpenCL
+    just_in_time_sparsity_ = getOption("just_in_time_sparsity");
+    if(just_in_time_sparsity_){
+#ifdef WITH_OPENCL
+      spFreeOpenCL();
+      spAllocOpenCL();
+#else // WITH_OPENCL
+      casadi_error("Option \"just_in_time_sparsity\" true requires CasADi to have been compiled with WITH_OPENCL=ON");
+#endif // WITH_OPENCL
+    }
+  }
+
   void SXFunctionInternal::evalSXsparse(const vector<SX>& arg1, vector<SX>& res1, 
                                   const vector<vector<SX> >& fseed, vector<vector<SX> >& fsens, 
                                   const vector<vector<SX> >& aseed, vector<vector<SX> >& asens){
@@ -763,6 +945,195 @@ namespace CasADi{
     inputv_.clear();
     outputv_.clear();
     s_work_.clear();
+    has_symbolic_ = false;
+  }
+
+  void SXFunctionInternal::serialize(ostream &stream) const{
+    // Header
+    stream.write(serialize_magic,sizeof(serialize_magic));
+    writeBinary(stream,serialize_version);
+
+    // The function and its cached derivatives
+    serializeFunction(stream);
+  }
+
+  SXFunction SXFunctionInternal::deserialize(const char*& buf, const char* buf_end){
+    // Header
+    casadi_assert_message(buf_end-buf>=sizeof(serialize_magic) && equal(serialize_magic,serialize_magic+sizeof(serialize_magic),buf),"SXFunction::load: Not a serialized SXFunction.");
+    buf += sizeof(serialize_magic);
+    int version;
+    readBinary(buf,buf_end,version);
+    casadi_assert_message(version==serialize_version,"SXFunction::load: Unsupported format version " << version << ", expected " << serialize_version << ".");
+
+    // The function and its cached derivatives
+    return deserializeFunction(buf,buf_end);
+  }
+
+  void SXFunctionInternal::serializeFunction(ostream &stream) const{
+    casadi_assert_message(free_vars_.empty(),"Cannot serialize \"" << getOption("name") << "\" since variables " << free_vars_ << " are free.");
+
+    // Name
+    writeBinary(stream,getOption("name").toString());
+
+    // Input and output sparsity patterns
+    writeBinary(stream,getNumInputs());
+    for(int i=0; i<getNumInputs(); ++i) writeBinary(stream,input(i).sparsity());
+    writeBinary(stream,getNumOutputs());
+    for(int i=0; i<getNumOutputs(); ++i) writeBinary(stream,output(i).sparsity());
+
+    // The algorithm with the constants embedded, followed by the size of the work vector
+    writeBinary(stream,algorithm_);
+    writeBinary(stream,int(work_.size()));
+
+    // Cached sparsity patterns of the Jacobian blocks
+    vector<int> oind, iind;
+    for(int compact=0; compact<2; ++compact){
+      const Matrix<Sparsity>& jsp = compact ? jac_sparsity_compact_ : jac_sparsity_;
+      jsp.sparsity().getTriplet(oind,iind);
+      int n=0;
+      for(int k=0; k<oind.size(); ++k) if(!jsp.at(k).isNull()) n++;
+      writeBinary(stream,n);
+      for(int k=0; k<oind.size(); ++k){
+        if(jsp.at(k).isNull()) continue;
+        writeBinary(stream,oind[k]);
+        writeBinary(stream,iind[k]);
+        writeBinary(stream,jsp.at(k));
+      }
+    }
+
+    // Cached Jacobian functions, if they can be serialized
+    for(int compact=0; compact<2; ++compact){
+      const Matrix<WeakRef>& jac = compact ? jac_compact_ : jac_;
+      jac.sparsity().getTriplet(oind,iind);
+      vector<Function> jfcn(oind.size());
+      int n=0;
+      for(int k=0; k<oind.size(); ++k){
+        WeakRef r = jac.at(k);
+        if(r.alive()){
+          jfcn[k] = shared_cast<Function>(r.shared());
+          if(serializable(jfcn[k])) n++;
+        }
+      }
+      writeBinary(stream,n);
+      for(int k=0; k<oind.size(); ++k){
+        const SXFunctionInternal* f = serializable(jfcn[k]);
+        if(f==0) continue;
+        writeBinary(stream,oind[k]);
+        writeBinary(stream,iind[k]);
+        f->serializeFunction(stream);
+      }
+    }
+
+    // Cached functions for directional derivatives, if they can be serialized
+    vector<int> nfwd, nadj;
+    vector<Function> dfcn;
+    for(int i=0; i<derivative_fcn_.size(); ++i){
+      for(int j=0; j<derivative_fcn_[i].size(); ++j){
+        WeakRef r = derivative_fcn_[i][j];
+        if(!r.alive()) continue;
+        Function f = shared_cast<Function>(r.shared());
+        if(!serializable(f)) continue;
+        nfwd.push_back(i);
+        nadj.push_back(j);
+        dfcn.push_back(f);
+      }
+    }
+    writeBinary(stream,int(dfcn.size()));
+    for(int k=0; k<dfcn.size(); ++k){
+      writeBinary(stream,nfwd[k]);
+      writeBinary(stream,nadj[k]);
+      serializable(dfcn[k])->serializeFunction(stream);
+    }
+
+    // Cached full Jacobian, if it can be serialized
+    WeakRef r = full_jacobian_;
+    Function fjac = r.alive() ? shared_cast<Function>(r.shared()) : Function();
+    const SXFunctionInternal* fjac_node = serializable(fjac);
+    writeBinary(stream,int(fjac_node!=0));
+    if(fjac_node) fjac_node->serializeFunction(stream);
+  }
+
+  SXFunction SXFunctionInternal::deserializeFunction(const char*& buf, const char* buf_end){
+    // Name
+    string name;
+    readBinary(buf,buf_end,name);
+
+    // Input and output sparsity patterns
+    int n_in, n_out;
+    readBinary(buf,buf_end,n_in);
+    casadi_assert_message(n_in>=0,"SXFunction::load: Corrupt data.");
+    vector<Sparsity> sp_in(n_in);
+    for(int i=0; i<n_in; ++i) readBinary(buf,buf_end,sp_in[i]);
+    readBinary(buf,buf_end,n_out);
+    casadi_assert_message(n_out>=0,"SXFunction::load: Corrupt data.");
+    vector<Sparsity> sp_out(n_out);
+    for(int i=0; i<n_out; ++i) readBinary(buf,buf_end,sp_out[i]);
+
+    // Create the function
+    SXFunctionInternal* node = new SXFunctionInternal(sp_in,sp_out);
+    SXFunction ret;
+    ret.assignNode(node);
+    ret.setOption("name",name);
+
+    // Algorithm and work vector
+    readBinary(buf,buf_end,node->algorithm_);
+    int worksize;
+    readBinary(buf,buf_end,worksize);
+    node->work_.resize(worksize,numeric_limits<double>::quiet_NaN());
+
+    // Initialize without resorting the graph, this also resets the derivative caches
+    ret.init();
+
+    // Cached sparsity patterns of the Jacobian blocks
+    for(int compact=0; compact<2; ++compact){
+      int n;
+      readBinary(buf,buf_end,n);
+      for(int k=0; k<n; ++k){
+        int oind, iind;
+        Sparsity sp;
+        readBinary(buf,buf_end,oind);
+        readBinary(buf,buf_end,iind);
+        readBinary(buf,buf_end,sp);
+        node->setJacSparsity(sp,iind,oind,compact);
+      }
+    }
+
+    // Cached Jacobian functions
+    for(int compact=0; compact<2; ++compact){
+      int n;
+      readBinary(buf,buf_end,n);
+      for(int k=0; k<n; ++k){
+        int oind, iind;
+        readBinary(buf,buf_end,oind);
+        readBinary(buf,buf_end,iind);
+        Function jac = deserializeFunction(buf,buf_end);
+        node->setJacobian(jac,iind,oind,compact);
+        node->deserialized_fcn_.push_back(jac);
+      }
+    }
+
+    // Cached functions for directional derivatives
+    int n;
+    readBinary(buf,buf_end,n);
+    for(int k=0; k<n; ++k){
+      int nfwd, nadj;
+      readBinary(buf,buf_end,nfwd);
+      readBinary(buf,buf_end,nadj);
+      Function der = deserializeFunction(buf,buf_end);
+      node->setDerivative(der,nfwd,nadj);
+      node->deserialized_fcn_.push_back(der);
+    }
+
+    // Cached full Jacobian
+    int has_full_jacobian;
+    readBinary(buf,buf_end,has_full_jacobian);
+    if(has_full_jacobian){
+      Function fjac = deserializeFunction(buf,buf_end);
+      node->full_jacobian_ = fjac;
+      node->deserialized_fcn_.push_back(fjac);
+    }
+
+    return ret;
   }
 
   void SXFunctionInternal::spInit(bool fwd){
@@ -76,6 +76,9 @@ class SXFunctionInternal : public XFunctionInternal<SXFunction,SXFunctionInterna
     /** \brief  Constructor (only to be called from SXFunction, therefore protected) */
     SXFunctionInternal(const std::vector<Matrix<SXElement> >& inputv, const std::vector<Matrix<SXElement> >& outputv);
 
+    /** \brief  Constructor without symbolic representation (only to be called during deserialization) */
+    SXFunctionInternal(const std::vector<Sparsity>& sp_in, const std::vector<Sparsity>& sp_out);
+
   public:
 
   /** \brief  Make a deep copy */
@@ -143,6 +146,12 @@ class SXFunctionInternal : public XFunctionInternal<SXFunction,SXFunctionInterna
   /** \brief  Initialize */
   virtual void init();
 
+  /// Dimensions of the simulated cache used in workCacheMisses: number of lines and work vector elements per line
+  static const int CACHE_LINES = 512, CACHE_LINE_SIZE = 8;
+
+  /** \brief Number of work vector accesses of the algorithm missing a simulated fully associative LRU cache (a locality measure) */
+  int workCacheMisses() const;
+
   /** \brief Generate code for the declarations of the C function */
   virtual void generateDeclarations(std::ostream &stream, const std::string& type, CodeGenerator& gen) const;
 
@@ -151,6 +160,24 @@ class SXFunctionInternal : public XFunctionInternal<SXFunction,SXFunctionInterna
 
   /** \brief Clear the function from its symbolic representation, to free up memory, no symbolic evaluations are possible after this */
   void clearSymbolic();
+
+  /** \brief Write the initialized algorithm, sparsity patterns and cached derivative information to a binary stream */
+  void serialize(std::ostream &stream) const;
+
+  /** \brief Read a function written by serialize from a memory buffer, advancing the buffer pointer */
+  static SXFunction deserialize(const char*& buf, const char* buf_end);
+
+  /** \brief Write the function without header (called recursively for the cached derivatives) */
+  void serializeFunction(std::ostream &stream) const;
+
+  /** \brief Read a function written by serializeFunction */
+  static SXFunction deserializeFunction(const char*& buf, const char* buf_end);
+
+  /// Symbolic representation available, if not (after clearSymbolic or deserialize) init keeps the existing algorithm
+  bool has_symbolic_;
+
+  /// Cached derivative functions restored by deserialize, kept alive for the lifetime of the function
+  std::vector<Function> deserialized_fcn_;
   
   /// Propagate a sparsity pattern through the algorithm
   virtual void spEvaluate(bool fwd);
@@ -169,6 +196,9 @@ class SXFunctionInternal : public XFunctionInternal<SXFunction,SXFunctionInterna
 
   /// With just-in-time compilation for the sparsity propagation
   bool just_in_time_sparsity_;
+
+  /// Read the just-in-time compilation options and set up OpenCL, if requested
+  void initJustInTime();
   
 #ifdef WITH_OPENCL
   // Initialize sparsity propagation using OpenCL
@@ -25,6 +25,8 @@
 
 #include <map>
 #include <stack>
+#include <algorithm>
+#include <functional>
 #include "function_internal.hpp"
 #include "../matrix/sparsity_tools.hpp"
 
@@ -69,6 +71,13 @@ namespace CasADi{
     /** \brief  Topological (re)sorting of the nodes based on Breadth-First Search (BFS) (Kahn 1962) */
     static void resort_breadth_first(std::vector<NodeType*>& algnodes);
 
+    /** \brief  Topological (re)sorting of the nodes with the purpose of reducing the size of the work vector
+     * A depth-first sorting, where the dependencies requiring the most work vector elements (Sethi-Ullman numbers) 
+     * are visited first. The nodes are expected to be sorted topologically with null pointers marking the outputs,
+     * roots contains the node before each null pointer.
+     */
+    static void resort_sethi_ullman(std::vector<NodeType*>& nodes, const std::vector<NodeType*>& roots);
+
     /** \brief  Topological (re)sorting of the nodes with the purpose of postponing every calculation as much as possible, as long as it does not influence a dependent node */
     static void resort_postpone(std::vector<NodeType*>& algnodes, std::vector<int>& lind);
              
@@ -135,7 +144,7 @@ namespace CasADi{
   template<typename PublicType, typename DerivedType, typename MatType, typename NodeType>
   XFunctionInternal<PublicType,DerivedType,MatType,NodeType>::XFunctionInternal(
                                                                                 const std::vector<MatType>& inputv, const std::vector<MatType>& outputv) : inputv_(inputv),  outputv_(outputv){
-    addOption("topological_sorting",OT_STRING,"depth-first","Topological sorting algorithm","depth-first|breadth-first");
+    addOption("topological_sorting",OT_STRING,"depth-first","Topological sorting algorithm","depth-first|breadth-first|sethi-ullman: depth-first, visiting the dependencies with the largest register need first");
     addOption("live_variables",OT_BOOLEAN,true,"Reuse variables in the work vector");
   
     // Make sure that inputs are symbolic
@@ -209,6 +218,72 @@ namespace CasADi{
     }
   }
 
+  template<typename PublicType, typename DerivedType, typename MatType, typename NodeType>
+  void XFunctionInternal<PublicType,DerivedType,MatType,NodeType>::resort_sethi_ullman(std::vector<NodeType*>& nodes, const std::vector<NodeType*>& roots){
+
+    // Set the temporary variables to be the corresponding place in the sorted graph
+    for(int i=0; i<nodes.size(); ++i){
+      if(nodes[i]) nodes[i]->temp = i;
+    }
+    
+    // Number of work vector elements needed to evaluate each node: for the dependencies sorted 
+    // by decreasing need l_0 >= l_1 >= ..., the need is max(1, l_j + j)
+    std::vector<int> need(nodes.size(),0), dep_need;
+    for(int i=0; i<nodes.size(); ++i){
+      NodeType* t = nodes[i];
+      if(t==0) continue;
+      dep_need.clear();
+      for(int c=0; c<t->ndep(); ++c){
+        NodeType* d = static_cast<NodeType*>(t->dep(c).get());
+        if(d!=0) dep_need.push_back(need[d->temp]);
+      }
+      std::sort(dep_need.begin(),dep_need.end(),std::greater<int>());
+      need[i] = 1;
+      for(int j=0; j<dep_need.size(); ++j){
+        need[i] = std::max(need[i],dep_need[j]+j);
+      }
+    }
+
+    // Mark the nodes as not yet added, saving the (negative) need in the temporary
+    for(int i=0; i<nodes.size(); ++i){
+      if(nodes[i]) nodes[i]->temp = -need[i];
+    }
+    
+    // Depth-first search, adding the dependency with the largest need first
+    nodes.clear();
+    std::stack<NodeType*> s;
+    for(typename std::vector<NodeType*>::const_iterator r=roots.begin(); r!=roots.end(); ++r){
+      s.push(*r);
+      while(!s.empty()){
+        NodeType* t = s.top();
+        if(t && t->temp<0){
+          // Find the not yet added dependency with the largest need
+          int max_need = 0, dep_with_max_need = -1;
+          for(int i=0; i<t->ndep(); ++i){
+            NodeType* d = static_cast<NodeType*>(t->dep(i).get());
+            if(d!=0 && d->temp<0 && -d->temp>max_need){
+              max_need = -d->temp;
+              dep_with_max_need = i;
+            }
+          }
+          
+          if(dep_with_max_need>=0){
+            s.push(static_cast<NodeType*>(t->dep(dep_with_max_need).get()));
+          } else {
+            nodes.push_back(t);
+            t->temp = 1;
+            s.pop();
+          }
+        } else {
+          s.pop();
+        }
+      }
+      
+      // A null pointer means an output instruction
+      nodes.push_back(static_cast<NodeType*>(0));
+    }
+  }
+
   template<typename PublicType, typename DerivedType, typename MatType, typename NodeType>
   void XFunctionInternal<PublicType,DerivedType,MatType,NodeType>::resort_postpone(std::vector<NodeType*>& algnodes, std::vector<int>& lind){
 
@@ -631,6 +706,13 @@ namespace CasADi{
       jsp_trans = jsp.transpose(mapping);
     }
 
+    // For a bidirectional partition, the entries in the rows seeded in adjoint mode are taken from the adjoint sweeps only
+    std::vector<bool> adj_row;
+    if(nfdir>0 && nadir>0){
+      adj_row.resize(jsp.size2(),false);
+      for(int el=0; el<D2.size(); ++el) adj_row[D2.row(el)] = true;
+    }
+
     // The nonzeros of the sensitivity matrix
     std::vector<int> nzmap, nzmap2;
   
@@ -649,7 +731,8 @@ namespace CasADi{
     int nsweep_adj = nadir/max_nadir;   // Number of sweeps needed for the adjoint mode
     if(nadir%max_nadir>0) nsweep_adj++;
     int nsweep = std::max(nsweep_fwd,nsweep_adj);
-    if(verbose())   std::cout << "XFunctionInternal::jac " << nsweep << " sweeps needed for " << nfdir << " forward and " << nadir << " adjoint directions"  << std::endl;
+    if(verbose())   std::cout << "XFunctionInternal::jac " << nsweep << " sweeps needed for " << nfdir << " forward and " << nadir << " adjoint directions" 
+                              << " (" << jsp.size1() << " forward or " << jsp.size2() << " adjoint directions without coloring)" << std::endl;
   
     // Sparsity of the seeds
     vector<int> seed_col, seed_row;
@@ -808,6 +891,7 @@ namespace CasADi{
           
             // Get the output nonzero
             int r_out = jsp_trans.row(el_out);
+            if(!adj_row.empty() && adj_row[r_out]) continue; // Determined by an adjoint sweep
           
             // Get the forward sensitivity nonzero
             int f_out = nzmap[r_out];
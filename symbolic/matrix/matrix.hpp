@@ -513,6 +513,18 @@ namespace CasADi{
 
     /// Matrix-matrix product, no memory allocation: z += mul(x,trans(y))
     static void mul_no_alloc_nt(const Matrix<DataType>& x, const Matrix<DataType> &trans_y, Matrix<DataType>& z);
+
+    /** \brief Matrix-matrix product, no memory allocation: z += mul(x,y)
+        Scatter-gather variant (Gustavson's algorithm): each column of the product is accumulated in the dense
+        work vector w, with iw marking the occupied rows. Only the entries in the sparsity pattern of z are kept.
+        The work vectors, of lengths len_iw and len_w, must have length at least x.size1(); their contents on entry are ignored. */
+    static void mul_no_alloc_nn(const Matrix<DataType> &x, const Matrix<DataType>& y, Matrix<DataType>& z, int* iw, int len_iw, DataType* w, int len_w);
+
+    /** \brief Matrix-matrix product, no memory allocation: z += mul(trans(x),y)
+        Scatter-gather variant: each column of y is scattered into the dense work vector w, with iw marking the
+        occupied rows, so that each nonzero of z is formed by a single pass over a column of trans_x.
+        The work vectors, of lengths len_iw and len_w, must have length at least y.size1(); their contents on entry are ignored. */
+    static void mul_no_alloc_tn(const Matrix<DataType> &trans_x, const Matrix<DataType> &y, Matrix<DataType>& z, int* iw, int len_iw, DataType* w, int len_w);
   
     /// Matrix-vector product, no memory allocation: z += mul(trans(x),y)
     static void mul_no_alloc_tn(const Matrix<DataType>& trans_x, const std::vector<DataType> &y, std::vector<DataType>& z);
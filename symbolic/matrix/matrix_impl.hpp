@@ -28,6 +28,7 @@
 #include "matrix_tools.hpp"
 #include "sparsity_tools.hpp"
 #include "../std_vector_tools.hpp"
+#include "../memory_pool.hpp"
 
 /// \cond INTERNAL
 
@@ -1357,13 +1358,9 @@ namespace CasADi{
     Matrix<DataType> ret;
 
     // Matrix multiplication
-
-    // Form the transpose of x
-    Matrix<DataType> x_trans = x.trans();
-  
     if (sp_z.isNull()) {
       // Create the sparsity pattern for the matrix-matrix product
-      Sparsity spres = y.sparsity().patternProduct(x_trans.sparsity());
+      Sparsity spres = x.sparsity().patternMultiply(y.sparsity());
 
       // Create the return object
       ret = Matrix<DataType>::zeros(spres);
@@ -1371,8 +1368,11 @@ namespace CasADi{
       ret = Matrix<DataType>::zeros(sp_z);
     }
 
-    // Carry out the matrix product
-    mul_no_alloc_tn(x_trans,y,ret);
+    // Carry out the matrix product, with work vectors from the thread-local pool
+    MemoryPool::Scope scope;
+    std::vector<int,PoolAllocator<int> > iw(x.size1()+1);
+    std::vector<DataType,PoolAllocator<DataType> > w(x.size1()+1);
+    mul_no_alloc_nn(x,y,ret,&iw.front(),iw.size(),&w.front(),w.size());
   
     return ret;
   }
@@ -1536,6 +1536,98 @@ namespace CasADi{
     }
   }
 
+  template<typename DataType>
+  void Matrix<DataType>::mul_no_alloc_nn(const Matrix<DataType> &x, const Matrix<DataType> &y, Matrix<DataType>& z, int* iw, int len_iw, DataType* w, int len_w){
+    // Assert dimensions
+    casadi_assert_message(x.size1()==z.size1(),"Dimension error. Got x=" << x.dimString() << " and z=" << z.dimString() << ".");
+    casadi_assert_message(y.size2()==z.size2(),"Dimension error. Got y=" << y.dimString() << " and z=" << z.dimString() << ".");
+    casadi_assert_message(y.size1()==x.size2(),"Dimension error. Got y=" << y.dimString() << " and x=" << x.dimString() << ".");
+    casadi_assert_message(len_iw>=x.size1() && len_w>=x.size1(),"Work vectors too short. Need " << x.size1() << ", got " << len_iw << " and " << len_w << ".");
+
+    // Direct access to the arrays
+    const std::vector<int> &y_colind = y.colind();
+    const std::vector<int> &y_row = y.row();
+    const std::vector<DataType> &y_data = y.data();
+    const std::vector<int> &x_colind = x.colind();
+    const std::vector<int> &x_row = x.row();
+    const std::vector<DataType> &x_data = x.data();
+    const std::vector<int> &z_colind = z.colind();
+    const std::vector<int> &z_row = z.row();
+    std::vector<DataType> &z_data = z.data();
+
+    // No rows marked
+    std::fill(iw,iw+x.size1(),-1);
+
+    // loop over the cols of the resulting matrix
+    for(int i=0; i<z_colind.size()-1; ++i){
+
+      // Scatter: accumulate x(:,j)*y(j,i) for the nonzeros of column i of y
+      for(int el=y_colind[i]; el<y_colind[i+1]; ++el){
+        int j = y_row[el];
+        for(int el2=x_colind[j]; el2<x_colind[j+1]; ++el2){
+          int k = x_row[el2];
+          if(iw[k]!=i){
+            iw[k] = i;
+            w[k] = x_data[el2] * y_data[el];
+          } else {
+            w[k] += x_data[el2] * y_data[el];
+          }
+        }
+      }
+
+      // Gather into the sparsity pattern of z
+      for(int el=z_colind[i]; el<z_colind[i+1]; ++el){
+        int k = z_row[el];
+        if(iw[k]==i) z_data[el] += w[k];
+      }
+    }
+  }
+
+  template<typename DataType>
+  void Matrix<DataType>::mul_no_alloc_tn(const Matrix<DataType> &x_trans, const Matrix<DataType> &y, Matrix<DataType>& z, int* iw, int len_iw, DataType* w, int len_w){
+    // Assert dimensions
+    casadi_assert_message(y.size2()==z.size2(),"Dimension error. Got y=" << y.dimString() << " and z=" << z.dimString() << ".");
+    casadi_assert_message(x_trans.size2()==z.size1(),"Dimension error. Got x_trans=" << x_trans.dimString() << " and z=" << z.dimString() << ".");
+    casadi_assert_message(y.size1()==x_trans.size1(),"Dimension error. Got y=" << y.dimString() << " and x_trans=" << x_trans.dimString() << ".");
+    casadi_assert_message(len_iw>=y.size1() && len_w>=y.size1(),"Work vectors too short. Need " << y.size1() << ", got " << len_iw << " and " << len_w << ".");
+
+    // Direct access to the arrays
+    const std::vector<int> &y_colind = y.colind();
+    const std::vector<int> &y_row = y.row();
+    const std::vector<DataType> &y_data = y.data();
+    const std::vector<int> &x_rowind = x_trans.colind();
+    const std::vector<int> &x_col = x_trans.row();
+    const std::vector<DataType> &x_trans_data = x_trans.data();
+    const std::vector<int> &z_colind = z.colind();
+    const std::vector<int> &z_row = z.row();
+    std::vector<DataType> &z_data = z.data();
+
+    // No rows marked
+    std::fill(iw,iw+y.size1(),-1);
+
+    // loop over the cols of the resulting matrix
+    for(int i=0; i<z_colind.size()-1; ++i){
+      // Quick continue if no nonzeros in the column of z
+      if(z_colind[i]==z_colind[i+1]) continue;
+
+      // Scatter column i of y
+      for(int el=y_colind[i]; el<y_colind[i+1]; ++el){
+        int k = y_row[el];
+        iw[k] = i;
+        w[k] = y_data[el];
+      }
+
+      // loop over the non-zeros of the resulting matrix
+      for(int el=z_colind[i]; el<z_colind[i+1]; ++el){
+        int j = z_row[el];
+        for(int el2=x_rowind[j]; el2<x_rowind[j+1]; ++el2){
+          int k = x_col[el2];
+          if(iw[k]==i) z_data[el] += x_trans_data[el2] * w[k];
+        }
+      }
+    }
+  }
+
   template<typename DataType>
   template<bool Fwd>
   void Matrix<DataType>::mul_sparsity(Matrix<DataType> &x_trans, Matrix<DataType> &y, Matrix<DataType>& z){
@@ -357,6 +357,10 @@ namespace CasADi{
     return (*this)->patternProduct(x_trans,mapping);
   }
 
+  Sparsity Sparsity::patternMultiply(const Sparsity& y) const{
+    return (*this)->patternMultiply(y);
+  }
+
   bool Sparsity::isEqual(const Sparsity& y) const{
     return (*this)->isEqual(y);
   }
@@ -533,11 +537,27 @@ namespace CasADi{
     (*this)->getNZInplace(indices);
   }
 
-  Sparsity Sparsity::unidirectionalColoring(const Sparsity& AT, int cutoff) const{
+  Sparsity Sparsity::unidirectionalColoring(const Sparsity& AT, int cutoff, int ordering) const{
+    if(AT.isNull()){
+      return (*this)->unidirectionalColoring(transpose(),cutoff,ordering);
+    } else {
+      return (*this)->unidirectionalColoring(AT,cutoff,ordering);
+    }
+  }
+
+  Sparsity Sparsity::unidirectionalColoringParallel(const Sparsity& AT, int nthreads, int ordering) const{
+    if(AT.isNull()){
+      return (*this)->unidirectionalColoringParallel(transpose(),nthreads,ordering);
+    } else {
+      return (*this)->unidirectionalColoringParallel(AT,nthreads,ordering);
+    }
+  }
+
+  void Sparsity::bidirectionalColoring(Sparsity& D1, Sparsity& D2, const Sparsity& AT, int adj_penalty, int cutoff) const{
     if(AT.isNull()){
-      return (*this)->unidirectionalColoring(transpose(),cutoff);
+      (*this)->bidirectionalColoring(transpose(),D1,D2,adj_penalty,cutoff);
     } else {
-      return (*this)->unidirectionalColoring(AT,cutoff);
+      (*this)->bidirectionalColoring(AT,D1,D2,adj_penalty,cutoff);
     }
   }
 
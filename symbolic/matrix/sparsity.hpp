@@ -392,6 +392,12 @@ namespace CasADi{
     Sparsity patternProduct(const Sparsity& x_trans, std::vector< std::vector< std::pair<int,int> > >& SWIG_OUTPUT(mapping)) const;
     Sparsity patternProduct(const Sparsity& x_trans) const;
 
+    /** \brief Sparsity pattern for the matrix-matrix product mul(x,y), with x being this pattern
+        Unlike patternProduct, the first factor is not transposed. The pattern is formed one column at a time
+        by scattering the columns of x selected by the column of y into a marker vector (Gustavson's algorithm),
+        so the cost is proportional to the number of scalar multiplications rather than to the dimensions. */
+    Sparsity patternMultiply(const Sparsity& y) const;
+
     /// @}
 
     /// Take the inverse of a sparsity pattern; flip zeros and non-zeros
@@ -546,18 +552,32 @@ namespace CasADi{
     /// Get the location of all nonzero elements (inplace version)
     void getElements(std::vector<int>& loc, bool col_major=true) const;
     
-    /** \brief Perform a unidirectional coloring: A greedy distance-2 coloring algorithm (Algorithm 3.1 in A. H. GEBREMEDHIN, F. MANNE, A. POTHEN) */
-    Sparsity unidirectionalColoring(const Sparsity& AT=Sparsity(), int cutoff = std::numeric_limits<int>::max()) const;
+    /** \brief Perform a unidirectional coloring: A greedy distance-2 coloring algorithm (Algorithm 3.1 in A. H. GEBREMEDHIN, F. MANNE, A. POTHEN)
+        Ordering options: None (0), largest first (1), smallest last (2), incidence degree (3)
+    */
+    Sparsity unidirectionalColoring(const Sparsity& AT=Sparsity(), int cutoff = std::numeric_limits<int>::max(), int ordering = 0) const;
+
+    /** \brief Perform a unidirectional coloring using speculative parallel coloring rounds with nthreads OpenMP threads
+        Falls back to the serial greedy algorithm if CasADi was compiled without OpenMP.
+    */
+    Sparsity unidirectionalColoringParallel(const Sparsity& AT=Sparsity(), int nthreads = 1, int ordering = 0) const;
+
+    /** \brief Perform a bidirectional coloring of a Jacobian pattern:
+        The densest rows are colored for the adjoint mode (D2), the columns with entries in the remaining rows
+        for the forward mode (D1). D1 and D2 are null if no partition cheaper than cutoff (counting
+        adjoint directions adj_penalty times) was found.
+    */
+    void bidirectionalColoring(Sparsity& D1, Sparsity& D2, const Sparsity& AT=Sparsity(), int adj_penalty=2, int cutoff = std::numeric_limits<int>::max()) const;
 
     /** \brief Perform a star coloring of a symmetric matrix:
         A greedy distance-2 coloring algorithm (Algorithm 4.1 in A. H. GEBREMEDHIN, F. MANNE, A. POTHEN) 
-        Ordering options: None (0), largest first (1)
+        Ordering options: None (0), largest first (1), smallest last (2), incidence degree (3)
     */
     Sparsity starColoring(int ordering = 1, int cutoff = std::numeric_limits<int>::max()) const;
 
     /** \brief Perform a star coloring of a symmetric matrix:
         A new greedy distance-2 coloring algorithm (Algorithm 4.1 in A. H. GEBREMEDHIN, A. TARAFDAR, F. MANNE, A. POTHEN) 
-        Ordering options: None (0), largest first (1)
+        Ordering options: None (0), largest first (1), smallest last (2), incidence degree (3)
     */
     Sparsity starColoring2(int ordering = 1, int cutoff = std::numeric_limits<int>::max()) const;
     
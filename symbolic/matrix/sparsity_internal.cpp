@@ -27,6 +27,7 @@
 #include <cstdlib>
 #include <cmath>
 #include "matrix.hpp"
+#include "../memory_pool.hpp"
 
 using namespace std;
 
@@ -1995,6 +1996,63 @@ namespace CasADi{
     return ret;
   }
 
+  Sparsity SparsityInternal::patternMultiply(const Sparsity& y) const{
+    casadi_assert_message(ncol_==y.size1(),"Dimension error. Got x=" << dimString() << " and y=" << y.dimString() << ".");
+
+    // Dimensions
+    int y_ncol = y.size2();
+
+    // Quick return if both are dense
+    if(isDense() && y.isDense()){
+      return !isEmpty() && !y.isEmpty() ? Sparsity::dense(nrow_,y_ncol) : Sparsity::sparse(nrow_,y_ncol);
+    }
+
+    // Direct access to the arrays
+    const vector<int> &y_colind = y.colind();
+    const vector<int> &y_row = y.row();
+
+    // Pattern of the product
+    vector<int> ret_colind(y_ncol+1,0);
+    vector<int> ret_row;
+
+    // Marker: the last column of the product in which a row has been encountered
+    MemoryPool::Scope scope;
+    vector<int,PoolAllocator<int> > mask(nrow_,-1);
+
+    // Loop over the columns of the product
+    for(int i=0; i<y_ncol; ++i){
+      int ret_start = ret_row.size();
+
+      // Union of the columns of x corresponding to the nonzeros of column i of y
+      for(int el=y_colind[i]; el<y_colind[i+1]; ++el){
+        int k = y_row[el];
+        for(int el2=colind_[k]; el2<colind_[k+1]; ++el2){
+          int j = row_[el2];
+          if(mask[j]!=i){
+            mask[j] = i;
+            ret_row.push_back(j);
+          }
+        }
+      }
+
+      // Restore the row ordering, scanning the marker instead of sorting if the column is nearly dense
+      int nz = ret_row.size()-ret_start;
+      if(nz>1){
+        if(8*nz>nrow_){
+          ret_row.resize(ret_start);
+          for(int j=0; j<nrow_; ++j){
+            if(mask[j]==i) ret_row.push_back(j);
+          }
+        } else {
+          sort(ret_row.begin()+ret_start,ret_row.end());
+        }
+      }
+      ret_colind[i+1] = ret_row.size();
+    }
+
+    return Sparsity(nrow_,y_ncol,ret_colind,ret_row);
+  }
+
   bool SparsityInternal::isScalar(bool scalar_and_dense) const{
     return ncol_==1 && nrow_==1 && (!scalar_and_dense || size()==1);
   }
@@ -2860,7 +2918,22 @@ namespace CasADi{
     fill(it,indices.end(),-1);
   }
 
-  Sparsity SparsityInternal::unidirectionalColoring(const Sparsity& AT, int cutoff) const{
+  Sparsity SparsityInternal::unidirectionalColoring(const Sparsity& AT, int cutoff, int ordering) const{
+    // Reorder, if necessary
+    if(ordering!=0){
+      // Ordering
+      vector<int> ord = getOrdering(ordering,AT);
+
+      // Create a new sparsity pattern with the columns permuted
+      Sparsity sp_permuted = pmult(ord,false,true,true);
+    
+      // Coloring for the permuted matrix
+      Sparsity ret_permuted = sp_permuted.unidirectionalColoring(sp_permuted.transpose(),cutoff);
+      if(ret_permuted.isNull()) return ret_permuted;
+
+      // Permute result back
+      return ret_permuted.pmult(ord,true,false,false);
+    }
   
     // Allocate temporary vectors
     vector<int> forbiddenColors;
@@ -2948,16 +3021,258 @@ namespace CasADi{
     return ret;
   }
   
+  Sparsity SparsityInternal::unidirectionalColoringParallel(const Sparsity& AT, int nthreads, int ordering) const{
+    // Serial greedy coloring if only one thread is available
+#ifndef WITH_OPENMP
+    nthreads = 1;
+#endif // WITH_OPENMP
+    if(nthreads<=1) return unidirectionalColoring(AT,INT_MAX,ordering);
+
+    // Reorder, if necessary
+    if(ordering!=0){
+      vector<int> ord = getOrdering(ordering,AT);
+      Sparsity sp_permuted = pmult(ord,false,true,true);
+      Sparsity ret_permuted = sp_permuted.unidirectionalColoringParallel(sp_permuted.transpose(),nthreads);
+      return ret_permuted.pmult(ord,true,false,false);
+    }
+
+    // Color of each column, -1 if not colored
+    vector<int> color(ncol_,-1);
+
+    // Columns to be colored in the current round
+    vector<int> worklist(ncol_);
+    for(int i=0; i<ncol_; ++i) worklist[i] = i;
+
+    // Columns that need to be recolored
+    vector<char> conflict(ncol_,0);
+  
+    // Access the sparsity of the transpose
+    const vector<int>& AT_colind = AT.colind();
+    const vector<int>& AT_row = AT.row();
+
+    while(!worklist.empty()){
+      int nwork = worklist.size();
+
+      // Tentative coloring: each thread colors its share using the colors visible at the time. The colors of
+      // the neighbors may be written concurrently by other threads, hence the atomic accesses; a stale color
+      // can lead to two adjacent columns with the same color, which is resolved by the conflict detection below
+#ifdef WITH_OPENMP
+#pragma omp parallel num_threads(nthreads)
+#endif // WITH_OPENMP
+      {
+        vector<int> forbiddenColors;
+#ifdef WITH_OPENMP
+#pragma omp for schedule(static)
+#endif // WITH_OPENMP
+        for(int k=0; k<nwork; ++k){
+          int i = worklist[k];
+          for(int el=colind_[i]; el<colind_[i+1]; ++el){
+            int c = row_[el];
+            for(int el_nb=AT_colind[c]; el_nb<AT_colind[c+1]; ++el_nb){
+              int i_nb = AT_row[el_nb];
+              int color_nb;
+#ifdef WITH_OPENMP
+#pragma omp atomic read
+#endif // WITH_OPENMP
+              color_nb = color[i_nb];
+              if(i_nb==i || color_nb<0) continue;
+              if(color_nb>=forbiddenColors.size()) forbiddenColors.resize(color_nb+1,-1);
+              forbiddenColors[color_nb] = i;
+            }
+          }
+          int color_i;
+          for(color_i=0; color_i<forbiddenColors.size(); ++color_i){
+            if(forbiddenColors[color_i]!=i) break;
+          }
+#ifdef WITH_OPENMP
+#pragma omp atomic write
+#endif // WITH_OPENMP
+          color[i] = color_i;
+        }
+      }
+
+      // Conflict detection, after the implicit barrier at the end of the coloring: of two adjacent columns
+      // with the same color, the one with the larger index is recolored. The colors are only read here
+#ifdef WITH_OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+#endif // WITH_OPENMP
+      for(int k=0; k<nwork; ++k){
+        int i = worklist[k];
+        conflict[i] = 0;
+        for(int el=colind_[i]; el<colind_[i+1] && !conflict[i]; ++el){
+          int c = row_[el];
+          for(int el_nb=AT_colind[c]; el_nb<AT_colind[c+1]; ++el_nb){
+            int i_nb = AT_row[el_nb];
+            if(i_nb>=i) break;
+            if(color[i_nb]==color[i]){
+              conflict[i] = 1;
+              break;
+            }
+          }
+        }
+      }
+
+      // Columns to be recolored in the next round
+      int nconflict = 0;
+      for(int k=0; k<nwork; ++k){
+        if(conflict[worklist[k]]) worklist[nconflict++] = worklist[k];
+      }
+      worklist.resize(nconflict);
+    }
+
+    // Create return sparsity containing the coloring
+    int ncolor = 0;
+    for(int i=0; i<ncol_; ++i) ncolor = max(ncolor,color[i]+1);
+    Sparsity ret = Sparsity::sparse(ncol_,ncolor);
+    vector<int>& colind = ret.colindRef();
+    vector<int>& row = ret.rowRef();
+    for(int i=0; i<ncol_; ++i){
+      colind[color[i]+1]++;
+    }
+    for(int j=0; j<ncolor; ++j){
+      colind[j+1] += colind[j];
+    }
+    row.resize(ncol_);
+    vector<int> pos(colind.begin(),colind.end()-1);
+    for(int i=0; i<ncol_; ++i){
+      row[pos[color[i]]++] = i;
+    }
+    return ret;
+  }
+
+  Sparsity SparsityInternal::partialColoring(const Sparsity& A, const Sparsity& AT, const std::vector<bool>& col_active, const std::vector<bool>& row_active, int cutoff){
+    int ncol = A.size2();
+  
+    // Allocate temporary vectors
+    vector<int> forbiddenColors;
+    vector<int> color(ncol,-1);
+  
+    // Access the sparsity patterns
+    const vector<int>& A_colind = A.colind();
+    const vector<int>& A_row = A.row();
+    const vector<int>& AT_colind = AT.colind();
+    const vector<int>& AT_row = AT.row();
+  
+    // Loop over active cols
+    for(int i=0; i<ncol; ++i){
+      if(!col_active[i]) continue;
+    
+      // Loop over nonzero elements in active rows
+      for(int el=A_colind[i]; el<A_colind[i+1]; ++el){
+        int c = A_row[el];
+        if(!row_active[c]) continue;
+        
+        // Loop over previous active cols that have an element in row c
+        for(int el_prev=AT_colind[c]; el_prev<AT_colind[c+1]; ++el_prev){
+          int i_prev = AT_row[el_prev];
+          if(i_prev>=i) break;
+          if(col_active[i_prev]) forbiddenColors[color[i_prev]] = i;
+        }
+      }
+    
+      // Get the first nonforbidden color
+      int color_i;
+      for(color_i=0; color_i<forbiddenColors.size(); ++color_i){
+        if(forbiddenColors[color_i]!=i) break;
+      }
+      color[i] = color_i;
+    
+      // Add color if reached end
+      if(color_i==forbiddenColors.size()){
+        forbiddenColors.push_back(-1);
+        
+        // Cutoff if too many colors
+        if(forbiddenColors.size()>cutoff){
+          return Sparsity();
+        }
+      }
+    }
+  
+    // Create return sparsity containing the coloring
+    int ncolor = forbiddenColors.size();
+    Sparsity ret = Sparsity::sparse(ncol,ncolor);
+    vector<int>& colind = ret.colindRef();
+    vector<int>& row = ret.rowRef();
+    for(int i=0; i<ncol; ++i){
+      if(color[i]>=0) colind[color[i]+1]++;
+    }
+    for(int j=0; j<ncolor; ++j){
+      colind[j+1] += colind[j];
+    }
+    row.resize(colind.back());
+    vector<int> pos(colind.begin(),colind.end()-1);
+    for(int i=0; i<ncol; ++i){
+      if(color[i]>=0) row[pos[color[i]]++] = i;
+    }
+    return ret;
+  }
+
+  void SparsityInternal::bidirectionalColoring(const Sparsity& AT, Sparsity& D1, Sparsity& D2, int adj_penalty, int cutoff) const{
+    D1 = D2 = Sparsity();
+    if(nrow_<2 || ncol_==0) return;
+    Sparsity A = shared_from_this<Sparsity>();
+
+    // Rows sorted by decreasing number of nonzeros
+    vector<int> row_count(nrow_,0);
+    for(int el=0; el<row_.size(); ++el) row_count[row_[el]]++;
+    vector<pair<int,int> > row_order(nrow_);
+    for(int r=0; r<nrow_; ++r) row_order[r] = make_pair(-row_count[r],r);
+    sort(row_order.begin(),row_order.end());
+
+    // Best cost (forward directions plus penalized adjoint directions) so far
+    int best_cost = cutoff;
+
+    // Rows handled in adjoint mode: the densest 1, 2, 4, ... rows, up to half of all rows
+    vector<bool> adj_row(nrow_,false), fwd_row(nrow_,true), all_cols(ncol_,true), fwd_col(ncol_);
+    int nadj_row = 0;
+    for(int n=1; n<=nrow_/2; n*=2){
+      // Rows with the same count as the last selected row go to the adjoint mode as well
+      while(n<nrow_ && row_order[n].first==row_order[n-1].first) n++;
+      if(n>=nrow_) break;
+      if(row_count[row_order[n-1].second]<=1) break; // no dense rows left
+      
+      // Mark the rows handled in adjoint mode
+      for(; nadj_row<n; ++nadj_row){
+        int r = row_order[nadj_row].second;
+        adj_row[r] = true;
+        fwd_row[r] = false;
+      }
+      
+      // Color the adjoint rows: conflict if they share any column
+      Sparsity D2_n = partialColoring(AT,A,adj_row,all_cols,best_cost/adj_penalty);
+      if(D2_n.isNull()) continue;
+      int adj_cost = adj_penalty*D2_n.size2();
+      
+      // Columns with entries in the remaining rows are handled in forward mode
+      for(int c=0; c<ncol_; ++c){
+        fwd_col[c] = false;
+        for(int el=colind_[c]; el<colind_[c+1]; ++el){
+          if(fwd_row[row_[el]]){
+            fwd_col[c] = true;
+            break;
+          }
+        }
+      }
+      
+      // Color the forward columns: conflict only if they share a row not handled in adjoint mode
+      Sparsity D1_n = partialColoring(A,AT,fwd_col,fwd_row,best_cost-adj_cost-1);
+      if(D1_n.isNull()) continue;
+      int cost = D1_n.size2() + adj_cost;
+      if(cost<best_cost){
+        best_cost = cost;
+        D1 = D1_n;
+        D2 = D2_n;
+      }
+    }
+  }
+
   Sparsity SparsityInternal::starColoring2(int ordering, int cutoff) const{
     casadi_assert_warning(ncol_==nrow_,"StarColoring requires a square matrix, but got " << dimString() << ".");
 
-    // TODO What we need here, is a distance-2 smallest last ordering
     // Reorder, if necessary
     if(ordering!=0){
-      casadi_assert(ordering==1);
-    
-      // Ordering
-      vector<int> ord = largestFirstOrdering();
+      // Ordering (smallest last and incidence degree using distance-2 neighbors)
+      vector<int> ord = getOrdering(ordering,shared_from_this<Sparsity>());
 
       // Create a new sparsity pattern 
       Sparsity sp_permuted = pmult(ord,true,true,true);
@@ -3204,10 +3519,8 @@ namespace CasADi{
     casadi_assert_warning(ncol_==nrow_,"StarColoring requires a square matrix, but got " << dimString() << ".");
     // Reorder, if necessary
     if(ordering!=0){
-      casadi_assert(ordering==1);
-    
-      // Ordering
-      vector<int> ord = largestFirstOrdering();
+      // Ordering (smallest last and incidence degree using distance-2 neighbors)
+      vector<int> ord = getOrdering(ordering,shared_from_this<Sparsity>());
 
       // Create a new sparsity pattern 
       Sparsity sp_permuted = pmult(ord,true,true,true);
@@ -3342,6 +3655,154 @@ namespace CasADi{
     return reverse_ordering;
   }
 
+  std::vector<int> SparsityInternal::getOrdering(int ordering, const Sparsity& AT) const{
+    switch(ordering){
+      case 0:
+      {
+        vector<int> ord(ncol_);
+        for(int k=0; k<ncol_; ++k) ord[k] = k;
+        return ord;
+      }
+      case 1: return largestFirstOrdering();
+      case 2: return smallestLastOrdering(AT);
+      case 3: return incidenceDegreeOrdering(AT);
+      default: casadi_error("SparsityInternal::getOrdering: Unknown ordering " << ordering << ". Possible values are 0 (none), 1 (largest first), 2 (smallest last) and 3 (incidence degree).");
+    }
+  }
+
+  void SparsityInternal::getNeighbors(int j, const Sparsity& AT, std::vector<int>& marker, std::vector<int>& nb) const{
+    nb.clear();
+    marker[j] = j;
+    for(int el=colind_[j]; el<colind_[j+1]; ++el){
+      int r = row_[el];
+      if(AT.isNull()){
+        // Distance-1 neighbor in the adjacency graph
+        if(marker[r]!=j){
+          marker[r] = j;
+          nb.push_back(r);
+        }
+      } else {
+        // Distance-2 neighbors: columns sharing row r
+        const vector<int>& AT_colind = AT.colind();
+        const vector<int>& AT_row = AT.row();
+        for(int el_nb=AT_colind[r]; el_nb<AT_colind[r+1]; ++el_nb){
+          int k = AT_row[el_nb];
+          if(marker[k]!=j){
+            marker[k] = j;
+            nb.push_back(k);
+          }
+        }
+      }
+    }
+    marker[j] = -1;
+    for(vector<int>::const_iterator it=nb.begin(); it!=nb.end(); ++it) marker[*it] = -1;
+  }
+
+  std::vector<int> SparsityInternal::smallestLastOrdering(const Sparsity& AT) const{
+    casadi_assert_message(!AT.isNull() || nrow_==ncol_, "SparsityInternal::smallestLastOrdering: distance-1 ordering requires a square matrix");
+    vector<int> marker(ncol_,-1), nb;
+  
+    // Degree of each column
+    vector<int> degree(ncol_);
+    int max_degree = 0;
+    for(int j=0; j<ncol_; ++j){
+      getNeighbors(j,AT,marker,nb);
+      degree[j] = nb.size();
+      max_degree = max(max_degree,degree[j]);
+    }
+  
+    // Bucket each column according to its degree (doubly linked lists)
+    vector<int> head(max_degree+1,-1), next(ncol_,-1), prev(ncol_,-1);
+    for(int j=ncol_-1; j>=0; --j){
+      next[j] = head[degree[j]];
+      if(next[j]>=0) prev[next[j]] = j;
+      head[degree[j]] = j;
+    }
+  
+    // Repeatedly remove a column of smallest degree in the remaining graph, placing it last
+    vector<int> ord(ncol_);
+    vector<bool> removed(ncol_,false);
+    int min_degree = 0;
+    for(int k=ncol_-1; k>=0; --k){
+      while(head[min_degree]<0) min_degree++;
+      int j = head[min_degree];
+      head[min_degree] = next[j];
+      if(next[j]>=0) prev[next[j]] = -1;
+      removed[j] = true;
+      ord[k] = j;
+
+      // Update the degree of the neighbors
+      getNeighbors(j,AT,marker,nb);
+      for(vector<int>::const_iterator it=nb.begin(); it!=nb.end(); ++it){
+        int i = *it;
+        if(removed[i]) continue;
+        
+        // Unlink from the current bucket
+        if(prev[i]>=0) next[prev[i]] = next[i];
+        else head[degree[i]] = next[i];
+        if(next[i]>=0) prev[next[i]] = prev[i];
+
+        // Link into the bucket below
+        int d = --degree[i];
+        prev[i] = -1;
+        next[i] = head[d];
+        if(next[i]>=0) prev[next[i]] = i;
+        head[d] = i;
+      }
+      if(min_degree>0) min_degree--;
+    }
+    return ord;
+  }
+
+  std::vector<int> SparsityInternal::incidenceDegreeOrdering(const Sparsity& AT) const{
+    casadi_assert_message(!AT.isNull() || nrow_==ncol_, "SparsityInternal::incidenceDegreeOrdering: distance-1 ordering requires a square matrix");
+    vector<int> marker(ncol_,-1), nb;
+  
+    // Number of already ordered neighbors of each column, all columns start in bucket 0
+    vector<int> incidence(ncol_,0);
+    vector<int> head(1,-1), next(ncol_,-1), prev(ncol_,-1);
+    for(int j=ncol_-1; j>=0; --j){
+      next[j] = head[0];
+      if(next[j]>=0) prev[next[j]] = j;
+      head[0] = j;
+    }
+  
+    // Repeatedly pick the column with the most ordered neighbors
+    vector<int> ord(ncol_);
+    vector<bool> ordered(ncol_,false);
+    int max_incidence = 0;
+    for(int k=0; k<ncol_; ++k){
+      while(head[max_incidence]<0) max_incidence--;
+      int j = head[max_incidence];
+      head[max_incidence] = next[j];
+      if(next[j]>=0) prev[next[j]] = -1;
+      ordered[j] = true;
+      ord[k] = j;
+
+      // Update the incidence of the neighbors
+      getNeighbors(j,AT,marker,nb);
+      for(vector<int>::const_iterator it=nb.begin(); it!=nb.end(); ++it){
+        int i = *it;
+        if(ordered[i]) continue;
+        
+        // Unlink from the current bucket
+        if(prev[i]>=0) next[prev[i]] = next[i];
+        else head[incidence[i]] = next[i];
+        if(next[i]>=0) prev[next[i]] = prev[i];
+
+        // Link into the bucket above
+        int d = ++incidence[i];
+        if(d==head.size()) head.push_back(-1);
+        prev[i] = -1;
+        next[i] = head[d];
+        if(next[i]>=0) prev[next[i]] = i;
+        head[d] = i;
+        max_incidence = max(max_incidence,d);
+      }
+    }
+    return ord;
+  }
+
   Sparsity SparsityInternal::pmult(const std::vector<int>& p, bool permute_rows, bool permute_cols, bool invert_permutation) const{
     // Invert p, possibly
     vector<int> p_inv;
@@ -205,6 +205,9 @@ namespace CasADi{
     Sparsity patternProduct(const Sparsity& x_trans, std::vector< std::vector< std::pair<int,int> > >& mapping) const;
     Sparsity patternProduct(const Sparsity& x_trans) const;
     //@}
+
+    /// Sparsity pattern for the matrix-matrix product mul(x,y) (details in public class)
+    Sparsity patternMultiply(const Sparsity& y) const;
     
     //@{
     /// Union of two sparsity patterns
@@ -297,7 +300,25 @@ namespace CasADi{
     std::vector<int> row_;
         
     /// Perform a unidirectional coloring: A greedy distance-2 coloring algorithm (Algorithm 3.1 in A. H. GEBREMEDHIN, F. MANNE, A. POTHEN) 
-    Sparsity unidirectionalColoring(const Sparsity& AT, int cutoff) const;
+    Sparsity unidirectionalColoring(const Sparsity& AT, int cutoff, int ordering=0) const;
+
+    /** \brief Perform a unidirectional coloring with speculative parallel coloring rounds
+     * The columns are colored concurrently, conflicts are detected and the conflicting columns recolored in the next round
+     * (A. H. GEBREMEDHIN, F. MANNE, Scalable parallel graph coloring algorithms). Serial without OpenMP.
+     */
+    Sparsity unidirectionalColoringParallel(const Sparsity& AT, int nthreads, int ordering=0) const;
+
+    /** \brief Perform a bidirectional coloring of a Jacobian pattern (rows are outputs, columns inputs)
+     * The densest rows are assigned to the adjoint mode (seeds D2) and the columns with entries in the 
+     * remaining rows are assigned to the forward mode (seeds D1), cf. the direct bicoloring of T. F. COLEMAN, A. VERMA.
+     * Entries in the adjoint rows are recovered from the adjoint sweeps, all other entries from the forward sweeps.
+     * Both D1 and D2 are null on return if no partition with a cost (forward directions plus adj_penalty
+     * times adjoint directions) below cutoff was found.
+     */
+    void bidirectionalColoring(const Sparsity& AT, Sparsity& D1, Sparsity& D2, int adj_penalty, int cutoff) const;
+
+    /// Greedy distance-2 coloring of the active columns of A, taking into account only conflicts in active rows
+    static Sparsity partialColoring(const Sparsity& A, const Sparsity& AT, const std::vector<bool>& col_active, const std::vector<bool>& row_active, int cutoff);
 
     /// Perform a star coloring of a symmetric matrix: A greedy distance-2 coloring algorithm (Algorithm 4.1 in A. H. GEBREMEDHIN, F. MANNE, A. POTHEN)
     Sparsity starColoring(int ordering, int cutoff) const;
@@ -308,6 +329,18 @@ namespace CasADi{
     /// Order the columns by decreasing degree
     std::vector<int> largestFirstOrdering() const;
 
+    /// Smallest last ordering of the columns, distance-2 in the bipartite graph if AT is given, distance-1 otherwise
+    std::vector<int> smallestLastOrdering(const Sparsity& AT) const;
+
+    /// Incidence degree ordering of the columns, distance-2 in the bipartite graph if AT is given, distance-1 otherwise
+    std::vector<int> incidenceDegreeOrdering(const Sparsity& AT) const;
+
+    /// Get the neighbors of column j, distance-2 in the bipartite graph if AT is given, distance-1 otherwise (marker must be initialized to -1)
+    void getNeighbors(int j, const Sparsity& AT, std::vector<int>& marker, std::vector<int>& nb) const;
+
+    /// Get an ordering of the columns: None (0), largest first (1), smallest last (2), incidence degree (3)
+    std::vector<int> getOrdering(int ordering, const Sparsity& AT) const;
+
     /// Permute rows and/or columns
     Sparsity pmult(const std::vector<int>& p, bool permute_rows=true, bool permute_cols=true, bool invert_permutation=false) const;
 
@@ -39,7 +39,7 @@ namespace CasADi{
   }
 
   Sparsity mul(const Sparsity& a, const Sparsity &b) {
-    return b.patternProduct(a.T());
+    return a.patternMultiply(b);
   }
     
   int rank(const Sparsity& a) {
@@ -0,0 +1,143 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include "memory_pool.hpp"
+#include <cstdlib>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+using namespace std;
+namespace CasADi{
+
+  namespace{
+    // Round up to a multiple of the alignment
+    inline size_t alignUp(size_t n){
+      return (n + MemoryPool::alignment - 1) & ~(MemoryPool::alignment - 1);
+    }
+
+    char* alignedMalloc(size_t n){
+      void* ret = 0;
+#ifdef _WIN32
+      ret = _aligned_malloc(n,MemoryPool::alignment);
+#else
+      if(posix_memalign(&ret,MemoryPool::alignment,n)!=0) ret = 0;
+#endif
+      if(ret==0) throw std::bad_alloc();
+      return static_cast<char*>(ret);
+    }
+
+    void alignedFree(char* p){
+#ifdef _WIN32
+      _aligned_free(p);
+#else
+      free(p);
+#endif
+    }
+  } // namespace
+
+  MemoryPool::MemoryPool(size_t block_size) : block_size_(alignUp(block_size)), current_(0), offset_(0), heap_(block_size==0){
+    resetStatistics();
+    usage_ = 0;
+  }
+
+  MemoryPool::~MemoryPool(){
+    for(vector<Block>::iterator it=blocks_.begin(); it!=blocks_.end(); ++it){
+      alignedFree(it->data);
+    }
+  }
+
+  MemoryPool& MemoryPool::local(){
+#if defined(USE_CXX11)
+    static thread_local MemoryPool pool;
+#elif defined(WITH_OPENMP)
+    // No thread-local storage: the pool may be used from several threads, so it must not pool
+    static MemoryPool pool(0);
+#else
+    static MemoryPool pool;
+#endif
+    return pool;
+  }
+
+  void* MemoryPool::allocate(size_t n){
+    n = alignUp(n==0 ? 1 : n);
+    if(heap_) return alignedMalloc(n);
+    num_alloc_++;
+
+    // Find a block with enough space, starting with the current one
+    while(current_<blocks_.size() && offset_+n>blocks_[current_].size){
+      usage_ += blocks_[current_].size - offset_;
+      current_++;
+      offset_ = 0;
+    }
+
+    // Get a new block from the system if needed
+    if(current_==blocks_.size()){
+      Block b;
+      b.size = n>block_size_ ? n : block_size_;
+      b.data = alignedMalloc(b.size);
+      blocks_.push_back(b);
+      num_sys_alloc_++;
+    }
+
+    void* ret = blocks_[current_].data + offset_;
+    offset_ += n;
+    usage_ += n;
+    if(usage_>peak_usage_) peak_usage_ = usage_;
+    return ret;
+  }
+
+  void MemoryPool::deallocate(void* p){
+    if(heap_) alignedFree(static_cast<char*>(p));
+  }
+
+  void MemoryPool::release(){
+    current_ = 0;
+    offset_ = 0;
+    usage_ = 0;
+  }
+
+  size_t MemoryPool::capacity() const{
+    size_t ret = 0;
+    for(vector<Block>::const_iterator it=blocks_.begin(); it!=blocks_.end(); ++it){
+      ret += it->size;
+    }
+    return ret;
+  }
+
+  void MemoryPool::resetStatistics(){
+    peak_usage_ = 0;
+    num_alloc_ = 0;
+    num_sys_alloc_ = 0;
+  }
+
+  MemoryPool::Scope::Scope(MemoryPool& pool) : pool_(pool), block_(pool.current_), offset_(pool.offset_), usage_(pool.usage_){
+  }
+
+  MemoryPool::Scope::~Scope(){
+    if(pool_.heap_) return;
+    pool_.current_ = block_;
+    pool_.offset_ = offset_;
+    pool_.usage_ = usage_;
+  }
+
+} // namespace CasADi
@@ -0,0 +1,167 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef CASADI_MEMORY_POOL_HPP
+#define CASADI_MEMORY_POOL_HPP
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+/// \cond INTERNAL
+namespace CasADi{
+
+  /** \brief Arena for temporary work vectors
+      Memory is handed out from large 64-byte aligned blocks which are obtained from the system once
+      and kept for reuse. Individual allocations are never freed; instead, everything allocated after
+      a given point is released in bulk when the corresponding MemoryPool::Scope goes out of scope.
+      In a loop that performs the same evaluation repeatedly, this means that no system allocations
+      take place after the first iteration.
+
+      Each thread has its own pool, obtained with MemoryPool::local(). Without C++11 support (no
+      thread_local), there is a single pool, which is not thread-safe; when compiled with OpenMP it
+      is therefore replaced by a pool that passes all allocations on to the system heap.
+
+      \author Joel Andersson
+      \date 2014
+  */
+  class MemoryPool{
+  public:
+    /// Alignment of all allocations, in bytes
+    static const std::size_t alignment = 64;
+
+    /** \brief Constructor
+        With block_size zero, there is no pooling: every allocation is obtained from the system and
+        returned with deallocate, no statistics are collected and the pool can be shared between threads.
+    */
+    explicit MemoryPool(std::size_t block_size=1<<16);
+
+    /// Destructor, returns all blocks to the system
+    ~MemoryPool();
+
+    /// Pool of the calling thread
+    static MemoryPool& local();
+
+    /// Allocate n bytes, aligned to a 64-byte boundary
+    void* allocate(std::size_t n);
+
+    /// Return an allocation to the system if the pool does not pool (block size zero), otherwise a no-op
+    void deallocate(void* p);
+
+    /// Release everything that has been allocated, keeping the blocks for reuse
+    void release();
+
+    /// Number of allocations served by the pool
+    std::size_t numAllocations() const{ return num_alloc_;}
+
+    /// Number of blocks requested from the system
+    std::size_t numSystemAllocations() const{ return num_sys_alloc_;}
+
+    /// Total size of the blocks held by the pool, in bytes
+    std::size_t capacity() const;
+
+    /// Largest number of bytes in use at any time
+    std::size_t peakUsage() const{ return peak_usage_;}
+
+    /// Reset the allocation counters
+    void resetStatistics();
+
+    /** \brief Release in bulk everything allocated during the lifetime of the object */
+    class Scope{
+    public:
+      explicit Scope(MemoryPool& pool=MemoryPool::local());
+      ~Scope();
+    private:
+      MemoryPool& pool_;
+      std::size_t block_, offset_, usage_;
+
+      // Not copyable
+      Scope(const Scope&);
+      Scope& operator=(const Scope&);
+    };
+
+  private:
+    // A block obtained from the system
+    struct Block{
+      char* data;
+      std::size_t size;
+    };
+
+    // Blocks, the current block and the offset into it
+    std::vector<Block> blocks_;
+    std::size_t block_size_, current_, offset_;
+
+    // No pooling, allocations are passed on to the system
+    bool heap_;
+
+    // Statistics
+    std::size_t usage_, peak_usage_, num_alloc_, num_sys_alloc_;
+
+    // Not copyable
+    MemoryPool(const MemoryPool&);
+    MemoryPool& operator=(const MemoryPool&);
+  };
+
+  /** \brief STL allocator drawing from the thread-local MemoryPool
+      Deallocation is a no-op for a pooling MemoryPool: the memory is reclaimed when the enclosing
+      MemoryPool::Scope ends, so containers using this allocator must not outlive that scope.
+  */
+  template<typename T>
+  class PoolAllocator{
+  public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    template<typename U> struct rebind{ typedef PoolAllocator<U> other;};
+
+    PoolAllocator() : pool_(&MemoryPool::local()){}
+    template<typename U> PoolAllocator(const PoolAllocator<U>& other) : pool_(other.pool()){}
+
+    pointer allocate(size_type n, const void* hint=0){ return static_cast<pointer>(pool_->allocate(n*sizeof(T)));}
+    void deallocate(pointer p, size_type n){ pool_->deallocate(p);}
+    void construct(pointer p, const T& val){ new(static_cast<void*>(p)) T(val);}
+    void destroy(pointer p){ p->~T();}
+    pointer address(reference x) const{ return &x;}
+    const_pointer address(const_reference x) const{ return &x;}
+    size_type max_size() const{ return size_type(-1)/sizeof(T);}
+
+    /// The pool allocated from
+    MemoryPool* pool() const{ return pool_;}
+
+  private:
+    MemoryPool* pool_;
+  };
+
+  template<typename T, typename U>
+  bool operator==(const PoolAllocator<T>& x, const PoolAllocator<U>& y){ return x.pool()==y.pool();}
+
+  template<typename T, typename U>
+  bool operator!=(const PoolAllocator<T>& x, const PoolAllocator<U>& y){ return x.pool()!=y.pool();}
+
+} // namespace CasADi
+/// \endcond
+
+#endif // CASADI_MEMORY_POOL_HPP
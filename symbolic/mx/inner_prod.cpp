@@ -24,7 +24,7 @@
 #include "../matrix/matrix_tools.hpp"
 #include "mx_tools.hpp"
 #include "../sx/sx_tools.hpp"
-#include "../runtime/runtime.hpp"
+#include "../runtime/runtime_simd.hpp"
 
 using namespace std;
 
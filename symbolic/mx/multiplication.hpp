@@ -66,6 +66,9 @@ namespace CasADi{
 
     /** \brief  Propagate sparsity */
     virtual void propagateSparsity(DMatrixPtrV& input, DMatrixPtrV& output, bool fwd);
+
+    /** \brief Number of integer and real work vector entries, used as scatter workspace for the product */
+    virtual void nTmp(size_t& ni, size_t& nr){ ni=nr=this->dep(2).size1();}
     
     /** \brief Get the operation */
     virtual int getOp() const{ return OP_MATMUL;}
@@ -99,6 +102,9 @@ namespace CasADi{
     /** \brief  Clone function */
     virtual DenseMultiplication* clone() const{ return new DenseMultiplication(*this);}
 
+    /// Evaluate the function numerically, using the dense runtime kernels
+    virtual void evaluateD(const DMatrixPtrV& input, DMatrixPtrV& output, std::vector<int>& itmp, std::vector<double>& rtmp);
+
     /** \brief Generate code for the operation */
     virtual void generateOperation(std::ostream &stream, const std::vector<std::string>& arg, const std::vector<std::string>& res, CodeGenerator& gen) const;
   };
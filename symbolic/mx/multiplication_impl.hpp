@@ -28,6 +28,7 @@
 #include "mx_tools.hpp"
 #include "../std_vector_tools.hpp"
 #include "../function/function_internal.hpp"
+#include "../runtime/runtime_simd.hpp"
 
 using namespace std;
 
@@ -74,7 +75,7 @@ namespace CasADi{
     if(input[0]!=output[0]){
       copy(input[0]->begin(),input[0]->end(),output[0]->begin());
     }
-    Matrix<T>::mul_no_alloc_tn(*input[1],*input[2],*output[0]);
+    Matrix<T>::mul_no_alloc_tn(*input[1],*input[2],*output[0],getPtr(itmp),itmp.size(),getPtr(rtmp),rtmp.size());
   }
 
   template<bool TrX, bool TrY>
@@ -137,6 +138,21 @@ namespace CasADi{
     stream << res.front() << ",s" << gen.getSparsity(sparsity()) << ");" << endl;
   }
 
+  template<bool TrX, bool TrY>
+  void DenseMultiplication<TrX,TrY>::evaluateD(const DMatrixPtrV& input, DMatrixPtrV& output, std::vector<int>& itmp, std::vector<double>& rtmp){
+    if(input[0]!=output[0]){
+      copy(input[0]->begin(),input[0]->end(),output[0]->begin());
+    }
+    int ncol_y = this->dep(2).size2();
+    int nrow_y = this->dep(2).size1();
+    int ncol_x = this->dep(1).size2();
+    if(input[1]==input[2]){
+      casadi_syrk_tn(ncol_y,nrow_y,getPtr(input[2]->data()),nrow_y,getPtr(output[0]->data()),ncol_y);
+    } else {
+      casadi_gemm_tn(ncol_x,ncol_y,nrow_y,getPtr(input[1]->data()),nrow_y,getPtr(input[2]->data()),nrow_y,getPtr(output[0]->data()),ncol_x);
+    }
+  }
+
   template<bool TrX, bool TrY>
   void DenseMultiplication<TrX,TrY>::generateOperation(std::ostream &stream, const std::vector<std::string>& arg, const std::vector<std::string>& res, CodeGenerator& gen) const{
     // Check if inplace
@@ -150,10 +166,17 @@ namespace CasADi{
     int ncol_y = this->dep(2).size2();
     int nrow_y = this->dep(2).size1();
     int ncol_x = this->dep(1).size2();
-    stream << "  for(i=0, rr=" << res.front() <<"; i<" << ncol_y << "; ++i)";
-    stream << " for(j=0; j<" << ncol_x << "; ++j, ++rr)";
-    stream << " for(k=0, ss=" << arg.at(2) << "+i*" << nrow_y << ", tt=" << arg.at(1) << "+j*" << nrow_y << "; k<" << nrow_y << "; ++k)";
-    stream << " *rr += *ss++**tt++;" << endl;
+    if(arg.at(1).compare(arg.at(2))==0){
+      // Symmetric rank-k update if both factors are the same
+      gen.addAuxiliary(CodeGenerator::AUX_SYRK_TN);
+      stream << "  casadi_syrk_tn(" << ncol_y << "," << nrow_y << "," << arg.at(2) << "," << nrow_y << ",";
+      stream << res.front() << "," << ncol_y << ");" << endl;
+    } else {
+      gen.addAuxiliary(CodeGenerator::AUX_GEMM_TN);
+      stream << "  casadi_gemm_tn(" << ncol_x << "," << ncol_y << "," << nrow_y << ",";
+      stream << arg.at(1) << "," << nrow_y << "," << arg.at(2) << "," << nrow_y << ",";
+      stream << res.front() << "," << ncol_x << ");" << endl;
+    }
   }
 
 } // namespace CasADi
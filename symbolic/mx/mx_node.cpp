@@ -333,7 +333,7 @@ namespace CasADi{
     // Form result of the right sparsity
     MX z;
     if (sp_z.isNull()) {
-      Sparsity sp_z_ = y.sparsity().patternProduct(trans_x.sparsity());
+      Sparsity sp_z_ = sparsity().patternMultiply(y.sparsity());
       z = MX::zeros(sp_z_);
     } else {
       z = MX::zeros(sp_z);
@@ -341,7 +341,7 @@ namespace CasADi{
     casadi_assert_message(y.size2()==z.size2(),"Dimension error. Got y=" << y.size2() << " and z=" << z.dimString() << ".");
     casadi_assert_message(trans_x.size2()==z.size1(),"Dimension error. Got trans_x=" << trans_x.dimString() << " and z=" << z.dimString() << ".");
     casadi_assert_message(y.size1()==trans_x.size1(),"Dimension error. Got y=" << y.size1() << " and trans_x" << trans_x.dimString() << ".");
-    if(trans_x.isDense() && y.isDense()){
+    if(trans_x.isDense() && y.isDense() && z.isDense()){
       return MX::create(new DenseMultiplication<true,false>(z,trans_x,y));
     } else {
       return MX::create(new Multiplication<true,false>(z,trans_x,y));    
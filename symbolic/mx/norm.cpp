@@ -22,7 +22,7 @@
 
 #include "norm.hpp"
 #include "mx_tools.hpp"
-#include "../runtime/runtime.hpp"
+#include "../runtime/runtime_simd.hpp"
 
 using namespace std;
 namespace CasADi{
@@ -71,6 +71,9 @@ namespace CasADi{
     /** \brief  Propagate sparsity */
     virtual void propagateSparsity(DMatrixPtrV& input, DMatrixPtrV& output, std::vector<int>& itmp, std::vector<double>& rtmp, bool fwd);
 
+    /** \brief Generate code for the operation, using a dense LU factorization in the work vectors */
+    virtual void generateOperation(std::ostream &stream, const std::vector<std::string>& arg, const std::vector<std::string>& res, CodeGenerator& gen) const;
+
     /** \brief Get the operation */
     virtual int getOp() const{ return OP_SOLVE;}
 
@@ -83,8 +86,11 @@ namespace CasADi{
     /** \brief  Deep copy data members */
     virtual void deepCopyMembers(std::map<SharedObjectNode*,SharedObject>& already_copied);
 
-    /// Get number of temporary variables needed
-    virtual void nTmp(size_t& ni, size_t& nr){ ni=0; nr=sparsity().size1();}
+    /// Get number of temporary variables needed, including the dense LU factorization used by the generated code
+    virtual void nTmp(size_t& ni, size_t& nr);
+
+    /// Largest linear system for which code can be generated
+    static const int max_codegen_size = 100;
 
     /// Linear Solver (may be shared between multiple nodes)
     LinearSolver linear_solver_;
@@ -85,6 +85,50 @@ namespace CasADi{
     linear_solver_->propagateSparsityGen(input,output,itmp,rtmp,fwd,Tr);
   }
 
+  template<bool Tr>
+  void Solve<Tr>::generateOperation(std::ostream &stream, const std::vector<std::string>& arg, const std::vector<std::string>& res, CodeGenerator& gen) const{
+    int n = dep(1).size1();
+    int nrhs = dep(0).size2();
+
+    // Copy the right hand side if not inplace
+    if(arg.at(0).compare(res.front())!=0){
+      gen.copyVector(stream,arg.at(0),dep(0).size(),res.front());
+    }
+
+    // Factorize a dense copy of the matrix, stored in the work vectors (see nTmp)
+    if(n>max_codegen_size){
+      int max_size = max_codegen_size;
+      casadi_error("Solve::generateOperation: Code generation uses a dense LU factorization and is limited to linear systems with at most " << max_size << " equations, got " << n << ".");
+    }
+    if(dep(1).isDense()){
+      gen.addAuxiliary(CodeGenerator::AUX_COPY);
+      stream << "  casadi_copy(" << n*n << "," << arg.at(1) << ",1,rrr,1);" << endl;
+    } else {
+      gen.addAuxiliary(CodeGenerator::AUX_COPY_SPARSE);
+      int sp_dense = gen.addSparsity(Sparsity::dense(n,n));
+      stream << "  casadi_copy_sparse(" << arg.at(1) << ",s" << gen.getSparsity(dep(1).sparsity()) << ",rrr,s" << sp_dense << ");" << endl;
+    }
+    gen.addAuxiliary(CodeGenerator::AUX_GETRF);
+    stream << "  casadi_getrf(" << n << ",rrr," << n << ",iii);" << endl;
+
+    // Solve in-place
+    gen.addAuxiliary(CodeGenerator::AUX_GETRS);
+    stream << "  casadi_getrs(" << n << "," << nrhs << ",rrr," << n << ",iii," << res.front() << "," << n << "," << (Tr ? 1 : 0) << ");" << endl;
+  }
+
+  template<bool Tr>
+  void Solve<Tr>::nTmp(size_t& ni, size_t& nr){
+    ni = 0;
+    nr = sparsity().size1();
+
+    // Dense LU factorization and pivots for the generated code, larger systems are not supported
+    int n = dep(1).size1();
+    if(n<=max_codegen_size){
+      ni = std::max(ni,size_t(n));
+      nr = std::max(nr,size_t(n*n));
+    }
+  }
+
   template<bool Tr>
   void Solve<Tr>::deepCopyMembers(std::map<SharedObjectNode*, SharedObject>& already_copied) {
     MXNode::deepCopyMembers(already_copied);
@@ -77,6 +77,30 @@ namespace CasADi {
   template<typename real_t>
   void casadi_trans(const real_t* x, const int* sp_x, real_t* y, const int* sp_y, int *tmp);
 
+  /// GEMM, first argument transposed: C <- C + A'*B, with A k-by-m, B k-by-n and C m-by-n, dense column-major
+  template<typename real_t>
+  void casadi_gemm_tn(int m, int n, int k, const real_t* a, int lda, const real_t* b, int ldb, real_t* c, int ldc);
+
+  /// GEMM: C <- C + A*B, with A m-by-k, B k-by-n and C m-by-n, dense column-major
+  template<typename real_t>
+  void casadi_gemm_nn(int m, int n, int k, const real_t* a, int lda, const real_t* b, int ldb, real_t* c, int ldc);
+
+  /// SYRK, first argument transposed: C <- C + A'*A, with A k-by-n and C n-by-n, both triangles of C are updated
+  template<typename real_t>
+  void casadi_syrk_tn(int n, int k, const real_t* a, int lda, real_t* c, int ldc);
+
+  /// TRSM: B <- op(A)\B with A n-by-n triangular (lower or upper, optionally unit diagonal) and B n-by-nrhs
+  template<typename real_t>
+  void casadi_trsm(int n, int nrhs, const real_t* a, int lda, real_t* b, int ldb, int lower, int unit_diag, int transpose);
+
+  /// GETRF: In-place LU factorization with partial pivoting, P*A = L*U, as in LAPACK
+  template<typename real_t>
+  void casadi_getrf(int n, real_t* a, int lda, int* ipiv);
+
+  /// GETRS: B <- op(A)\B using the factorization from casadi_getrf
+  template<typename real_t>
+  void casadi_getrs(int n, int nrhs, const real_t* a, int lda, const int* ipiv, real_t* b, int ldb, int transpose);
+
 }
 
 // Implementations
@@ -97,6 +121,10 @@ namespace CasADi {
   template<typename real_t>
   void casadi_copy(int n, const real_t* x, int inc_x, real_t* y, int inc_y){
     int i;
+    if(inc_x==1 && inc_y==1){
+      for(i=0; i<n; ++i) y[i] = x[i];
+      return;
+    }
     for(i=0; i<n; ++i){
       *y = *x;
       x += inc_x;
@@ -158,6 +186,10 @@ namespace CasADi {
   template<typename real_t>
   void casadi_scal(int n, real_t alpha, real_t* x, int inc_x){
     int i;
+    if(inc_x==1){
+      for(i=0; i<n; ++i) x[i] *= alpha;
+      return;
+    }
     for(i=0; i<n; ++i){
       *x *= alpha;
       x += inc_x;
@@ -167,6 +199,10 @@ namespace CasADi {
   template<typename real_t>
   void casadi_axpy(int n, real_t alpha, const real_t* x, int inc_x, real_t* y, int inc_y){
     int i;
+    if(inc_x==1 && inc_y==1){
+      for(i=0; i<n; ++i) y[i] += alpha*x[i];
+      return;
+    }
     for(i=0; i<n; ++i){
       *y += alpha**x;
       x += inc_x;
@@ -178,6 +214,18 @@ namespace CasADi {
   real_t casadi_dot(int n, const real_t* x, int inc_x, const real_t* y, int inc_y){
     real_t r = 0;
     int i;
+    if(inc_x==1 && inc_y==1){
+      /* Independent partial sums, so that the loop can be vectorized */
+      real_t r1 = 0, r2 = 0, r3 = 0;
+      for(i=0; i+3<n; i+=4){
+        r  += x[i]*y[i];
+        r1 += x[i+1]*y[i+1];
+        r2 += x[i+2]*y[i+2];
+        r3 += x[i+3]*y[i+3];
+      }
+      for(; i<n; ++i) r += x[i]*y[i];
+      return (r+r1) + (r2+r3);
+    }
     for(i=0; i<n; ++i){
       r += *x**y;
       x += inc_x;
@@ -217,6 +265,10 @@ namespace CasADi {
   template<typename real_t>
   void casadi_fill(int n, real_t alpha, real_t* x, int inc_x){
     int i;
+    if(inc_x==1){
+      for(i=0; i<n; ++i) x[i] = alpha;
+      return;
+    }
     for(i=0; i<n; ++i){
       *x = alpha;
       x += inc_x;
@@ -270,6 +322,17 @@ namespace CasADi {
   real_t casadi_nrm2(int n, const real_t* x, int inc_x){
     real_t r = 0;
     int i;
+    if(inc_x==1){
+      real_t r1 = 0, r2 = 0, r3 = 0;
+      for(i=0; i+3<n; i+=4){
+        r  += x[i]*x[i];
+        r1 += x[i+1]*x[i+1];
+        r2 += x[i+2]*x[i+2];
+        r3 += x[i+3]*x[i+3];
+      }
+      for(; i<n; ++i) r += x[i]*x[i];
+      return sqrt((r+r1) + (r2+r3));
+    }
     for(i=0; i<n; ++i){
       r += *x**x;
       x += inc_x;
@@ -290,7 +353,128 @@ namespace CasADi {
       y[tmp[row_x[k]]++] = x[k];
     }
   }
-  
+
+  template<typename real_t>
+  void casadi_gemm_tn(int m, int n, int k, const real_t* a, int lda, const real_t* b, int ldb, real_t* c, int ldc){
+    int i, j;
+    for(i=0; i<n; ++i){
+      for(j=0; j<m; ++j){
+        c[j+i*ldc] += casadi_dot(k,a+j*lda,1,b+i*ldb,1);
+      }
+    }
+  }
+
+  template<typename real_t>
+  void casadi_gemm_nn(int m, int n, int k, const real_t* a, int lda, const real_t* b, int ldb, real_t* c, int ldc){
+    int i, l;
+    for(i=0; i<n; ++i){
+      for(l=0; l<k; ++l){
+        casadi_axpy(m,b[l+i*ldb],a+l*lda,1,c+i*ldc,1);
+      }
+    }
+  }
+
+  template<typename real_t>
+  void casadi_syrk_tn(int n, int k, const real_t* a, int lda, real_t* c, int ldc){
+    int i, j;
+    real_t t;
+    for(i=0; i<n; ++i){
+      for(j=0; j<=i; ++j){
+        t = casadi_dot(k,a+j*lda,1,a+i*lda,1);
+        c[j+i*ldc] += t;
+        if(j!=i) c[i+j*ldc] += t;
+      }
+    }
+  }
+
+  template<typename real_t>
+  void casadi_trsm(int n, int nrhs, const real_t* a, int lda, real_t* b, int ldb, int lower, int unit_diag, int transpose){
+    int i, j;
+    real_t* x;
+    for(i=0; i<nrhs; ++i){
+      x = b + i*ldb;
+      if(!transpose && lower){
+        /* Forward substitution, column oriented */
+        for(j=0; j<n; ++j){
+          if(!unit_diag) x[j] /= a[j+j*lda];
+          casadi_axpy(n-j-1,-x[j],a+j+1+j*lda,1,x+j+1,1);
+        }
+      } else if(!transpose){
+        /* Backward substitution, column oriented */
+        for(j=n-1; j>=0; --j){
+          if(!unit_diag) x[j] /= a[j+j*lda];
+          casadi_axpy(j,-x[j],a+j*lda,1,x,1);
+        }
+      } else if(lower){
+        /* Backward substitution with the transpose, row oriented */
+        for(j=n-1; j>=0; --j){
+          x[j] -= casadi_dot(n-j-1,a+j+1+j*lda,1,x+j+1,1);
+          if(!unit_diag) x[j] /= a[j+j*lda];
+        }
+      } else {
+        /* Forward substitution with the transpose, row oriented */
+        for(j=0; j<n; ++j){
+          x[j] -= casadi_dot(j,a+j*lda,1,x,1);
+          if(!unit_diag) x[j] /= a[j+j*lda];
+        }
+      }
+    }
+  }
+
+  template<typename real_t>
+  void casadi_getrf(int n, real_t* a, int lda, int* ipiv){
+    int i, j, p;
+    real_t t, pivot_value;
+    for(j=0; j<n; ++j){
+      /* Find the pivot */
+      p = j;
+      pivot_value = fabs(a[j+j*lda]);
+      for(i=j+1; i<n; ++i){
+        t = fabs(a[i+j*lda]);
+        if(t>pivot_value){
+          p = i;
+          pivot_value = t;
+        }
+      }
+      ipiv[j] = p;
+
+      /* Swap the rows */
+      if(p!=j) casadi_swap(n,a+j,lda,a+p,lda);
+
+      /* Compute the multipliers and update the trailing submatrix */
+      if(a[j+j*lda]!=0){
+        casadi_scal(n-j-1,1/a[j+j*lda],a+j+1+j*lda,1);
+      }
+      for(i=j+1; i<n; ++i){
+        casadi_axpy(n-j-1,-a[j+i*lda],a+j+1+j*lda,1,a+j+1+i*lda,1);
+      }
+    }
+  }
+
+  template<typename real_t>
+  void casadi_getrs(int n, int nrhs, const real_t* a, int lda, const int* ipiv, real_t* b, int ldb, int transpose){
+    int i, j;
+    if(!transpose){
+      /* Solve L*U*x = P*b */
+      for(i=0; i<nrhs; ++i){
+        for(j=0; j<n; ++j){
+          if(ipiv[j]!=j) casadi_swap(1,b+j+i*ldb,1,b+ipiv[j]+i*ldb,1);
+        }
+      }
+      casadi_trsm(n,nrhs,a,lda,b,ldb,1,1,0);
+      casadi_trsm(n,nrhs,a,lda,b,ldb,0,0,0);
+    } else {
+      /* Solve U'*L'*P*x = b */
+      casadi_trsm(n,nrhs,a,lda,b,ldb,0,0,1);
+      casadi_trsm(n,nrhs,a,lda,b,ldb,1,1,1);
+      for(i=0; i<nrhs; ++i){
+        for(j=n-1; j>=0; --j){
+          if(ipiv[j]!=j) casadi_swap(1,b+j+i*ldb,1,b+ipiv[j]+i*ldb,1);
+        }
+      }
+    }
+  }
+
 }
 
 /// \endcond
@@ -0,0 +1,184 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef CASADI_RUNTIME_SIMD_HPP
+#define CASADI_RUNTIME_SIMD_HPP
+
+#include "runtime.hpp"
+
+// Double precision overloads of the runtime kernels, vectorized with intrinsics for unit strides.
+// Unlike runtime.hpp, this file is not embedded in generated code, which relies on the C compiler
+// to vectorize the unit-stride loops of the templates instead. The instruction set is selected at
+// compile time from the flags CasADi is compiled with (e.g. -mavx2 -mfma, -mavx512f, or NEON on aarch64).
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#define CASADI_SIMD_WIDTH 8
+typedef __m512d casadi_simd_t;
+#define CASADI_SIMD_LOAD(p) _mm512_loadu_pd(p)
+#define CASADI_SIMD_STORE(p,v) _mm512_storeu_pd(p,v)
+#define CASADI_SIMD_SET1(a) _mm512_set1_pd(a)
+#define CASADI_SIMD_ZERO() _mm512_setzero_pd()
+#define CASADI_SIMD_ADD(a,b) _mm512_add_pd(a,b)
+#define CASADI_SIMD_MUL(a,b) _mm512_mul_pd(a,b)
+#define CASADI_SIMD_FMA(a,b,c) _mm512_fmadd_pd(a,b,c)
+#define CASADI_SIMD_SUM(v) _mm512_reduce_add_pd(v)
+#elif defined(__AVX__)
+#include <immintrin.h>
+#define CASADI_SIMD_WIDTH 4
+typedef __m256d casadi_simd_t;
+#define CASADI_SIMD_LOAD(p) _mm256_loadu_pd(p)
+#define CASADI_SIMD_STORE(p,v) _mm256_storeu_pd(p,v)
+#define CASADI_SIMD_SET1(a) _mm256_set1_pd(a)
+#define CASADI_SIMD_ZERO() _mm256_setzero_pd()
+#define CASADI_SIMD_ADD(a,b) _mm256_add_pd(a,b)
+#define CASADI_SIMD_MUL(a,b) _mm256_mul_pd(a,b)
+#ifdef __FMA__
+#define CASADI_SIMD_FMA(a,b,c) _mm256_fmadd_pd(a,b,c)
+#else
+#define CASADI_SIMD_FMA(a,b,c) _mm256_add_pd(_mm256_mul_pd(a,b),c)
+#endif
+inline double casadi_simd_sum(__m256d v){
+  __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v),_mm256_extractf128_pd(v,1));
+  return _mm_cvtsd_f64(_mm_add_sd(s,_mm_unpackhi_pd(s,s)));
+}
+#define CASADI_SIMD_SUM(v) casadi_simd_sum(v)
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define CASADI_SIMD_WIDTH 2
+typedef __m128d casadi_simd_t;
+#define CASADI_SIMD_LOAD(p) _mm_loadu_pd(p)
+#define CASADI_SIMD_STORE(p,v) _mm_storeu_pd(p,v)
+#define CASADI_SIMD_SET1(a) _mm_set1_pd(a)
+#define CASADI_SIMD_ZERO() _mm_setzero_pd()
+#define CASADI_SIMD_ADD(a,b) _mm_add_pd(a,b)
+#define CASADI_SIMD_MUL(a,b) _mm_mul_pd(a,b)
+#define CASADI_SIMD_FMA(a,b,c) _mm_add_pd(_mm_mul_pd(a,b),c)
+#define CASADI_SIMD_SUM(v) _mm_cvtsd_f64(_mm_add_sd(v,_mm_unpackhi_pd(v,v)))
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define CASADI_SIMD_WIDTH 2
+typedef float64x2_t casadi_simd_t;
+#define CASADI_SIMD_LOAD(p) vld1q_f64(p)
+#define CASADI_SIMD_STORE(p,v) vst1q_f64(p,v)
+#define CASADI_SIMD_SET1(a) vdupq_n_f64(a)
+#define CASADI_SIMD_ZERO() vdupq_n_f64(0)
+#define CASADI_SIMD_ADD(a,b) vaddq_f64(a,b)
+#define CASADI_SIMD_MUL(a,b) vmulq_f64(a,b)
+#define CASADI_SIMD_FMA(a,b,c) vfmaq_f64(c,a,b)
+#define CASADI_SIMD_SUM(v) vaddvq_f64(v)
+#endif
+
+/// \cond INTERNAL
+namespace CasADi {
+
+  /// AXPY, double precision
+  inline void casadi_axpy(int n, double alpha, const double* x, int inc_x, double* y, int inc_y){
+#ifdef CASADI_SIMD_WIDTH
+    if(inc_x==1 && inc_y==1){
+      casadi_simd_t a = CASADI_SIMD_SET1(alpha);
+      int i;
+      for(i=0; i+CASADI_SIMD_WIDTH<=n; i+=CASADI_SIMD_WIDTH){
+        CASADI_SIMD_STORE(y+i,CASADI_SIMD_FMA(a,CASADI_SIMD_LOAD(x+i),CASADI_SIMD_LOAD(y+i)));
+      }
+      for(; i<n; ++i) y[i] += alpha*x[i];
+      return;
+    }
+#endif // CASADI_SIMD_WIDTH
+    casadi_axpy<double>(n,alpha,x,inc_x,y,inc_y);
+  }
+
+  /// SCAL, double precision
+  inline void casadi_scal(int n, double alpha, double* x, int inc_x){
+#ifdef CASADI_SIMD_WIDTH
+    if(inc_x==1){
+      casadi_simd_t a = CASADI_SIMD_SET1(alpha);
+      int i;
+      for(i=0; i+CASADI_SIMD_WIDTH<=n; i+=CASADI_SIMD_WIDTH){
+        CASADI_SIMD_STORE(x+i,CASADI_SIMD_MUL(a,CASADI_SIMD_LOAD(x+i)));
+      }
+      for(; i<n; ++i) x[i] *= alpha;
+      return;
+    }
+#endif // CASADI_SIMD_WIDTH
+    casadi_scal<double>(n,alpha,x,inc_x);
+  }
+
+  /// DOT, double precision
+  inline double casadi_dot(int n, const double* x, int inc_x, const double* y, int inc_y){
+#ifdef CASADI_SIMD_WIDTH
+    if(inc_x==1 && inc_y==1){
+      // Two independent accumulators to hide the latency of the additions
+      casadi_simd_t s0 = CASADI_SIMD_ZERO(), s1 = CASADI_SIMD_ZERO();
+      int i;
+      for(i=0; i+2*CASADI_SIMD_WIDTH<=n; i+=2*CASADI_SIMD_WIDTH){
+        s0 = CASADI_SIMD_FMA(CASADI_SIMD_LOAD(x+i),CASADI_SIMD_LOAD(y+i),s0);
+        s1 = CASADI_SIMD_FMA(CASADI_SIMD_LOAD(x+i+CASADI_SIMD_WIDTH),CASADI_SIMD_LOAD(y+i+CASADI_SIMD_WIDTH),s1);
+      }
+      double r = CASADI_SIMD_SUM(CASADI_SIMD_ADD(s0,s1));
+      for(; i<n; ++i) r += x[i]*y[i];
+      return r;
+    }
+#endif // CASADI_SIMD_WIDTH
+    return casadi_dot<double>(n,x,inc_x,y,inc_y);
+  }
+
+  /// NRM2, double precision
+  inline double casadi_nrm2(int n, const double* x, int inc_x){
+#ifdef CASADI_SIMD_WIDTH
+    if(inc_x==1) return sqrt(casadi_dot(n,x,1,x,1));
+#endif // CASADI_SIMD_WIDTH
+    return casadi_nrm2<double>(n,x,inc_x);
+  }
+
+  /// GEMM, first argument transposed, double precision
+  inline void casadi_gemm_tn(int m, int n, int k, const double* a, int lda, const double* b, int ldb, double* c, int ldc){
+    for(int i=0; i<n; ++i){
+      for(int j=0; j<m; ++j){
+        c[j+i*ldc] += casadi_dot(k,a+j*lda,1,b+i*ldb,1);
+      }
+    }
+  }
+
+  /// GEMM, double precision
+  inline void casadi_gemm_nn(int m, int n, int k, const double* a, int lda, const double* b, int ldb, double* c, int ldc){
+    for(int i=0; i<n; ++i){
+      for(int l=0; l<k; ++l){
+        casadi_axpy(m,b[l+i*ldb],a+l*lda,1,c+i*ldc,1);
+      }
+    }
+  }
+
+  /// SYRK, first argument transposed, double precision
+  inline void casadi_syrk_tn(int n, int k, const double* a, int lda, double* c, int ldc){
+    for(int i=0; i<n; ++i){
+      for(int j=0; j<=i; ++j){
+        double t = casadi_dot(k,a+j*lda,1,a+i*lda,1);
+        c[j+i*ldc] += t;
+        if(j!=i) c[i+j*ldc] += t;
+      }
+    }
+  }
+
+} // namespace CasADi
+/// \endcond
+
+#endif // CASADI_RUNTIME_SIMD_HPP
@@ -0,0 +1,190 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/** \brief Checks that the iterations of the SQP method do not allocate heap memory
+ *
+ * The global operator new is replaced by a counting version. The QP solver is wrapped in a
+ * function that records the allocation counter each time it is called, i.e. once per SQP iteration,
+ * and pauses the counting while the QP is being solved, since qpOASES allocates internally.
+ * The first solution is a warm-up; in the second one, every iteration must leave the counter
+ * unchanged. The program returns a nonzero exit status otherwise.
+ */
+
+#include <symbolic/casadi.hpp>
+#include <symbolic/function/qp_solver_internal.hpp>
+#include <nonlinear_programming/sqp_method.hpp>
+#include <interfaces/qpoases/qpoases_solver.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+using namespace CasADi;
+using namespace std;
+
+namespace{
+  // Number of allocations counted so far
+  long num_alloc = 0;
+
+  // Allocations are only counted when this is set
+  bool counting = false;
+}
+
+void* operator new(size_t n){
+  if(counting) num_alloc++;
+  void* ret = malloc(n==0 ? 1 : n);
+  if(ret==0) throw std::bad_alloc();
+  return ret;
+}
+
+void operator delete(void* p){
+  free(p);
+}
+
+void* operator new[](size_t n){
+  return operator new(n);
+}
+
+void operator delete[](void* p){
+  operator delete(p);
+}
+
+void operator delete(void* p, size_t n){
+  operator delete(p);
+}
+
+void operator delete[](void* p, size_t n){
+  operator delete(p);
+}
+
+namespace{
+  /// qpOASES, recording the allocation counter at each call and not counting its own allocations
+  class RecordingQPInternal : public QPSolverInternal{
+  public:
+    explicit RecordingQPInternal(const std::vector<Sparsity>& st) : QPSolverInternal(st){}
+    virtual RecordingQPInternal* clone() const{ return new RecordingQPInternal(*this);}
+
+    virtual void init(){
+      QPSolverInternal::init();
+      qp_ = QPOasesSolver(qpStruct("h",st_[QP_STRUCT_H],"a",st_[QP_STRUCT_A]));
+      qp_.setOption("printLevel","none");
+      qp_.init();
+      record_ = false;
+      calls_.clear();
+      calls_.reserve(1000);
+    }
+
+    virtual void evaluate(){
+      if(record_ && calls_.size()<calls_.capacity()) calls_.push_back(num_alloc);
+      bool was_counting = counting;
+      counting = false;
+      for(int i=0; i<getNumInputs(); ++i) qp_.setInput(input(i),i);
+      qp_.evaluate();
+      for(int i=0; i<getNumOutputs(); ++i) output(i).set(qp_.output(i));
+      counting = was_counting;
+    }
+
+    /// Allocation counter at each call
+    std::vector<long> calls_;
+
+    /// Record the calls
+    bool record_;
+
+    /// The actual QP solver
+    QPSolver qp_;
+  };
+
+  /// Handle and creator
+  QPSolver recordingQPSolver(const QPStructure& st){
+    QPSolver ret;
+    ret.assignNode(new RecordingQPInternal(st));
+    return ret;
+  }
+
+  /// Solve twice, returns the number of iterations in the second solve that allocated
+  int check(const string& name, SXFunction nlp, const string& hessian_approximation, double x0, double lbg, double ubg){
+    SQPMethod solver(nlp);
+    solver.setOption("qp_solver",recordingQPSolver);
+    solver.setOption("hessian_approximation",hessian_approximation);
+    solver.setOption("print_header",false);
+    solver.setOption("print_time",false);
+    solver.init();
+    solver.setInput(x0,"x0");
+    solver.setInput(lbg,"lbg");
+    solver.setInput(ubg,"ubg");
+
+    // Warm-up
+    solver.evaluate();
+
+    // Steady state
+    QPSolver qp_solver = solver.getQPSolver();
+    RecordingQPInternal* qp = static_cast<RecordingQPInternal*>(qp_solver.get());
+    qp->record_ = true;
+    num_alloc = 0;
+    counting = true;
+    solver.evaluate();
+    counting = false;
+    qp->record_ = false;
+
+    int failed = 0;
+    for(int k=1; k<qp->calls_.size(); ++k){
+      long n = qp->calls_[k] - qp->calls_[k-1];
+      if(n>0){
+        cerr << name << ", " << hessian_approximation << ": " << n << " allocations in iteration " << k << endl;
+        failed++;
+      }
+    }
+    cout << name << ", " << hessian_approximation << ": " << qp->calls_.size() << " iterations, "
+         << (failed ? "FAILED" : "no allocations") << endl;
+    return failed;
+  }
+} // namespace
+
+int main(){
+  int failed = 0;
+
+  // Rosenbrock function with a linear constraint
+  {
+    SX x = SX::sym("x"), y = SX::sym("y");
+    SX f = sq(1-x) + 100*sq(y-sq(x));
+    SXFunction nlp(nlpIn("x",vertcat(x,y)),nlpOut("f",f,"g",x+y));
+    failed += check("rosenbrock",nlp,"exact",0.5,-10,10);
+    failed += check("rosenbrock",nlp,"limited-memory",0.5,-10,10);
+  }
+
+  // Points projected onto the unit circle, block diagonal Hessian of the Lagrangian
+  {
+    int n = 10;
+    SX x = SX::sym("x",n), y = SX::sym("y",n);
+    SX f = 0;
+    vector<SX> g;
+    for(int i=0; i<n; ++i){
+      f += sq(x.at(i)-2) + sq(y.at(i)-double(i)/n);
+      g.push_back(sq(x.at(i)) + sq(y.at(i)));
+    }
+    SXFunction nlp(nlpIn("x",vertcat(x,y)),nlpOut("f",f,"g",vertcat(g)));
+    failed += check("circle",nlp,"exact",0.1,0,1);
+    failed += check("circle",nlp,"limited-memory",0.1,0,1);
+    failed += check("circle",nlp,"partitioned-bfgs",0.1,0,1);
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/** \brief Checks Function::evaluateBatch against evaluate
+ *
+ * A batch with some missing inputs is evaluated with one and with several threads. Each result
+ * must match a separate call to evaluate with the same inputs, where missing inputs take the
+ * value they had before the batch, and the inputs and outputs of the function must be unchanged
+ * afterwards. The program returns a nonzero exit status otherwise.
+ */
+
+#include <symbolic/casadi.hpp>
+#include <integration/rk_integrator.hpp>
+#include <cstdlib>
+#include <iostream>
+
+using namespace CasADi;
+using namespace std;
+
+namespace{
+  /// Stores a copy of the outputs of each evaluation
+  class StoringSink : public BatchSink{
+  public:
+    explicit StoringSink(int n) : res(n), ncalls(0){}
+
+    virtual void operator()(int ind, const vector<const DMatrix*>& r){
+      res.at(ind).resize(r.size());
+      for(int i=0; i<r.size(); ++i) res[ind][i] = *r[i];
+      ncalls++;
+    }
+
+    vector<vector<DMatrix> > res;
+    int ncalls;
+  };
+
+  /// Evaluate a batch and compare with evaluate, returns the number of failures
+  int check(const string& name, Function f, const vector<vector<DMatrix> >& arg, int nthreads){
+    int failed = 0;
+    int n = arg.size();
+
+    // Inputs and outputs before the call
+    vector<DMatrix> input0(f.getNumInputs()), output0(f.getNumOutputs());
+    for(int i=0; i<input0.size(); ++i) input0[i] = f.input(i);
+    for(int i=0; i<output0.size(); ++i) output0[i] = f.output(i);
+
+    StoringSink sink(n);
+    f.evaluateBatch(arg,sink,nthreads);
+    if(sink.ncalls!=n){
+      cerr << name << ": " << sink.ncalls << " results instead of " << n << endl;
+      failed++;
+    }
+
+    // The function is unchanged
+    for(int i=0; i<input0.size(); ++i){
+      if(!isEqual(f.input(i),input0[i])){
+        cerr << name << ": input " << i << " modified" << endl;
+        failed++;
+      }
+    }
+    for(int i=0; i<output0.size(); ++i){
+      if(!isEqual(f.output(i),output0[i])){
+        cerr << name << ": output " << i << " modified" << endl;
+        failed++;
+      }
+    }
+
+    // Compare with evaluate
+    Function g = deepcopy(f);
+    for(int k=0; k<n; ++k){
+      for(int i=0; i<input0.size(); ++i){
+        g.setInput(i<arg[k].size() && !arg[k][i].isEmpty() ? arg[k][i] : input0[i],i);
+      }
+      g.evaluate();
+      for(int i=0; i<g.getNumOutputs() && k<sink.res.size() && i<sink.res[k].size(); ++i){
+        if(!isEqual(sink.res[k][i],g.output(i))){
+          cerr << name << ": evaluation " << k << ", output " << i << " differs" << endl;
+          failed++;
+        }
+      }
+    }
+    cout << name << ", " << nthreads << " thread(s): " << (failed ? "FAILED" : "ok") << endl;
+    return failed;
+  }
+} // namespace
+
+int main(){
+  int failed = 0;
+
+  // Inputs, some of them missing
+  int n = 20;
+  vector<vector<DMatrix> > arg(n);
+  for(int k=0; k<n; ++k){
+    arg[k].resize(k%3==0 ? 1 : 2);
+    if(k%4!=0) arg[k][0] = DMatrix::ones(2,1)*(0.1*k);
+    if(arg[k].size()>1) arg[k][1] = 0.5+0.05*k;
+  }
+
+  // SXFunction
+  SX x = SX::sym("x",2), p = SX::sym("p");
+  SXFunction f(daeIn("x",x,"p",p),daeOut("ode",vertcat(x(1)*p,-sin(SX(x(0))))));
+  f.init();
+  f.setInput(DMatrix::ones(2,1)*0.3,DAE_X);
+  f.setInput(2.0,DAE_P);
+  f.evaluate();
+  vector<vector<DMatrix> > dae_arg(n,vector<DMatrix>(DAE_NUM_IN));
+  for(int k=0; k<n; ++k){
+    dae_arg[k][DAE_X] = arg[k][0];
+    if(arg[k].size()>1) dae_arg[k][DAE_P] = arg[k][1];
+  }
+  for(int nthreads=1; nthreads<=4; nthreads+=3){
+    failed += check("SXFunction",f,dae_arg,nthreads);
+  }
+
+  // Integrator in an MXFunction
+  RKIntegrator integrator(f);
+  integrator.setOption("tf",0.5);
+  integrator.init();
+  MX x0 = MX::sym("x0",2), p0 = MX::sym("p0");
+  MXFunction F(integratorIn("x0",x0,"p",p0),integrator.call(integratorIn("x0",x0,"p",p0)));
+  F.init();
+  F.setInput(DMatrix::ones(2,1)*0.2,INTEGRATOR_X0);
+  F.setInput(1.5,INTEGRATOR_P);
+  F.evaluate();
+  for(int nthreads=1; nthreads<=4; nthreads+=3){
+    failed += check("MXFunction",F,arg,nthreads);
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,275 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/** \brief Driver of the C++ benchmark suite
+ *
+ * Usage: casadi_benchmarks [--filter=<substring>] [--min_time=<seconds>] [--max_iter=<n>] [--json=<file>] [--list]
+ *
+ * Runs all registered benchmarks whose "group/name" contains the filter string, prints a table
+ * and, with --json, writes the results together with the build information to a file that can
+ * be compared between revisions. The exit code is nonzero if any benchmark threw an exception.
+ */
+
+#include "benchmark.hpp"
+#include <symbolic/casadi_meta.hpp>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#ifdef _WIN32
+#include <windows.h>
+#else // _WIN32
+#include <sys/time.h>
+#endif // _WIN32
+
+using namespace std;
+
+namespace CasADi{
+  namespace Benchmarks{
+
+    /// A registered benchmark
+    struct Entry{
+      string group;
+      string name;
+      BenchmarkFunction f;
+      bool operator<(const Entry& e) const{ return group<e.group || (group==e.group && name<e.name);}
+    };
+    
+    /// All registered benchmarks, constructed on first use to be independent of the static initialization order
+    vector<Entry>& registry(){
+      static vector<Entry> r;
+      return r;
+    }
+    
+    Registrar::Registrar(const char* group, const char* name, BenchmarkFunction f){
+      Entry e = {group, name, f};
+      registry().push_back(e);
+    }
+    
+    /// Wall-clock time [s], independent of the profiling build option
+    double wallTime(){
+#ifdef _WIN32
+      LARGE_INTEGER t, f;
+      QueryPerformanceCounter(&t);
+      QueryPerformanceFrequency(&f);
+      return double(t.QuadPart)/double(f.QuadPart);
+#else // _WIN32
+      timeval t;
+      gettimeofday(&t,0);
+      return t.tv_sec + 1e-6*t.tv_usec;
+#endif // _WIN32
+    }
+    
+    State::State(double min_time, int max_iter) : min_time_(min_time), max_iter_(max_iter), started_(false), t_start_(0), t_last_(0){
+    }
+    
+    bool State::keepRunning(){
+      double t = wallTime();
+      if(!started_){
+        started_ = true;
+        t_start_ = t_last_ = t;
+        return true;
+      }
+      times_.push_back(t-t_last_);
+      t_last_ = t;
+      return t-t_start_<min_time_ && times_.size()<max_iter_;
+    }
+    
+    /// Result of one benchmark
+    struct Result{
+      string group, name, error;
+      int iterations;
+      double min_time, median_time, mean_time;
+      map<string,double> counters;
+    };
+    
+    /// Escape a string for JSON output
+    string jsonString(const string& s){
+      stringstream ss;
+      ss << '"';
+      for(string::const_iterator c=s.begin(); c!=s.end(); ++c){
+        switch(*c){
+          case '"':  ss << "\\\""; break;
+          case '\\': ss << "\\\\"; break;
+          case '\n': ss << "\\n"; break;
+          case '\t': ss << "\\t"; break;
+          default:
+            if(static_cast<unsigned char>(*c)<0x20){
+              ss << "\\u" << hex << setw(4) << setfill('0') << int(*c) << dec << setfill(' ');
+            } else {
+              ss << *c;
+            }
+        }
+      }
+      ss << '"';
+      return ss.str();
+    }
+    
+    /// Format a time in seconds with a suitable unit
+    string formatTime(double t){
+      stringstream ss;
+      ss << fixed << setprecision(3);
+      if(t<1e-3){
+        ss << t*1e6 << " us";
+      } else if(t<1){
+        ss << t*1e3 << " ms";
+      } else {
+        ss << t << " s";
+      }
+      return ss.str();
+    }
+    
+    void writeJson(ostream& stream, const vector<Result>& results, double min_time){
+      char date[64];
+      time_t now = time(0);
+      strftime(date,sizeof(date),"%Y-%m-%dT%H:%M:%SZ",gmtime(&now));
+      stream << setprecision(9);
+      stream << "{" << endl;
+      stream << "  \"context\": {" << endl;
+      stream << "    \"date\": " << jsonString(date) << "," << endl;
+      stream << "    \"casadi_version\": " << jsonString(CasadiMeta::getVersion()) << "," << endl;
+      stream << "    \"git_revision\": " << jsonString(CasadiMeta::getGitRevision()) << "," << endl;
+      stream << "    \"git_describe\": " << jsonString(CasadiMeta::getGitDescribe()) << "," << endl;
+      stream << "    \"build_type\": " << jsonString(CasadiMeta::getBuildType()) << "," << endl;
+      stream << "    \"compiler\": " << jsonString(CasadiMeta::getCompiler()) << "," << endl;
+      stream << "    \"compiler_flags\": " << jsonString(CasadiMeta::getCompilerFlags()) << "," << endl;
+      stream << "    \"min_time\": " << min_time << "," << endl;
+      stream << "    \"time_unit\": \"s\"" << endl;
+      stream << "  }," << endl;
+      stream << "  \"benchmarks\": [" << endl;
+      for(int i=0; i<results.size(); ++i){
+        const Result& r = results[i];
+        stream << "    {\"group\": " << jsonString(r.group) << ", \"name\": " << jsonString(r.name);
+        if(r.error.empty()){
+          stream << ", \"iterations\": " << r.iterations << ", \"min_time\": " << r.min_time
+                 << ", \"median_time\": " << r.median_time << ", \"mean_time\": " << r.mean_time;
+          stream << ", \"counters\": {";
+          for(map<string,double>::const_iterator it=r.counters.begin(); it!=r.counters.end(); ++it){
+            if(it!=r.counters.begin()) stream << ", ";
+            stream << jsonString(it->first) << ": " << it->second;
+          }
+          stream << "}";
+        } else {
+          stream << ", \"error\": " << jsonString(r.error);
+        }
+        stream << "}" << (i+1<results.size() ? "," : "") << endl;
+      }
+      stream << "  ]" << endl;
+      stream << "}" << endl;
+    }
+    
+  } // namespace Benchmarks
+} // namespace CasADi
+
+using namespace CasADi;
+using namespace CasADi::Benchmarks;
+
+int main(int argc, char* argv[]){
+  string filter, json;
+  double min_time = 0.5;
+  int max_iter = 1000000;
+  bool list = false;
+  for(int i=1; i<argc; ++i){
+    string arg = argv[i];
+    if(arg.compare(0,9,"--filter=")==0){
+      filter = arg.substr(9);
+    } else if(arg.compare(0,11,"--min_time=")==0){
+      min_time = atof(arg.substr(11).c_str());
+    } else if(arg.compare(0,11,"--max_iter=")==0){
+      max_iter = atoi(arg.substr(11).c_str());
+    } else if(arg.compare(0,7,"--json=")==0){
+      json = arg.substr(7);
+    } else if(arg=="--list"){
+      list = true;
+    } else {
+      cerr << "Usage: " << argv[0] << " [--filter=<substring>] [--min_time=<seconds>] [--max_iter=<n>] [--json=<file>] [--list]" << endl;
+      return 1;
+    }
+  }
+  
+  vector<Entry> entries = registry();
+  sort(entries.begin(),entries.end());
+  
+  if(!list) cout << left << setw(48) << "benchmark" << right << setw(10) << "iter" << setw(14) << "min" << setw(14) << "median" << setw(14) << "mean" << endl;
+  vector<Result> results;
+  bool failed = false;
+  for(vector<Entry>::const_iterator e=entries.begin(); e!=entries.end(); ++e){
+    string id = e->group + "/" + e->name;
+    if(id.find(filter)==string::npos) continue;
+    if(list){
+      cout << id << endl;
+      continue;
+    }
+    
+    Result r;
+    r.group = e->group;
+    r.name = e->name;
+    State state(min_time,max_iter);
+    
+    // Silence the solvers while running
+    stringstream sink;
+    streambuf* cout_buf = cout.rdbuf(sink.rdbuf());
+    streambuf* cerr_buf = cerr.rdbuf(sink.rdbuf());
+    try{
+      e->f(state);
+    } catch(exception& ex){
+      r.error = ex.what();
+    }
+    cout.rdbuf(cout_buf);
+    cerr.rdbuf(cerr_buf);
+    
+    vector<double> t = state.times();
+    if(r.error.empty() && t.empty()) r.error = "State::keepRunning was never called";
+    if(!r.error.empty()){
+      failed = true;
+      cout << left << setw(48) << id << right << "  failed: " << r.error << endl;
+      results.push_back(r);
+      continue;
+    }
+    sort(t.begin(),t.end());
+    r.iterations = t.size();
+    r.min_time = t.front();
+    r.median_time = t.size() % 2 ? t[t.size()/2] : (t[t.size()/2-1]+t[t.size()/2])/2;
+    double sum = 0;
+    for(int i=0; i<t.size(); ++i) sum += t[i];
+    r.mean_time = sum/t.size();
+    r.counters = state.counters();
+    results.push_back(r);
+    
+    cout << left << setw(48) << id << right << setw(10) << r.iterations << setw(14) << formatTime(r.min_time)
+         << setw(14) << formatTime(r.median_time) << setw(14) << formatTime(r.mean_time) << endl;
+  }
+  
+  if(!json.empty()){
+    ofstream file(json.c_str());
+    if(!file.good()){
+      cerr << "Cannot open " << json << " for writing." << endl;
+      return 1;
+    }
+    writeJson(file,results,min_time);
+  }
+  
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,94 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#ifndef CASADI_BENCHMARK_HPP
+#define CASADI_BENCHMARK_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+
+/** \brief Minimal benchmark harness for the C++ benchmark suite
+ *
+ * A benchmark is a function taking a State. Everything before the first call to
+ * State::keepRunning() is setup and is not timed. Each pass through the loop is timed
+ * separately, until the minimum time or the maximum number of iterations is reached:
+ *
+ * \code
+ * CASADI_BENCHMARK(symbolic, sx_evaluate){
+ *   SXFunction f = ...;
+ *   f.init();
+ *   while(state.keepRunning()){
+ *     f.evaluate();
+ *   }
+ * }
+ * \endcode
+ */
+namespace CasADi{
+  namespace Benchmarks{
+  
+    /// State of a running benchmark
+    class State{
+    public:
+      /// Constructor
+      State(double min_time, int max_iter);
+      
+      /// Returns true as long as the benchmark body should be executed once more
+      bool keepRunning();
+      
+      /// Attach a named result (problem size, solver iterations, ...) to the benchmark
+      void setCounter(const std::string& name, double value){ counters_[name] = value;}
+      
+      /// Wall-clock times of the individual iterations [s]
+      const std::vector<double>& times() const{ return times_;}
+
+      /// Counters set by the benchmark
+      const std::map<std::string,double>& counters() const{ return counters_;}
+      
+    private:
+      double min_time_;
+      int max_iter_;
+      bool started_;
+      double t_start_, t_last_;
+      std::vector<double> times_;
+      std::map<std::string,double> counters_;
+    };
+    
+    /// Signature of a benchmark
+    typedef void (*BenchmarkFunction)(State& state);
+    
+    /// Registers a benchmark at static initialization
+    class Registrar{
+    public:
+      Registrar(const char* group, const char* name, BenchmarkFunction f);
+    };
+    
+  } // namespace Benchmarks
+} // namespace CasADi
+
+/// Define and register a benchmark, the body has access to a CasADi::Benchmarks::State named state
+#define CASADI_BENCHMARK(group, name) \
+  static void casadi_benchmark_##group##_##name(CasADi::Benchmarks::State& state); \
+  static CasADi::Benchmarks::Registrar casadi_benchmark_registrar_##group##_##name(#group, #name, casadi_benchmark_##group##_##name); \
+  static void casadi_benchmark_##group##_##name(CasADi::Benchmarks::State& state)
+
+#endif // CASADI_BENCHMARK_HPP
@@ -0,0 +1,155 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/** \brief Checks that the unidirectional colorings of Jacobian sparsity patterns are valid
+ *
+ * Every column must get exactly one color, and no two columns with the same color may share a row.
+ * The serial and the speculative parallel coloring are checked for several patterns, orderings and
+ * thread counts, and a Jacobian computed with coloring_threads>1 must match the serial one. Without
+ * OpenMP, the parallel coloring falls back to the serial algorithm. The program returns a nonzero
+ * exit status if a check fails.
+ */
+
+#include <symbolic/casadi.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+using namespace CasADi;
+using namespace std;
+
+namespace{
+  int failed = 0;
+
+  void check(bool cond, const string& msg){
+    if(!cond){
+      cerr << "FAILED: " << msg << endl;
+      failed++;
+    }
+  }
+
+  /// Check that D (columns of A by colors) is a valid unidirectional coloring of A
+  bool isValidColoring(const Sparsity& A, const Sparsity& D){
+    if(D.isNull() || D.size1()!=A.size2()) return false;
+
+    // Each column has exactly one color
+    vector<int> ncolors(A.size2(),0);
+    for(int el=0; el<D.size(); ++el) ncolors[D.row(el)]++;
+    for(int c=0; c<A.size2(); ++c){
+      if(ncolors[c]!=1) return false;
+    }
+
+    // The columns of a color are structurally orthogonal
+    vector<int> row_color(A.size1(),-1);
+    for(int color=0; color<D.size2(); ++color){
+      for(int el=D.colind(color); el<D.colind(color+1); ++el){
+        int c = D.row(el);
+        for(int k=A.colind(c); k<A.colind(c+1); ++k){
+          if(row_color[A.row(k)]==color) return false;
+          row_color[A.row(k)] = color;
+        }
+      }
+    }
+    return true;
+  }
+
+  /// Random pattern with nnz_per_col entries in each column, plus some dense rows and columns
+  Sparsity randomPattern(int nrow, int ncol, int nnz_per_col, int ndense){
+    vector<int> row, col;
+    for(int c=0; c<ncol; ++c){
+      for(int k=0; k<nnz_per_col; ++k){
+        row.push_back(rand() % nrow);
+        col.push_back(c);
+      }
+    }
+    for(int d=0; d<ndense; ++d){
+      int r = rand() % nrow, c0 = rand() % ncol;
+      for(int c=0; c<ncol; ++c){ row.push_back(r); col.push_back(c);}
+      for(int r2=0; r2<nrow; ++r2){ row.push_back(r2); col.push_back(c0);}
+    }
+    return Sparsity::triplet(nrow,ncol,row,col);
+  }
+} // namespace
+
+int main(){
+  srand(0);
+
+  // Test patterns
+  vector<pair<string,Sparsity> > patterns;
+  patterns.push_back(make_pair("diagonal",Sparsity::diag(100)));
+  patterns.push_back(make_pair("banded",Sparsity::banded(200,3)));
+  patterns.push_back(make_pair("dense",Sparsity::dense(20,30)));
+  patterns.push_back(make_pair("empty",Sparsity::sparse(10,15)));
+  patterns.push_back(make_pair("random",randomPattern(300,400,4,0)));
+  patterns.push_back(make_pair("random with dense rows",randomPattern(500,300,3,2)));
+  patterns.push_back(make_pair("tall random",randomPattern(1000,50,10,0)));
+
+#ifdef WITH_OPENMP
+  cout << "Checking the speculative parallel coloring" << endl;
+#else
+  cout << "Compiled without OpenMP, the parallel coloring falls back to the serial one" << endl;
+#endif // WITH_OPENMP
+
+  for(int p=0; p<patterns.size(); ++p){
+    const string& name = patterns[p].first;
+    const Sparsity& A = patterns[p].second;
+    Sparsity AT = A.transpose();
+    for(int ordering=0; ordering<=3; ++ordering){
+      stringstream ss;
+      ss << name << ", ordering " << ordering;
+      Sparsity D = A.unidirectionalColoring(AT,numeric_limits<int>::max(),ordering);
+      check(isValidColoring(A,D),ss.str() + ", serial");
+      for(int nthreads=1; nthreads<=8; nthreads*=2){
+        Sparsity D_par = A.unidirectionalColoringParallel(AT,nthreads,ordering);
+        stringstream ss_par;
+        ss_par << ss.str() << ", " << nthreads << " threads";
+        check(isValidColoring(A,D_par),ss_par.str());
+      }
+    }
+  }
+
+  // Jacobian with coloring_threads>1 against the serial one
+  int n = 60;
+  SX x = SX::sym("x",n);
+  vector<SXElement> y(n);
+  for(int i=0; i<n; ++i){
+    y[i] = sin(x.at(i))*x.at((7*i+3)%n) + x.at((i+1)%n)*x.at((i+1)%n);
+  }
+  DMatrix x0 = DMatrix::zeros(n,1);
+  for(int i=0; i<n; ++i) x0.at(i) = 0.1*i-1;
+  DMatrix J[2];
+  for(int k=0; k<2; ++k){
+    SXFunction f(x,SX(y));
+    f.setOption("coloring_threads",k==0 ? 1 : 4);
+    f.init();
+    Function Jf = f.jacobian();
+    Jf.init();
+    Jf.setInput(x0);
+    Jf.evaluate();
+    J[k] = Jf.output();
+  }
+  check(J[0].sparsity()==J[1].sparsity() && isEqual(J[0],J[1]),"Jacobian with coloring_threads=4");
+
+  cout << (failed ? "FAILED" : "ok") << endl;
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include "benchmark.hpp"
+#include <symbolic/casadi.hpp>
+#include <integration/rk_integrator.hpp>
+#include <integration/collocation_integrator.hpp>
+#include <integration/dormand_prince_integrator.hpp>
+#include <nonlinear_programming/newton_implicit_solver.hpp>
+#include <interfaces/csparse/csparse.hpp>
+#ifdef WITH_SUNDIALS
+#include <interfaces/sundials/cvodes_integrator.hpp>
+#endif // WITH_SUNDIALS
+
+using namespace CasADi;
+using namespace std;
+
+namespace{
+  /// Van der Pol oscillator with a parameter entering the damping
+  SXFunction vdp(){
+    SX x = SX::sym("x",2), p = SX::sym("p");
+    vector<SX> ode(2);
+    ode[0] = p*(1-sq(x.at(1)))*x.at(0) - x.at(1);
+    ode[1] = x.at(0);
+    SXFunction f(daeIn("x",x,"p",p),daeOut("ode",vertcat(ode)));
+    return f;
+  }
+
+  /// Integrate the Van der Pol oscillator over [0,10], optionally with a forward sensitivity direction
+  void integrate(Benchmarks::State& state, Integrator I, bool fsens){
+    I.setOption("tf",10.0);
+    I.init();
+    vector<double> x0(2);
+    x0[0] = 0;
+    x0[1] = 1;
+    if(fsens){
+      Function F = I.derivative(1,0);
+      F.setInput(x0,INTEGRATOR_X0);
+      F.setInput(1.0,INTEGRATOR_P);
+      F.setInput(1.0,INTEGRATOR_NUM_IN+INTEGRATOR_P);
+      while(state.keepRunning()){
+        F.evaluate();
+      }
+    } else {
+      I.setInput(x0,INTEGRATOR_X0);
+      I.setInput(1.0,INTEGRATOR_P);
+      while(state.keepRunning()){
+        I.evaluate();
+      }
+    }
+  }
+  
+  /// Collocation integrator with a Newton solver on CSparse
+  Integrator collocation(){
+    CollocationIntegrator I(vdp());
+    I.setOption("number_of_finite_elements",100);
+    I.setOption("implicit_solver",NewtonImplicitSolver::creator);
+    Dictionary implicit_solver_options;
+    implicit_solver_options["linear_solver"] = CSparse::creator;
+    I.setOption("implicit_solver_options",implicit_solver_options);
+    return I;
+  }
+} // namespace
+
+CASADI_BENCHMARK(integration, rk_vdp){
+  RKIntegrator I(vdp());
+  I.setOption("number_of_finite_elements",1000);
+  integrate(state,I,false);
+}
+
+CASADI_BENCHMARK(integration, rk_vdp_fsens){
+  RKIntegrator I(vdp());
+  I.setOption("number_of_finite_elements",1000);
+  integrate(state,I,true);
+}
+
+CASADI_BENCHMARK(integration, collocation_vdp){
+  integrate(state,collocation(),false);
+}
+
+CASADI_BENCHMARK(integration, dormand_prince_vdp){
+  DormandPrinceIntegrator I(vdp());
+  I.setOption("abstol",1e-8);
+  I.setOption("reltol",1e-8);
+  integrate(state,I,false);
+}
+
+#ifdef WITH_SUNDIALS
+CASADI_BENCHMARK(integration, cvodes_vdp){
+  CVodesIntegrator I(vdp());
+  I.setOption("abstol",1e-8);
+  I.setOption("reltol",1e-8);
+  integrate(state,I,false);
+}
+
+CASADI_BENCHMARK(integration, cvodes_vdp_fsens){
+  CVodesIntegrator I(vdp());
+  I.setOption("abstol",1e-8);
+  I.setOption("reltol",1e-8);
+  integrate(state,I,true);
+}
+#endif // WITH_SUNDIALS
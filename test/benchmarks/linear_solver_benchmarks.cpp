@@ -0,0 +1,124 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include "benchmark.hpp"
+#include <symbolic/casadi.hpp>
+#include <interfaces/csparse/csparse.hpp>
+#ifdef WITH_LAPACK
+#include <interfaces/lapack/lapack_lu_dense.hpp>
+#include <interfaces/lapack/lapack_qr_dense.hpp>
+#include <interfaces/lapack/lapack_cholesky_dense.hpp>
+#include <interfaces/lapack/lapack_ldl_dense.hpp>
+#endif // WITH_LAPACK
+
+using namespace CasADi;
+using namespace std;
+
+namespace{
+  /// Shifted 5-point Laplacian on an m-by-m grid
+  DMatrix laplacian(int m){
+    vector<int> row, col;
+    vector<double> val;
+    for(int i=0; i<m; ++i){
+      for(int j=0; j<m; ++j){
+        int k = i*m+j;
+        row.push_back(k); col.push_back(k); val.push_back(4.1);
+        if(i>0){   row.push_back(k); col.push_back(k-m); val.push_back(-1);}
+        if(i+1<m){ row.push_back(k); col.push_back(k+m); val.push_back(-1);}
+        if(j>0){   row.push_back(k); col.push_back(k-1); val.push_back(-1);}
+        if(j+1<m){ row.push_back(k); col.push_back(k+1); val.push_back(-1);}
+      }
+    }
+    return DMatrix::triplet(row,col,val,m*m,m*m);
+  }
+
+  /// Diagonally dominant dense matrix with pseudo-random entries
+  DMatrix denseMatrix(int n){
+    DMatrix A = DMatrix::zeros(n,n);
+    for(int j=0; j<n; ++j){
+      for(int i=0; i<n; ++i){
+        A(i,j) = i==j ? n : sin(double(i*n+j));
+      }
+    }
+    return A;
+  }
+
+  /// Symmetric, diagonally dominant dense matrix with pseudo-random entries, positive definite
+  DMatrix symmetricDenseMatrix(int n){
+    DMatrix A = DMatrix::zeros(n,n);
+    for(int j=0; j<n; ++j){
+      for(int i=0; i<n; ++i){
+        A(i,j) = i==j ? n : sin(double(i+j));
+      }
+    }
+    return A;
+  }
+
+  /// Factorize and solve with the given solver, the numeric factorization is part of the timing
+  void factorizeAndSolve(Benchmarks::State& state, LinearSolver solver, const DMatrix& A){
+    solver.init();
+    solver.setInput(A,LINSOL_A);
+    solver.setInput(1.0,LINSOL_B);
+    state.setCounter("n",A.size1());
+    state.setCounter("nnz",A.size());
+    while(state.keepRunning()){
+      solver.evaluate();
+    }
+  }
+} // namespace
+
+CASADI_BENCHMARK(linear_solver, csparse_laplacian){
+  DMatrix A = laplacian(50);
+  factorizeAndSolve(state,CSparse(A.sparsity()),A);
+}
+
+CASADI_BENCHMARK(linear_solver, csparse_dense){
+  DMatrix A = denseMatrix(200);
+  factorizeAndSolve(state,CSparse(A.sparsity()),A);
+}
+
+#ifdef WITH_LAPACK
+CASADI_BENCHMARK(linear_solver, lapack_lu_dense){
+  DMatrix A = denseMatrix(200);
+  factorizeAndSolve(state,LapackLUDense(A.sparsity()),A);
+}
+
+CASADI_BENCHMARK(linear_solver, lapack_qr_dense){
+  DMatrix A = denseMatrix(200);
+  factorizeAndSolve(state,LapackQRDense(A.sparsity()),A);
+}
+
+CASADI_BENCHMARK(linear_solver, lapack_lu_dense_symmetric){
+  DMatrix A = symmetricDenseMatrix(200);
+  factorizeAndSolve(state,LapackLUDense(A.sparsity()),A);
+}
+
+CASADI_BENCHMARK(linear_solver, lapack_cholesky_dense){
+  DMatrix A = symmetricDenseMatrix(200);
+  factorizeAndSolve(state,LapackCholeskyDense(A.sparsity()),A);
+}
+
+CASADI_BENCHMARK(linear_solver, lapack_ldl_dense){
+  DMatrix A = symmetricDenseMatrix(200);
+  factorizeAndSolve(state,LapackLDLDense(A.sparsity()),A);
+}
+#endif // WITH_LAPACK
@@ -0,0 +1,133 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+/** \brief Checks the MemoryPool used for temporary work vectors
+ *
+ * Allocations must be aligned, a Scope must release everything allocated during its lifetime,
+ * and repeating the same allocations must not request any more memory from the system. Also
+ * checks the thread-local pool through matrix products, which allocate their work vectors from
+ * it, and the non-pooling mode. The program returns a nonzero exit status if a check fails.
+ */
+
+#include <symbolic/casadi.hpp>
+#include <symbolic/memory_pool.hpp>
+#include <cstdlib>
+#include <iostream>
+
+using namespace CasADi;
+using namespace std;
+
+namespace{
+  int failed = 0;
+
+  void check(bool cond, const string& msg){
+    if(!cond){
+      cerr << "FAILED: " << msg << endl;
+      failed++;
+    }
+  }
+
+  bool aligned(const void* p){
+    return reinterpret_cast<size_t>(p) % MemoryPool::alignment == 0;
+  }
+
+  /// Allocations of different sizes, some of them larger than a block
+  void allocateMany(MemoryPool& pool){
+    for(int k=1; k<200; ++k){
+      void* p = pool.allocate(k*37 % 5000);
+      check(aligned(p),"alignment");
+    }
+    check(aligned(pool.allocate(0)),"alignment of empty allocations");
+    check(aligned(pool.allocate(3000)),"alignment of large allocations");
+  }
+} // namespace
+
+int main(){
+  // Scope release and steady state
+  {
+    MemoryPool pool(1024);
+    void* first;
+    {
+      MemoryPool::Scope scope(pool);
+      first = pool.allocate(10);
+      allocateMany(pool);
+    }
+    size_t capacity = pool.capacity();
+    check(pool.numSystemAllocations()>0,"blocks allocated");
+    check(pool.peakUsage()>0,"peak usage");
+
+    // The memory is reused after the scope has ended
+    for(int rep=0; rep<10; ++rep){
+      pool.resetStatistics();
+      MemoryPool::Scope scope(pool);
+      check(pool.allocate(10)==first,"memory reused after the scope");
+      allocateMany(pool);
+      check(pool.numSystemAllocations()==0,"no system allocations in steady state");
+      check(pool.capacity()==capacity,"capacity unchanged in steady state");
+    }
+
+    // Nested scopes only release their own allocations
+    {
+      MemoryPool::Scope outer(pool);
+      void* a = pool.allocate(100);
+      void* b;
+      {
+        MemoryPool::Scope inner(pool);
+        b = pool.allocate(100);
+      }
+      check(pool.allocate(100)==b,"inner scope released");
+      check(a!=b,"outer allocation kept");
+    }
+  }
+
+  // Non-pooling mode
+  {
+    MemoryPool pool(0);
+    MemoryPool::Scope scope(pool);
+    for(int k=0; k<100; ++k){
+      void* p = pool.allocate(k*13);
+      check(aligned(p),"alignment without pooling");
+      pool.deallocate(p);
+    }
+    check(pool.numSystemAllocations()==0 && pool.capacity()==0,"nothing is kept without pooling");
+  }
+
+  // The thread-local pool, used by sparse matrix products
+  {
+    DMatrix x = DMatrix::ones(Sparsity::banded(50,2));
+    DMatrix y = DMatrix::ones(Sparsity::banded(50,3));
+    DMatrix z = mul(x,y);
+    MemoryPool& pool = MemoryPool::local();
+    pool.resetStatistics();
+    for(int rep=0; rep<10; ++rep){
+      DMatrix z2 = mul(x,y);
+      check(isEqual(z,z2),"matrix product");
+    }
+#if defined(USE_CXX11) || !defined(WITH_OPENMP)
+    check(pool.numAllocations()>0,"the thread-local pool is used");
+#endif
+    check(pool.numSystemAllocations()==0,"no system allocations for repeated matrix products");
+  }
+
+  cout << (failed ? "FAILED" : "ok") << endl;
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,210 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include "benchmark.hpp"
+#include <symbolic/casadi.hpp>
+#include <integration/rk_integrator.hpp>
+#include <optimal_control/direct_multiple_shooting.hpp>
+#include <nonlinear_programming/sqp_method.hpp>
+#include <convex_programming/interior_point_qp_solver.hpp>
+#include <interfaces/csparse/csparse.hpp>
+#ifdef WITH_QPOASES
+#include <interfaces/qpoases/qpoases_solver.hpp>
+#endif // WITH_QPOASES
+#ifdef WITH_IPOPT
+#include <interfaces/ipopt/ipopt_solver.hpp>
+#endif // WITH_IPOPT
+
+using namespace CasADi;
+using namespace std;
+
+namespace{
+  /// Rocket with friction and fuel consumption, single shooting with an RK4 integrator, cf. examples/cplusplus/rocket_single_shooting.cpp
+  MXFunction rocket(int nu){
+    SX s = SX::sym("s"), v = SX::sym("v"), m = SX::sym("m"), u = SX::sym("u");
+    vector<SX> x(3), rhs(3);
+    x[0] = s;  rhs[0] = v;
+    x[1] = v;  rhs[1] = (u-0.05*v*v)/m;
+    x[2] = m;  rhs[2] = -0.1*u*u;
+    SXFunction daefcn(daeIn("x",vertcat(x),"p",u),daeOut("ode",vertcat(rhs)));
+    
+    RKIntegrator integrator(daefcn);
+    integrator.setOption("number_of_finite_elements",10);
+    integrator.setOption("tf",10.0/nu);
+    integrator.init();
+    
+    MX U = MX::sym("U",nu);
+    vector<double> x0(3,0);
+    x0[2] = 1;
+    MX X = x0;
+    for(int k=0; k<nu; ++k){
+      vector<MX> input(INTEGRATOR_NUM_IN);
+      input[INTEGRATOR_X0] = X;
+      input[INTEGRATOR_P] = U[k];
+      X = integrator.call(input).at(INTEGRATOR_XF);
+    }
+    MXFunction nlp(nlpIn("x",U),nlpOut("f",inner_prod(U,U),"g",vertcat(X[0],X[1])));
+    return nlp;
+  }
+  
+  /// Solve the rocket problem repeatedly from the same initial guess
+  void solveRocket(Benchmarks::State& state, NLPSolver solver){
+    solver.init();
+    int nu = solver.input("x0").size();
+    solver.setInput(-10.0,"lbx");
+    solver.setInput(10.0,"ubx");
+    solver.setInput(0.4,"x0");
+    vector<double> g(2,0);
+    g[0] = 10;
+    solver.setInput(g,"lbg");
+    solver.setInput(g,"ubg");
+    state.setCounter("nx",nu);
+    while(state.keepRunning()){
+      solver.evaluate();
+    }
+    state.setCounter("f",solver.output("f").toScalar());
+  }
+
+  /// Van der Pol optimal control with direct multiple shooting, cf. examples/cplusplus/vdp_multiple_shooting.cpp
+  void solveVdp(Benchmarks::State& state, NLPSolverCreator nlp_solver, const Dictionary& nlp_solver_options){
+    SX x = SX::sym("x",3), u = SX::sym("u");
+    vector<SX> f(3);
+    f[0] = (1 - sq(x.at(1)))*x.at(0) - x.at(1) + u;
+    f[1] = x.at(0);
+    f[2] = sq(x.at(0)) + sq(x.at(1)) + sq(u);
+    SXFunction res(daeIn("x",x,"p",u),daeOut("ode",vertcat(f)));
+    SX xf = SX::sym("xf",3);
+    SXFunction mterm(xf,xf.at(2));
+    
+    int ns = 20;
+    Dictionary integrator_options;
+    integrator_options["number_of_finite_elements"] = 10;
+    DirectMultipleShooting ms(res,mterm);
+    ms.setOption("integrator",RKIntegrator::creator);
+    ms.setOption("integrator_options",integrator_options);
+    ms.setOption("number_of_grid_points",ns);
+    ms.setOption("final_time",10.0);
+    ms.setOption("nlp_solver",nlp_solver);
+    ms.setOption("nlp_solver_options",nlp_solver_options);
+    ms.init();
+
+    double inf = numeric_limits<double>::infinity();
+    ms.input("lbu").setAll(-0.75);
+    ms.input("ubu").setAll(1.0);
+    ms.input("u_init").setAll(0.0);
+    ms.input("lbx").setAll(-inf);
+    ms.input("ubx").setAll(inf);
+    ms.input("x_init").setAll(0);
+    ms.input("lbx")(0,0) = ms.input("ubx")(0,0) = 0;
+    ms.input("lbx")(1,0) = ms.input("ubx")(1,0) = 1;
+    ms.input("lbx")(2,0) = ms.input("ubx")(2,0) = 0;
+    ms.input("lbx")(0,ns) = ms.input("ubx")(0,ns) = 0;
+    ms.input("lbx")(1,ns) = ms.input("ubx")(1,ns) = 0;
+    while(state.keepRunning()){
+      ms.evaluate();
+    }
+    state.setCounter("f",ms.output(OCP_COST).toScalar());
+  }
+  
+  /// Options of the SQP method
+  Dictionary sqpOptions(const std::string& hessian_approximation, QPSolverCreator qp_solver, const Dictionary& qp_solver_options){
+    Dictionary opts;
+    opts["qp_solver"] = qp_solver;
+    opts["qp_solver_options"] = qp_solver_options;
+    opts["hessian_approximation"] = hessian_approximation;
+    opts["print_header"] = false;
+    opts["print_time"] = false;
+    return opts;
+  }
+
+#ifdef WITH_QPOASES
+  /// Options of the SQP method with qpOASES as QP solver
+  Dictionary sqpOptions(const std::string& hessian_approximation){
+    Dictionary qp_solver_options;
+    qp_solver_options["printLevel"] = "none";
+    return sqpOptions(hessian_approximation,QPOasesSolver::creator,qp_solver_options);
+  }
+#endif // WITH_QPOASES
+
+  /// Options of the SQP method with the interior point QP solver, optionally warm started from the previous SQP iteration
+  Dictionary sqpInteriorPointOptions(const std::string& hessian_approximation, bool warm_start){
+    Dictionary qp_solver_options;
+    qp_solver_options["linear_solver"] = CSparse::creator;
+    qp_solver_options["warm_start"] = warm_start;
+    return sqpOptions(hessian_approximation,InteriorPointQPSolver::creator,qp_solver_options);
+  }
+
+#ifdef WITH_IPOPT
+  /// Options of IPOPT without output
+  Dictionary ipoptOptions(){
+    Dictionary opts;
+    opts["print_level"] = 0;
+    opts["print_time"] = false;
+    opts["tol"] = 1e-8;
+    return opts;
+  }
+#endif // WITH_IPOPT
+} // namespace
+
+#ifdef WITH_QPOASES
+CASADI_BENCHMARK(nlp, sqp_rocket){
+  SQPMethod solver(rocket(20));
+  solver.setOption(sqpOptions("exact"));
+  solveRocket(state,solver);
+}
+
+CASADI_BENCHMARK(nlp, sqp_vdp_multiple_shooting){
+  solveVdp(state,SQPMethod::creator,sqpOptions("limited-memory"));
+}
+#endif // WITH_QPOASES
+
+CASADI_BENCHMARK(nlp, sqp_ipqp_rocket){
+  SQPMethod solver(rocket(20));
+  solver.setOption(sqpInteriorPointOptions("exact",false));
+  solveRocket(state,solver);
+}
+
+CASADI_BENCHMARK(nlp, sqp_ipqp_warm_rocket){
+  SQPMethod solver(rocket(20));
+  solver.setOption(sqpInteriorPointOptions("exact",true));
+  solveRocket(state,solver);
+}
+
+CASADI_BENCHMARK(nlp, sqp_ipqp_vdp_multiple_shooting){
+  solveVdp(state,SQPMethod::creator,sqpInteriorPointOptions("limited-memory",false));
+}
+
+CASADI_BENCHMARK(nlp, sqp_ipqp_warm_vdp_multiple_shooting){
+  solveVdp(state,SQPMethod::creator,sqpInteriorPointOptions("limited-memory",true));
+}
+
+#ifdef WITH_IPOPT
+CASADI_BENCHMARK(nlp, ipopt_rocket){
+  IpoptSolver solver(rocket(20));
+  solver.setOption(ipoptOptions());
+  solveRocket(state,solver);
+}
+
+CASADI_BENCHMARK(nlp, ipopt_vdp_multiple_shooting){
+  solveVdp(state,IpoptSolver::creator,ipoptOptions());
+}
+#endif // WITH_IPOPT
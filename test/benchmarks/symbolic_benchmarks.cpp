@@ -0,0 +1,200 @@
+/*
+ *    This file is part of CasADi.
+ *
+ *    CasADi -- A symbolic framework for dynamic optimization.
+ *    Copyright (C) 2010 by Joel Andersson, Moritz Diehl, K.U.Leuven. All rights reserved.
+ *
+ *    CasADi is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 3 of the License, or (at your option) any later version.
+ *
+ *    CasADi is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Lesser General Public
+ *    License along with CasADi; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ */
+
+#include "benchmark.hpp"
+#include <symbolic/casadi.hpp>
+#include <sstream>
+
+using namespace CasADi;
+using namespace std;
+
+namespace{
+  /// Extended Rosenbrock function with n variables, a long chain of cheap scalar operations
+  SXFunction rosenbrock(int n){
+    SX x = SX::sym("x",n);
+    SX f = 0;
+    for(int i=0; i+1<n; ++i){
+      f += 100*sq(x.at(i+1)-sq(x.at(i))) + sq(1-x.at(i));
+    }
+    SXFunction F(x,f);
+    F.init();
+    return F;
+  }
+  
+  /// Chain of coupled nonlinear maps x_{k+1} = x_k + h*tanh(A*x_k) with a banded A
+  SXFunction bandedMap(int n, int nk){
+    SX x = SX::sym("x",n);
+    SX xk = x;
+    for(int k=0; k<nk; ++k){
+      vector<SX> r(n);
+      for(int i=0; i<n; ++i){
+        SX s = 2*xk.at(i);
+        if(i>0) s -= xk.at(i-1);
+        if(i+1<n) s -= xk.at(i+1);
+        r[i] = xk.at(i) + 0.1*tanh(s);
+      }
+      xk = vertcat(r);
+    }
+    SXFunction F(x,xk);
+    F.init();
+    return F;
+  }
+
+  /// Sparsity of the 5-point Laplacian on an m-by-m grid
+  Sparsity laplacian(int m){
+    vector<int> row, col;
+    for(int i=0; i<m; ++i){
+      for(int j=0; j<m; ++j){
+        int k = i*m+j;
+        row.push_back(k); col.push_back(k);
+        if(i>0){   row.push_back(k); col.push_back(k-m);}
+        if(i+1<m){ row.push_back(k); col.push_back(k+m);}
+        if(j>0){   row.push_back(k); col.push_back(k-1);}
+        if(j+1<m){ row.push_back(k); col.push_back(k+1);}
+      }
+    }
+    return Sparsity::triplet(m*m,m*m,row,col);
+  }
+} // namespace
+
+CASADI_BENCHMARK(symbolic, sx_evaluate){
+  SXFunction f = rosenbrock(10000);
+  f.setInput(0.5);
+  state.setCounter("nodes",f.getAlgorithmSize());
+  while(state.keepRunning()){
+    f.evaluate();
+  }
+}
+
+CASADI_BENCHMARK(symbolic, sx_evaluate_gradient){
+  SXFunction f = rosenbrock(10000);
+  SXFunction g(f.inputExpr(),f.grad());
+  g.init();
+  g.setInput(0.5);
+  state.setCounter("nodes",g.getAlgorithmSize());
+  while(state.keepRunning()){
+    g.evaluate();
+  }
+}
+
+CASADI_BENCHMARK(symbolic, mx_evaluate){
+  int n = 100;
+  MX x = MX::sym("x",n), A = MX::sym("A",n,n);
+  MX y = x;
+  for(int k=0; k<20; ++k){
+    y = sin(mul(A,y)) + x;
+  }
+  vector<MX> in;
+  in.push_back(x);
+  in.push_back(A);
+  MXFunction f(in,inner_prod(y,y));
+  f.init();
+  f.setInput(0.5,0);
+  f.setInput(1.0/n,1);
+  state.setCounter("nodes",f.countNodes());
+  while(state.keepRunning()){
+    f.evaluate();
+  }
+}
+
+CASADI_BENCHMARK(symbolic, sparsity_propagation_fwd){
+  SXFunction f = bandedMap(2000,10);
+  f.spInit(true);
+  while(state.keepRunning()){
+    f.spEvaluate(true);
+  }
+}
+
+CASADI_BENCHMARK(symbolic, sparsity_propagation_adj){
+  SXFunction f = bandedMap(2000,10);
+  f.spInit(false);
+  while(state.keepRunning()){
+    f.spEvaluate(false);
+  }
+}
+
+CASADI_BENCHMARK(symbolic, jacobian_sparsity){
+  while(state.keepRunning()){
+    SXFunction f = bandedMap(2000,10);
+    f.jacSparsity();
+  }
+}
+
+CASADI_BENCHMARK(symbolic, sx_jacobian_construction){
+  SXFunction f = bandedMap(500,5);
+  while(state.keepRunning()){
+    SX J = f.jac();
+    state.setCounter("nnz",J.size());
+  }
+}
+
+CASADI_BENCHMARK(symbolic, sx_hessian_construction){
+  SXFunction f = rosenbrock(2000);
+  while(state.keepRunning()){
+    SX H = f.hess();
+    state.setCounter("nnz",H.size());
+  }
+}
+
+CASADI_BENCHMARK(symbolic, mx_jacobian_construction){
+  int n = 50;
+  MX x = MX::sym("x",n), A = MX::sym("A",n,n);
+  MX y = x;
+  for(int k=0; k<5; ++k){
+    y = sin(mul(A,y)) + x;
+  }
+  vector<MX> in;
+  in.push_back(x);
+  in.push_back(A);
+  MXFunction f(in,y);
+  f.init();
+  while(state.keepRunning()){
+    MX J = f.jac();
+  }
+}
+
+CASADI_BENCHMARK(symbolic, coloring_unidirectional){
+  Sparsity sp = laplacian(100);
+  while(state.keepRunning()){
+    Sparsity c = sp.unidirectionalColoring();
+    state.setCounter("colors",c.size2());
+  }
+}
+
+CASADI_BENCHMARK(symbolic, coloring_star){
+  Sparsity sp = laplacian(100);
+  while(state.keepRunning()){
+    Sparsity c = sp.starColoring();
+    state.setCounter("colors",c.size2());
+  }
+}
+
+CASADI_BENCHMARK(symbolic, codegen){
+  SXFunction f = rosenbrock(2000);
+  SXFunction g(f.inputExpr(),f.grad());
+  g.init();
+  while(state.keepRunning()){
+    stringstream ss;
+    g.generateCode(ss);
+    state.setCounter("bytes",ss.str().size());
+  }
+}
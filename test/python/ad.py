@@ -396,6 +396,37 @@ class ADtests(casadiTestCase):
               
      
               
+  def test_bidirectional(self):
+    self.message("Jacobian with bidirectional coloring")
+    N = 30
+    x = SX.sym("x",N)
+    # Arrowhead pattern: one dense row, one dense column and a diagonal
+    e = [sumAll(sin(x))] + [x[i]**2*x[0] for i in range(1,N)]
+    x0 = DMatrix([0.1*i+0.3 for i in range(N)])
+    for X, y, Fun in [(x, vertcat(e), SXFunction), (MX.sym("x",N), None, MXFunction)]:
+      if y is None:
+        g = SXFunction([x],[vertcat(e)])
+        g.init()
+        y = g.call([X])[0]
+      J = []
+      for mode in ["forward","automatic"]:
+        f = Fun([X],[y])
+        f.setOption("ad_mode",mode)
+        f.setOption("bidirectional_coloring",True)
+        f.init()
+        Jf = f.jacobian()
+        Jf.init()
+        Jf.setInput(x0)
+        Jf.evaluate()
+        J.append(Jf.getOutput())
+      self.checkarray(J[0],J[1],"bidirectional")
+
+    D1 = Sparsity()
+    D2 = Sparsity()
+    J[0].sparsity().bidirectionalColoring(D1,D2)
+    self.assertEqual(D1.size2(),2)
+    self.assertEqual(D2.size2(),1)
+    
   def test_hessian(self):
     self.message("Jacobian chaining")
     x=SX.sym("x")
@@ -31,6 +31,7 @@ import time
 dplesolvers = []
 try:
   dplesolvers.append((PsdIndefDpleSolver,{"linear_solver": CSparse}))
+  dplesolvers.append((PsdIndefDpleSolver,{"linear_solver": CSparse, "use_blas": True}))
 except:
   pass
   
@@ -41,6 +42,12 @@ except:
   pass
   
   
+try:
+  dplesolvers.append((DoublingDpleSolver,{}))
+except:
+  pass
+  
+  
 print dplesolvers
 
 class ControlTests(casadiTestCase):
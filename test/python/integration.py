@@ -233,6 +233,7 @@ class Integrationtests(casadiTestCase):
               yield {"iterative_solver"+post: "gmres"}
               yield {"iterative_solver"+post: "bcgstab"}
               yield {"iterative_solver"+post: "tfqmr", "use_preconditionerB": True, "linear_solverB" : CSparse} # Bug in Sundials? Preconditioning seems to be needed
+            yield {"iterative_solver"+post: "gmres", "use_preconditioner"+post: True, "pretype"+post: "left"} # Built-in incomplete LU preconditioner
              
             def solveroptions(post=""):
               yield {"linear_solver_type" +post: "dense" }
@@ -343,6 +344,7 @@ class Integrationtests(casadiTestCase):
             yield {"iterative_solver"+post: "gmres"}
             yield {"iterative_solver"+post: "bcgstab"}
             yield {"iterative_solver"+post: "tfqmr", "use_preconditionerB": True, "linear_solverB" : CSparse} # Bug in Sundials? Preconditioning seems to be needed
+            yield {"iterative_solver"+post: "gmres", "use_preconditioner"+post: True, "pretype"+post: "left"} # Built-in incomplete LU preconditioner
            
           def solveroptions(post=""):
             yield {"linear_solver_type" +post: "dense" }
@@ -1249,6 +1251,102 @@ class Integrationtests(casadiTestCase):
 
     integrator.evaluate()
     
+  def test_dormand_prince(self):
+    self.message("DormandPrinceIntegrator: adaptive steps, forward and adjoint sensitivities")
+    num=self.num
+    t=SX.sym("t")
+    q=SX.sym("q")
+    p=SX.sym("p")
+    f=SXFunction(daeIn(t=t, x=q, p=p),daeOut(ode=q/p*t**2))
+    f.init()
+    integrator = DormandPrinceIntegrator(f)
+    integrator.setOption("tf",num['tend'])
+    integrator.setOption("abstol",1e-12)
+    integrator.setOption("reltol",1e-12)
+    integrator.init()
+
+    q0=MX.sym("q0")
+    par=MX.sym("p")
+    qend, = integratorOut(integrator.call(integratorIn(x0=q0,p=par)),"xf")
+    qe=MXFunction([q0,par],[qend])
+    qe.init()
+
+    tend=num['tend']
+    q0=num['q0']
+    p=num['p']
+    qe.setInput([q0],0)
+    qe.setInput([p],1)
+    qe.evaluate()
+    self.assertAlmostEqual(qe.getOutput()[0],q0*exp(tend**3/(3*p)),8,"Evaluation output mismatch")
+    self.assertTrue(integrator.getStat("nsteps")<1000)
+
+    for mode in ["forward","reverse"]:
+      qe.setOption("ad_mode",mode)
+      qe.init()
+      J=qe.jacobian(1)
+      J.init()
+      J.setInput([q0],0)
+      J.setInput([p],1)
+      J.evaluate()
+      self.assertAlmostEqual(J.getOutput()[0],-(q0*tend**3*exp(tend**3/(3*p)))/(3*p**2),7,"Sensitivity mismatch (%s)" % mode)
+      
+  def test_sensitivity_groups(self):
+    self.message("Sensitivity directions split into groups")
+    x=SX.sym("x",2)
+    p=SX.sym("p",5)
+    f=SXFunction(daeIn(x=x,p=p),daeOut(ode=vertcat([p[0]*x[1]+p[1],-p[2]*x[0]*x[1]+p[3]*p[4]]),quad=x[0]**2))
+    f.init()
+    J = {}
+    for group_size in [0,2]:
+      integrator = CVodesIntegrator(f)
+      integrator.setOption("abstol",1e-12)
+      integrator.setOption("reltol",1e-12)
+      integrator.setOption("sensitivity_group_size",group_size)
+      integrator.init()
+      for mode in ["forward","reverse"]:
+        integrator.setOption("ad_mode",mode)
+        integrator.init()
+        for iind, oind in [("x0","xf"),("p","xf"),("p","qf")]:
+          jac = integrator.jacobian(iind,oind)
+          jac.init()
+          jac.setInput([1,0.5],"x0")
+          jac.setInput([0.1,0.2,0.3,0.4,0.5],"p")
+          jac.evaluate()
+          if group_size==0:
+            J[(mode,iind,oind)] = jac.getOutput()
+          else:
+            self.checkarray(jac.getOutput(),J[(mode,iind,oind)],"%s %s %s" % (mode,iind,oind))
+
+  def test_sensitivity_groups_parallel(self):
+    self.message("Sensitivity groups evaluated in parallel")
+    x=SX.sym("x",2)
+    p=SX.sym("p",5)
+    f=SXFunction(daeIn(x=x,p=p),daeOut(ode=vertcat([p[0]*x[1]+p[1],-p[2]*x[0]*x[1]+p[3]*p[4]]),quad=x[0]**2))
+    f.init()
+    J = {}
+    for parallelization in ["serial","openmp"]:
+      integrator = CVodesIntegrator(f)
+      integrator.setOption("abstol",1e-12)
+      integrator.setOption("reltol",1e-12)
+      integrator.setOption("sensitivity_group_size",1)
+      integrator.setOption("sensitivity_parallelization",parallelization)
+      integrator.init()
+      
+      # Several adjoint groups, all of them integrating the same DAE backwards
+      d = integrator.derivative(0,3)
+      d.init()
+      d.setInput([1,0.5],"x0")
+      d.setInput([0.1,0.2,0.3,0.4,0.5],"p")
+      for k in range(3):
+        d.setInput([k+1,0.5],integrator.getNumInputs()+k*integrator.getNumOutputs()+INTEGRATOR_XF)
+        d.setInput(1-k,integrator.getNumInputs()+k*integrator.getNumOutputs()+INTEGRATOR_QF)
+      d.evaluate()
+      for i in range(d.getNumOutputs()):
+        if parallelization=="serial":
+          J[i] = d.getOutput(i)
+        else:
+          self.checkarray(d.getOutput(i),J[i],"output %d" % i)
+
   def test_collocationPoints(self):
     self.message("collocation points")
     with self.assertRaises(Exception):
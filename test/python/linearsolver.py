@@ -451,7 +451,66 @@ class LinearSolverTests(casadiTestCase):
 
     C = S.getFactorization()
     self.checkarray(mul(C,C.T),M)
+
+  @requires("LapackCholeskyDense")
+  def test_lapack_cholesky(self):
+    self.message("Dense Cholesky factorization")
+    numpy.random.seed(0)
+    n = 10
+    L = self.randDMatrix(n,n,sparsity=0.2) +  1.5*c.diag(range(1,n+1))
+    L = L[Sparsity.tril(n)]
+    M = mul(L,L.T)
+    b = self.randDMatrix(n,3)
+    
+    for tr in [False, True]:
+      C = solve(M.T if tr else M,b,LapackCholeskyDense)
+      self.checkarray(mul(M,C),b)
+
+  @requires("LapackLDLDense")
+  def test_lapack_ldl(self):
+    self.message("Dense LDL factorization")
+    # Saddle point matrix, a 2-by-2 pivot is needed
+    A = DMatrix([[0,1,1],[1,2,0],[1,0,3]])
+    b = DMatrix([[1,2,3],[4,5,6]]).T
+    for tr in [False, True]:
+      C = solve(A.T if tr else A,b,LapackLDLDense)
+      self.checkarray(mul(A,C),b)
+    
+    # The results must be the same as with LU
+    C = solve(A,b,LapackLDLDense)
+    self.checkarray(C,solve(A,b,LapackLUDense))
+
+    # An exactly singular matrix is factorized, only the solution fails
+    S = DMatrix([[1,1],[1,1]])
+    solver = LapackLDLDense(S.sparsity())
+    solver.init()
+    solver.setInput(S,"A")
+    solver.prepare()
+    self.assertTrue(solver.prepared())
+    solver.setInput(DMatrix([1,2]),"B")
+    self.assertRaises(Exception,lambda : solver.solve())
+
+  @requires("LapackLDLDense")
+  def test_lapack_ldl_inertia(self):
+    self.message("Inertia with dense LDL factorization")
+    def inertia(A):
+      solver = LapackLDLDense(A.sparsity())
+      solver.init()
+      solver.setInput(A,"A")
+      solver.prepare()
+      return list(solver.getInertia())
     
+    # Zero diagonal: only 2-by-2 pivots are possible
+    self.assertEqual(inertia(DMatrix([[0,1],[1,0]])),[1,1,0])
+    self.assertEqual(inertia(DMatrix([[0,2,0],[2,0,0],[0,0,3]])),[2,1,0])
+    self.assertEqual(inertia(DMatrix([[1,2,0,0],[2,1,0,0],[0,0,-1,3],[0,0,3,-1]])),[2,2,0])
+    self.assertEqual(inertia(DMatrix([[0,1,1],[1,2,0],[1,0,3]])),[2,1,0])
+    
+    # Singular D: exactly zero pivots, also after a 2-by-2 pivot
+    self.assertEqual(inertia(DMatrix([[1,1],[1,1]])),[1,0,1])
+    self.assertEqual(inertia(DMatrix([[0,0],[0,0]])),[0,0,2])
+    self.assertEqual(inertia(DMatrix([[0,1,0],[1,0,0],[0,0,0]])),[1,1,1])
+
   def test_large_sparse(self):
     numpy.random.seed(1)
     n = 10
@@ -497,5 +556,88 @@ class LinearSolverTests(casadiTestCase):
 
         self.checkarray(mul(A_,f.getOutput()),b)
       
+  def test_incomplete_lu(self):
+    self.message("Incomplete LU factorization")
+    n = 8
+    # Exact for a tridiagonal matrix
+    A = DMatrix.zeros(n,n)
+    for i in range(n):
+      A[i,i] = 4+i
+      if i>0: A[i,i-1] = -1-0.1*i
+      if i<n-1: A[i,i+1] = -2+0.3*i
+    A = sparse(A)
+    b = DMatrix(range(1,n+1))
+    for tr in [False, True]:
+      C = solve(A.T if tr else A,b,IncompleteLU)
+      self.checkarray(mul(A.T if tr else A,C),b)
+    
+    # Structurally zero diagonal (saddle point matrix)
+    A = DMatrix([[2,0,1],[0,3,1],[1,1,0]])
+    A = sparse(A)
+    b = DMatrix([1,2,3])
+    C = solve(A,b,IncompleteLU)
+    self.checkarray(mul(A,C),b)
+      
+  def test_sparse_ldl(self):
+    self.message("Sparse LDL factorization")
+    # Symmetric positive definite
+    n = 8
+    A = DMatrix.zeros(n,n)
+    for i in range(n):
+      A[i,i] = 4+i
+      if i>0: A[i,i-1] = A[i-1,i] = -1-0.1*i
+    A[0,n-1] = A[n-1,0] = 0.5
+    A = sparse(A)
+    b = DMatrix(range(1,n+1))
+    for tr in [False, True]:
+      C = solve(A.T if tr else A,b,SparseLDL)
+      self.checkarray(mul(A.T if tr else A,C),b)
+    
+    # Saddle point matrix, without reordering the first pivot is zero, it is perturbed and the solution refined
+    for ordering in ["amd","natural"]:
+      A = DMatrix([[0,1,1],[1,2,0],[1,0,3]])
+      A = sparse(A)
+      b = DMatrix([1,2,3])
+      C = solve(A,b,SparseLDL,{"ordering": ordering})
+      self.checkarray(mul(A,C),b)
+      
+  def test_sparse_ldl_inertia(self):
+    self.message("Inertia with sparse LDL factorization")
+    def inertia(A,ordering="amd"):
+      solver = SparseLDL(A.sparsity())
+      solver.setOption("ordering",ordering)
+      solver.init()
+      solver.setInput(A,"A")
+      solver.prepare()
+      return list(solver.getInertia())
+    
+    # Symmetric positive definite
+    n = 8
+    A = DMatrix.zeros(n,n)
+    for i in range(n):
+      A[i,i] = 4+i
+      if i>0: A[i,i-1] = A[i-1,i] = -1-0.1*i
+    self.assertEqual(inertia(sparse(A)),[n,0,0])
+    
+    # Quasi-definite KKT matrix: positive definite Hessian block, negative definite regularization
+    A = DMatrix([[4,1,1],[1,3,1],[1,1,-1]])
+    for ordering in ["amd","natural"]:
+      self.assertEqual(inertia(A,ordering),[2,1,0])
+    
+    # Saddle point matrix: without reordering, the first pivot is zero, perturbed and counted as a zero eigenvalue
+    A = sparse(DMatrix([[0,1,1],[1,2,0],[1,0,3]]))
+    self.assertEqual(inertia(A,"amd"),[2,1,0])
+    self.assertEqual(inertia(A,"natural"),[1,1,1])
+    
+    # Singular KKT matrix, eigenvalues of different signs and one zero eigenvalue
+    A = DMatrix([[1,1,1],[1,1,1],[1,1,0]])
+    for ordering in ["amd","natural"]:
+      self.assertEqual(inertia(A,ordering),[1,1,1])
+    
+    # Not available before the factorization
+    solver = SparseLDL(A.sparsity())
+    solver.init()
+    self.assertRaises(Exception,lambda : solver.getInertia())
+      
 if __name__ == '__main__':
     unittest.main()
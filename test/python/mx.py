@@ -2728,7 +2728,130 @@ class MXtests(casadiTestCase):
     z = jacobian(x,y)
     
     self.assertTrue(z.size()==0)
-    
+
+  def test_optimize_graph(self):
+    self.message("optimize_graph")
+    x = MX.sym("x",4,3)
+    p = MX.sym("p",2)
+    A = DMatrix.ones(3,3)
+    A[1,2] = 4
+    y = mul(x,mul(MX(A),MX(A))+2*MX(A))
+    v = reshape(y,12,1)[2:10][1:5] + sin(p[1])
+    q = MX(x)
+    q[0,0] = p[0]
+    q[1,1] = p[1]
+    r = MX(q)
+    r[:,:] = y
+    
+    fs = []
+    for opt in [False,True]:
+      f = MXFunction([x,p],[v,r,q[1,1]])
+      f.setOption("optimize_graph",opt)
+      f.init()
+      f.setInput(DMatrix(range(12)).reshape((4,3)),0)
+      f.setInput([0.5,-2],1)
+      fs.append(f)
+      
+    self.checkfunction(fs[0],fs[1])
+    self.assertTrue(fs[1].getStat("graph_nodes_folded")>0)
+    self.assertTrue(fs[1].countNodes()<fs[0].countNodes())
+
+    # The output expressions are left untouched
+    for i, e in enumerate([v,r,q[1,1]]):
+      self.assertTrue(fs[1].outputExpr(i).isEqual(e,0))
       
+    # Nonzero mappings are only fused by optimize_graph, which is off by default
+    f = MXFunction([x,p],[r])
+    f.init()
+    self.assertFalse(f.getOption("optimize_graph"))
+    g = MXFunction([x,p],[r])
+    g.setOption("optimize_graph",True)
+    g.init()
+    self.assertTrue(g.countNodes()<f.countNodes())
+
+  def test_expand_repeated_calls(self):
+    self.message("expand with repeated function calls")
+    x = SX.sym("x",2)
+    f = SXFunction([x],[sin(x)*x[0]])
+    f.init()
+    X = MX.sym("X",4)
+    [y1] = f.call([X[:2]])
+    [y2] = f.call([X[:2]])
+    [y3] = f.call([X[2:]])
+    F = MXFunction([X],[vertcat([y1,y2,y3])])
+    F.init()
+    F.setInput([1.1,2.3,0.7,-0.4])
+    Fx = F.expand()
+    Fx.init()
+    Fx.setInput([1.1,2.3,0.7,-0.4])
+    self.checkfunction(F,Fx)
+    
+    # The expansion of the second call is reused
+    G = MXFunction([X],[vertcat([y1,y3])])
+    G.init()
+    Gx = G.expand()
+    Gx.init()
+    self.assertEqual(Fx.getAlgorithmSize()-Gx.getAlgorithmSize(),2)
+
+
+  def test_dense_mul_kernels(self):
+    self.message("dense multiplication through the runtime kernels")
+    numpy.random.seed(0)
+    A_ = DMatrix(numpy.random.random((9,5)))
+    B_ = DMatrix(numpy.random.random((5,3)))
+    A = MX.sym("A",9,5)
+    B = MX.sym("B",5,3)
+    f = MXFunction([A,B],[mul(A,B),mul(B.T,B),mul(A,A.T)])
+    f.init()
+    f.setInput(A_,0)
+    f.setInput(B_,1)
+    f.evaluate()
+    self.checkarray(f.getOutput(0),DMatrix(numpy.dot(A_.toArray(),B_.toArray())))
+    self.checkarray(f.getOutput(1),DMatrix(numpy.dot(B_.toArray().T,B_.toArray())))
+    self.checkarray(f.getOutput(2),DMatrix(numpy.dot(A_.toArray(),A_.toArray().T)))
+
+    # SX expansion falls back on the sparse kernel and its scatter workspace
+    fx = f.expand()
+    fx.init()
+    fx.setInput(A_,0)
+    fx.setInput(B_,1)
+    self.checkfunction(f,fx)
+
+    C_ = DMatrix(numpy.random.random((3,3)))
+    C = MX.sym("C",3,3)
+    g = MXFunction([C],[mul(C,C)])
+    g.init()
+    g.setInput(C_)
+    gx = g.expand()
+    gx.init()
+    gx.setInput(C_)
+    self.checkfunction(g,gx)
+
+    # Generated code calls the dense kernels
+    code = f.generateCode()
+    self.assertTrue("casadi_gemm_tn(" in code)
+    self.assertTrue("casadi_syrk_tn(" in code)
+
+  @requires("CSparse")
+  def test_solve_codegen(self):
+    self.message("Code generation for linear solves")
+    A = MX.sym("A",3,3)
+    b = MX.sym("b",3)
+    f = MXFunction([A,b],[solve(A,b,CSparse)])
+    f.init()
+
+    # The dense LU factorization is stored in the work vectors, not in static arrays of its own
+    code = f.generateCode()
+    self.assertTrue("casadi_getrf(3,rrr,3,iii);" in code)
+    self.assertFalse("static d lu[" in code)
+
+    # Refused for large systems
+    A = MX.sym("A",Sparsity.diag(200))
+    b = MX.sym("b",200)
+    f = MXFunction([A,b],[solve(A,b,CSparse)])
+    f.init()
+    with self.assertRaises(Exception):
+      f.generateCode()
+
 if __name__ == '__main__':
     unittest.main()
@@ -1496,6 +1496,152 @@ class NLPtests(casadiTestCase):
       self.checkarray(solver.getOutput("f"),DMatrix([0]),digits=7)
       self.checkarray(solver.getOutput("x"),DMatrix([0]),digits=7)
       self.checkarray(solver.getOutput("lam_x"),DMatrix([0]),digits=7)
+
+  @requires("QPOasesSolver")
+  def test_sqp_partitioned_bfgs(self):
+    self.message("chained rosenbrock, partitioned BFGS")
+    N = 5
+    x=SX.sym("x",2*N)
+    f = sum([(1-x[2*i])**2+10*(x[2*i+1]-x[2*i]**2)**2 for i in range(N)])
+    nlp=SXFunction(nlpIn(x=x),nlpOut(f=f,g=x[0]+x[2*N-1]))
+
+    sol = {}
+    for hess in ["limited-memory","partitioned-bfgs"]:
+      solver = SQPMethod(nlp)
+      solver.setOption("qp_solver",QPOasesSolver)
+      solver.setOption("qp_solver_options",{"printLevel": "none"})
+      solver.setOption("hessian_approximation",hess)
+      solver.setOption("max_iter",500)
+      solver.init()
+      solver.setInput(0.5,"x0")
+      solver.setInput(-5,"lbx")
+      solver.setInput(5,"ubx")
+      solver.setInput(1.5,"lbg")
+      solver.setInput(1.5,"ubg")
+      solver.solve()
+      sol[hess] = solver.getOutput("x")
+
+      if hess=="partitioned-bfgs":
+        # Block-diagonal Hessian approximation: N dense 2-by-2 blocks
+        self.assertEqual(solver.getQPSolver().input("h").size(),4*N)
+
+    self.checkarray(sol["partitioned-bfgs"],sol["limited-memory"],digits=5)
+
+  @requires("QPOasesSolver")
+  def test_sqp_warm_start(self):
+    self.message("SQP warm start")
+    x=SX.sym("x",2)
+    p=SX.sym("p")
+    nlp=SXFunction(nlpIn(x=x,p=p),nlpOut(f=(1-x[0])**2+10*(x[1]-x[0]**2)**2,g=x[0]+x[1]-p))
+
+    solver = SQPMethod(nlp)
+    solver.setOption("qp_solver",QPOasesSolver)
+    solver.setOption("qp_solver_options",{"printLevel": "none"})
+    solver.setOption("warm_start",True)
+    solver.init()
+    solver.setInput(-5,"lbx")
+    solver.setInput(5,"ubx")
+    solver.setInput(0,"lbg")
+    solver.setInput(0,"ubg")
+    solver.setInput(1.5,"p")
+    solver.solve()
+    self.assertFalse(solver.getStat("warm_start"))
+    x_opt = solver.getOutput("x")
+
+    # Same problem again: starts from the solution
+    solver.setInput(0,"x0")
+    solver.solve()
+    self.assertTrue(solver.getStat("warm_start"))
+    self.assertEqual(solver.getStat("iter_count"),0)
+    self.checkarray(solver.getOutput("x"),x_opt,digits=8)
+
+    # An unsuccessful solve is not used for warm starting
+    solver.setOption("max_iter",1)
+    solver.init()
+    solver.setInput(-5,"lbx")
+    solver.setInput(5,"ubx")
+    solver.setInput(0,"lbg")
+    solver.setInput(0,"ubg")
+    solver.setInput(1.5,"p")
+    solver.setInput(0,"x0")
+    solver.solve()
+    self.assertEqual(solver.getStat("return_status"),"Maximum_Iterations_Exceeded")
+    solver.solve()
+    self.assertFalse(solver.getStat("warm_start"))
+
+  @requires("IpoptSolver")
+  def test_ipopt_warm_start(self):
+    self.message("IPOPT warm start only after a successful solve")
+    x=SX.sym("x",2)
+    p=SX.sym("p")
+    nlp=SXFunction(nlpIn(x=x,p=p),nlpOut(f=(1-x[0])**2+10*(x[1]-x[0]**2)**2,g=x[0]+x[1]-p))
+
+    solver = IpoptSolver(nlp)
+    solver.setOption("print_level",0)
+    solver.setOption("print_time",False)
+    solver.setOption("warm_start",True)
+    solver.init()
+    solver.setInput(-5,"lbx")
+    solver.setInput(5,"ubx")
+    solver.setInput(0,"lbg")
+    solver.setInput(0,"ubg")
+    solver.setInput(1.5,"p")
+    solver.solve()
+    self.assertFalse(solver.getStat("warm_start"))
+    x_opt = solver.getOutput("x")
+
+    # Same problem again: starts from the solution
+    solver.solve()
+    self.assertTrue(solver.getStat("warm_start"))
+    self.checkarray(solver.getOutput("x"),x_opt,digits=6)
+
+    # A failed solve: infeasible bounds
+    solver.setInput(0,"lbx")
+    solver.setInput(0,"ubx")
+    solver.solve()
+    self.assertTrue(solver.getStat("warm_start"))
+    self.assertFalse(solver.getStat("return_status") in ["Solve_Succeeded","Solved_To_Acceptable_Level"])
+
+    # The next solve is a cold start, also inside IPOPT (warm_start_init_point)
+    solver.setInput(-5,"lbx")
+    solver.setInput(5,"ubx")
+    solver.setInput(0,"x0")
+    solver.setInput(0,"lam_x0")
+    solver.setInput(0,"lam_g0")
+    solver.solve()
+    self.assertFalse(solver.getStat("warm_start"))
+    self.checkarray(solver.getOutput("x"),x_opt,digits=6)
+
+  @requires("QPOasesSolver")
+  def test_sqp_rti(self):
+    self.message("SQP real-time iterations")
+    x=SX.sym("x",2)
+    p=SX.sym("p")
+    nlp=SXFunction(nlpIn(x=x,p=p),nlpOut(f=(x[0]-1)**2+(x[1]-2)**2+x[0]**4,g=x[0]*x[1]-p))
+
+    solver = SQPMethod(nlp)
+    solver.setOption("qp_solver",QPOasesSolver)
+    solver.setOption("qp_solver_options",{"printLevel": "none"})
+    solver.init()
+    solver.setInput(1,"x0")
+    solver.setInput(0,"lbg")
+    solver.setInput(0,"ubg")
+    solver.setInput(1,"p")
+    solver.solve()
+    x_opt = solver.getOutput("x")
+
+    # Repeated real-time iterations, starting from the initial guess, converge to the same solution
+    solver.init()
+    solver.setInput(1,"x0")
+    solver.setInput(0,"lbg")
+    solver.setInput(0,"ubg")
+    for i in range(20):
+      solver.prepare()
+      solver.setInput(1,"p")
+      solver.feedback()
+    self.checkarray(solver.getOutput("x"),x_opt,digits=6)
+    self.assertTrue(solver.getStat("t_feedback")>=0)
+    self.assertTrue(solver.getStat("t_prepare")>=0)
       
 if __name__ == '__main__':
     unittest.main()
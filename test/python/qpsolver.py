@@ -771,6 +771,107 @@ class QPSolverTests(casadiTestCase):
       self.checkarray(solver.getOutput("lam_a"),DMatrix([2,0,0]),str(qpsolver),digits=5)
       
       self.assertAlmostEqual(solver.getOutput("cost")[0],7,5,str(qpsolver))
-      
+
+  @requires("QPOasesSolver")
+  def test_condensing(self):
+    self.message("condensing of a multiple shooting structured QP")
+    N = 5
+    nx = 2
+    nu = 1
+    ns = nx+nu
+    n = N*ns+nx
+    
+    # Stage-wise Hessian
+    H = DMatrix.zeros(n,n)
+    for k in range(N+1):
+      H[k*ns:k*ns+nx,k*ns:k*ns+nx] = DMatrix([[2,0.5],[0.5,1]])
+      if k<N:
+        H[k*ns+nx,k*ns+nx] = 0.1
+    H = sparse(H)
+    G = DMatrix([0.1*i for i in range(n)])
+    
+    # Dynamics x_{k+1} = [1 0.1;0 1]*x_k + [0;0.1]*u_k + [0;0.01] and a bound on x_k[0] + u_k
+    A = DMatrix.zeros(3*N,n)
+    LBA = DMatrix.zeros(3*N)
+    UBA = DMatrix.zeros(3*N)
+    for k in range(N):
+      A[3*k:3*k+2,k*ns:k*ns+nx] = DMatrix([[1,0.1],[0,1]])
+      A[3*k+1,k*ns+nx] = 0.1
+      A[3*k:3*k+2,(k+1)*ns:(k+1)*ns+nx] = -DMatrix.eye(2)
+      LBA[3*k+1] = UBA[3*k+1] = -0.01
+      A[3*k+2,k*ns] = 1
+      A[3*k+2,k*ns+nx] = 1
+      LBA[3*k+2] = -inf
+      UBA[3*k+2] = 0.5
+    A = sparse(A)
+    LBX = DMatrix([-inf]*n)
+    UBX = DMatrix([inf]*n)
+    LBX[0:nx] = UBX[0:nx] = DMatrix([1,-1])
+    for k in range(1,N+1):
+      LBX[k*ns+1] = -1.2
+    
+    sol = []
+    for condensing in [False,True]:
+      if condensing:
+        solver = CondensingQPSolver(qpStruct(h=H.sparsity(),a=A.sparsity()))
+        solver.setOption("nx",nx)
+        solver.setOption("nu",nu)
+        solver.setOption("qp_solver",QPOasesSolver)
+        solver.setOption("qp_solver_options",{"printLevel": "none"})
+      else:
+        solver = QPOasesSolver(qpStruct(h=H.sparsity(),a=A.sparsity()))
+        solver.setOption("printLevel","none")
+      solver.init()
+      solver.setInput(H,"h")
+      solver.setInput(G,"g")
+      solver.setInput(A,"a")
+      solver.setInput(LBX,"lbx")
+      solver.setInput(UBX,"ubx")
+      solver.setInput(LBA,"lba")
+      solver.setInput(UBA,"uba")
+      solver.solve()
+      sol.append([solver.getOutput(i) for i in ["x","cost","lam_a","lam_x"]])
+      
+    for i in range(4):
+      self.checkarray(sol[1][i],sol[0][i],digits=8)
+      
+  @requires("QPOasesSolver")
+  def test_interior_point(self):
+    self.message("interior point QP solver against qpOASES")
+    H = DMatrix([[2,0.5,0,0],[0.5,1,0.2,0],[0,0.2,3,-1],[0,0,-1,2]])
+    G = DMatrix([-2,1,-3,0.5])
+    A = DMatrix([[1,1,0,0],[0,1,-1,1],[1,0,1,1],[0,0,2,-1]])
+    LBX = DMatrix([-1,-inf,0.3,-2])
+    UBX = DMatrix([1,0.5,0.3,inf])
+    LBA = DMatrix([-inf,0.2,-1,-5])
+    UBA = DMatrix([0.8,0.2,inf,5])
+
+    for warm_start in [False,True]:
+      sol = []
+      for interior_point in [False,True]:
+        if interior_point:
+          solver = InteriorPointQPSolver(qpStruct(h=H.sparsity(),a=A.sparsity()))
+          solver.setOption("linear_solver",CSparse)
+          solver.setOption("warm_start",warm_start)
+        else:
+          solver = QPOasesSolver(qpStruct(h=H.sparsity(),a=A.sparsity()))
+          solver.setOption("printLevel","none")
+        solver.init()
+        solver.setInput(H,"h")
+        solver.setInput(A,"a")
+        solver.setInput(LBX,"lbx")
+        solver.setInput(UBX,"ubx")
+        solver.setInput(LBA,"lba")
+        solver.setInput(UBA,"uba")
+        
+        # Solve twice, the second time with a perturbed gradient
+        for G_k in [G,G+0.01]:
+          solver.setInput(G_k,"g")
+          solver.solve()
+        sol.append([solver.getOutput(i) for i in ["x","cost","lam_a","lam_x"]])
+        
+      for i in range(4):
+        self.checkarray(sol[1][i],sol[0][i],"warm_start=%s" % str(warm_start),digits=6)
+
 if __name__ == '__main__':
     unittest.main()
@@ -514,6 +514,31 @@ class Simulatortests(casadiTestCase):
     p=num['p']
 
     self.assertAlmostEqual(sim.getOutput()[0,-1],q0*exp((tend**3-0.7**3)/(3*p)),9,"Evaluation output mismatch")
+
+  def test_simulator_dense_output(self):
+    self.message("Simulator: dense output of fixed step integrators")
+    num=self.num
+    t = n.linspace(0,num['tend'],101)
+    for Integrator, options in [(RKIntegrator,{}),(CollocationIntegrator,{"implicit_solver":KinsolSolver})]:
+      integrator = Integrator(self.f)
+      integrator.setOption("number_of_finite_elements",20)
+      integrator.setOption("tf",num['tend'])
+      integrator.setOption(options)
+      sim = Simulator(integrator,t)
+      sim.init()
+      self.assertFalse(integrator.hasSetOption("dense_output"))
+      sim.setOption("dense_output",True)
+      sim.init()
+      self.assertTrue(integrator.getOption("dense_output"))
+      sim.setInput([num['q0']],0)
+      sim.setInput([num['p']],1)
+      sim.evaluate()
+      self.checkarray(sim.getOutput().T,num['q0']*exp(DMatrix(t)**3/(3*num['p'])),"Evaluation output mismatch",digits=3)
+      
+      # Interpolation within the last step
+      integrator.reset()
+      integrator.integrate(1.03)
+      self.assertAlmostEqual(integrator.interpolate(1.01)[0],num['q0']*exp(1.01**3/(3*num['p'])),3,"Interpolation mismatch")
             
 if __name__ == '__main__':
     unittest.main()
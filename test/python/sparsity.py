@@ -520,6 +520,22 @@ class Sparsitytests(casadiTestCase):
     
     self.assertTrue(J.getOutput()[:X.size(),:].sparsity()==Sparsity.diag(100))
     
+  def test_coloring_orderings(self):
+    self.message("unidirectional coloring with orderings and speculative parallel coloring")
+    n = 50
+    rows = [i for i in range(n)] + [(7*i+3)%n for i in range(n)] + [0]*n
+    cols = [i for i in range(n)]*3
+    A = Sparsity.triplet(n,n,rows,cols)
+    for ordering in range(4):
+      for D in [A.unidirectionalColoring(Sparsity(),n,ordering), A.unidirectionalColoringParallel(Sparsity(),2,ordering)]:
+        # Every column colored exactly once, no two columns of the same color share a row
+        self.checkarray(mul(DMatrix(D,1),DMatrix.ones(D.size2(),1)),DMatrix.ones(n,1))
+        self.assertTrue(max(DMatrix(mul(DMatrix(A,1),DMatrix(D,1))).data())<=1)
+    H = A + A.T
+    for ordering in range(4):
+      D = H.starColoring(ordering)
+      self.checkarray(mul(DMatrix(D,1),DMatrix.ones(D.size2(),1)),DMatrix.ones(n,1))
+    
   def test_rowcol(self):
     n = 3
     
@@ -547,6 +563,16 @@ class Sparsitytests(casadiTestCase):
       
       self.checkarray(trial,dt)
       
+  def test_patternMultiply(self):
+    self.message("Gustavson sparsity pattern product")
+    numpy.random.seed(1)
+    for (n,k,m,dens) in [(10,7,12,0.2),(20,20,20,0.05),(5,30,4,0.8)]:
+      x = self.randDMatrix(n,k,dens)
+      y = self.randDMatrix(k,m,dens)
+      sp = x.sparsity().patternMultiply(y.sparsity())
+      self.assertTrue(sp==y.sparsity().patternProduct(x.sparsity().T))
+      self.checkarray(x.mul_full(y),DMatrix(numpy.dot(x.toArray(),y.toArray())))
+
   def test_internalapi(self):
     s = Sparsity.dense(2,2)
     with warnings.catch_warnings():
@@ -1337,6 +1337,61 @@ class SXtests(casadiTestCase):
         isSmooth(x)
       warnings.simplefilter("ignore")
       isSmooth(x)
+
+  def test_save_load(self):
+    self.message("SXFunction binary save/load")
+    x = SX.sym("x",3)
+    y = SX.sym("y",2)
+    f = SXFunction([x,y],[sin(x)*y[0]+y[1],mul(x.T,x)])
+    f.init()
+    J = f.jacobian(0,0)
+    J.init()
+    
+    import tempfile, os
+    fname = os.path.join(tempfile.mkdtemp(),"f.casadi")
+    f.save(fname)
+    g = SXFunction.load(fname)
+    
+    self.assertEqual(g.getAlgorithmSize(),f.getAlgorithmSize())
+    self.assertEqual(g.getWorkSize(),f.getWorkSize())
+    for h in [f,g]:
+      h.setInput([1.1,2.2,3.3],0)
+      h.setInput([0.5,-0.7],1)
+      h.evaluate()
+    for i in range(2):
+      self.checkarray(g.getOutput(i),f.getOutput(i),"SXFunction save/load")
+    
+    # The cached Jacobian is restored together with the function
+    G = g.jacobian(0,0)
+    for h in [J,G]:
+      h.setInput([1.1,2.2,3.3],0)
+      h.setInput([0.5,-0.7],1)
+      h.evaluate()
+    self.checkarray(G.getOutput(0),J.getOutput(0),"SXFunction save/load jacobian")
+    
+    # Statistics are also available when the loaded function is initialized again
+    g.setOption("simulate_cache",True)
+    g.init()
+    self.assertEqual(g.getStat("work_size"),f.getStat("work_size"))
+    self.assertTrue(g.getStat("work_cache_misses")>0)
+    
+  def test_topological_sorting(self):
+    self.message("SXFunction topological sorting")
+    x = SX.sym("x",4)
+    # Unbalanced tree: the right subtree needs more work vector elements than the left one
+    e = (x[0]*x[1]) * ((x[0]+x[1])*(x[2]-x[3]) + (x[2]*x[3])*(x[0]-x[2]))
+    res = []
+    for sorting in ["depth-first","breadth-first","sethi-ullman"]:
+      f = SXFunction([x],[e])
+      f.setOption("topological_sorting",sorting)
+      f.setOption("simulate_cache",True)
+      f.init()
+      f.setInput([1.1,2.2,3.3,4.4])
+      f.evaluate()
+      res.append((f.getOutput(),f.getStat("work_size")))
+      self.assertTrue(f.getStat("work_cache_misses")>0)
+    self.checkarray(res[0][0],res[2][0],"sethi-ullman")
+    self.assertTrue(res[2][1]<=res[0][1])
     
 if __name__ == '__main__':
     unittest.main()